@@ -13,6 +13,8 @@ set(DEBUGGING_SOURCES
     "${DEBUGGING_ROOT_DIR}/DebugDrawings.cpp"
     "${DEBUGGING_ROOT_DIR}/DebugDrawings.h"
     "${DEBUGGING_ROOT_DIR}/DebugDrawings3D.h"
+    "${DEBUGGING_ROOT_DIR}/DebugImageCodec.cpp"
+    "${DEBUGGING_ROOT_DIR}/DebugImageCodec.h"
     "${DEBUGGING_ROOT_DIR}/Debugging.h"
     "${DEBUGGING_ROOT_DIR}/DebugImages.h"
     "${DEBUGGING_ROOT_DIR}/DebugRequest.cpp"
@@ -30,6 +30,10 @@ set(FRAMEWORK_SOURCES
     "${FRAMEWORK_ROOT_DIR}/Robot.h"
     "${FRAMEWORK_ROOT_DIR}/Settings.cpp"
     "${FRAMEWORK_ROOT_DIR}/Settings.h"
+    "${FRAMEWORK_ROOT_DIR}/StartupTrace.cpp"
+    "${FRAMEWORK_ROOT_DIR}/StartupTrace.h"
+    "${FRAMEWORK_ROOT_DIR}/TaskPool.cpp"
+    "${FRAMEWORK_ROOT_DIR}/TaskPool.h"
     "${FRAMEWORK_ROOT_DIR}/ThreadFrame.cpp"
     "${FRAMEWORK_ROOT_DIR}/ThreadFrame.h")
 
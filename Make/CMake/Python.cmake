@@ -10,6 +10,8 @@ if(Python3_FOUND)
   set(PYTHON_OUTPUT_DIR "${OUTPUT_PREFIX}/Build/${PLATFORM}/Python/$<CONFIG>")
 
   set(PYTHON_LOGS_SOURCES
+      "${PYTHON_ROOT_DIR}/Logs/Columns.cpp"
+      "${PYTHON_ROOT_DIR}/Logs/Columns.h"
       "${PYTHON_ROOT_DIR}/Logs/Frame.cpp"
       "${PYTHON_ROOT_DIR}/Logs/Frame.h"
       "${PYTHON_ROOT_DIR}/Logs/Module.cpp"
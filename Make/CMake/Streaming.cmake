@@ -6,6 +6,8 @@ set(STREAMING_SOURCES
     "${STREAMING_ROOT_DIR}/AutoStreamable.h"
     "${STREAMING_ROOT_DIR}/Enum.h"
     "${STREAMING_ROOT_DIR}/EnumIndexedArray.h"
+    "${STREAMING_ROOT_DIR}/FieldPlan.cpp"
+    "${STREAMING_ROOT_DIR}/FieldPlan.h"
     "${STREAMING_ROOT_DIR}/Function.h"
     "${STREAMING_ROOT_DIR}/FunctionList.cpp"
     "${STREAMING_ROOT_DIR}/FunctionList.h"
@@ -30,6 +32,8 @@ set(STREAMING_SOURCES
     "${STREAMING_ROOT_DIR}/Streamable.h"
     "${STREAMING_ROOT_DIR}/TypeInfo.cpp"
     "${STREAMING_ROOT_DIR}/TypeInfo.h"
+    "${STREAMING_ROOT_DIR}/TypeMigration.cpp"
+    "${STREAMING_ROOT_DIR}/TypeMigration.h"
     "${STREAMING_ROOT_DIR}/TypeRegistry.cpp"
     "${STREAMING_ROOT_DIR}/TypeRegistry.h")
 
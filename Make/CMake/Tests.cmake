@@ -20,6 +20,16 @@ set_property(TARGET Tests PROPERTY XCODE_ATTRIBUTE_LD_RUNPATH_SEARCH_PATHS "@loa
 
 target_include_directories(Tests PRIVATE "${TESTS_ROOT_DIR}")
 
+# SimulatedNao is a module library, so the log tools tested are compiled into the tests.
+set(TESTS_SIMULATEDNAO_SOURCES
+    "${BHUMAN_PREFIX}/Src/Libs/SimulatedNao/ImageExport.h"
+    "${BHUMAN_PREFIX}/Src/Libs/SimulatedNao/LogExtractor.cpp"
+    "${BHUMAN_PREFIX}/Src/Libs/SimulatedNao/LogExtractor.h"
+    "${BHUMAN_PREFIX}/Src/Libs/SimulatedNao/LogPlayer.cpp"
+    "${BHUMAN_PREFIX}/Src/Libs/SimulatedNao/LogPlayer.h")
+target_sources(Tests PRIVATE ${TESTS_SIMULATEDNAO_SOURCES})
+source_group(SimulatedNao FILES ${TESTS_SIMULATEDNAO_SOURCES})
+
 if(MACOS)
   target_link_libraries(Tests PRIVATE ${APP_KIT_FRAMEWORK})
 endif()
@@ -29,6 +39,8 @@ target_link_libraries(Tests PRIVATE Framework)
 target_link_libraries(Tests PRIVATE Math)
 target_link_libraries(Tests PRIVATE Platform)
 target_link_libraries(Tests PRIVATE Streaming)
+target_link_libraries(Tests PRIVATE Qt6::Core Qt6::Gui)
+target_link_libraries(Tests PRIVATE snappy::snappy)
 target_link_libraries(Tests PRIVATE GTest::GTest)
 
 target_compile_definitions(Tests PRIVATE GTEST_DONT_DEFINE_FAIL GTEST_DONT_DEFINE_TEST GTEST_HAS_TR1_TUPLE=0)
@@ -224,5 +224,6 @@ setup(
     description='Python bindings for B-Human.',
     ext_modules=[CMakeExtension('pybh.')],  # . to create a folder for the libs
     cmdclass={'build_ext': CMakeBuild},
+    install_requires=['numpy'],
     zip_safe=False,
 )
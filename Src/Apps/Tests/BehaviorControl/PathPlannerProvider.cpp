@@ -0,0 +1,30 @@
+#include "Modules/BehaviorControl/PathPlannerProvider/PathPlannerProvider.h"
+
+#include <gtest/gtest.h>
+
+GTEST_TEST(PathPlannerProvider, ReusesPathBeforeTangentPoint)
+{
+  const Vector2f start(0.f, 0.f);
+  const Vector2f tangentPoint(300.f, 100.f);
+  EXPECT_FALSE(PathPlannerProvider::hasPassedTangentPoint(start, tangentPoint, start));
+  EXPECT_FALSE(PathPlannerProvider::hasPassedTangentPoint(start, tangentPoint, Vector2f(150.f, 50.f)));
+  EXPECT_FALSE(PathPlannerProvider::hasPassedTangentPoint(start, tangentPoint, Vector2f(-100.f, 150.f)));
+}
+
+GTEST_TEST(PathPlannerProvider, ReplansAfterTangentPoint)
+{
+  // The robot passed an obstacle close to it, but is still within the default
+  // replanStartTolerance (200 mm) of where the last search started.
+  const Vector2f start(0.f, 0.f);
+  const Vector2f tangentPoint(100.f, 50.f);
+  const Vector2f position(170.f, 60.f);
+  ASSERT_LT(position.norm(), 200.f);
+  EXPECT_TRUE(PathPlannerProvider::hasPassedTangentPoint(start, tangentPoint, position));
+}
+
+GTEST_TEST(PathPlannerProvider, StartOnFirstNode)
+{
+  // Without a direction to the tangent point, only the other criteria decide.
+  const Vector2f start(100.f, 50.f);
+  EXPECT_FALSE(PathPlannerProvider::hasPassedTangentPoint(start, start, Vector2f(250.f, 50.f)));
+}
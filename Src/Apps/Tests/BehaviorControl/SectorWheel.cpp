@@ -0,0 +1,131 @@
+#include "Tools/BehaviorControl/FlatSectorWheel.h"
+#include "Tools/BehaviorControl/SectorWheel.h"
+#include "MathBase/Random.h"
+
+#include <gtest/gtest.h>
+#include <chrono>
+#include <iostream>
+
+namespace
+{
+  std::vector<FlatSectorWheel::Obstacle> randomObstacles(int count)
+  {
+    std::vector<FlatSectorWheel::Obstacle> obstacles;
+    for(int i = 0; i < count; ++i)
+      obstacles.push_back({Vector2f(Random::uniform(-4500.f, 4500.f), Random::uniform(-3000.f, 3000.f)),
+                           Random::uniform(200.f, 800.f),
+                           Random::bernoulli() ? SectorWheel::Sector::obstacle : SectorWheel::Sector::teammate});
+    return obstacles;
+  }
+
+  std::vector<Vector2f> randomObservers(int count)
+  {
+    std::vector<Vector2f> observers;
+    for(int i = 0; i < count; ++i)
+      observers.emplace_back(Random::uniform(-4500.f, 4500.f), Random::uniform(-3000.f, 3000.f));
+    return observers;
+  }
+}
+
+GTEST_TEST(FlatSectorWheel, EqualsSectorWheel)
+{
+  for(int run = 0; run < 200; ++run)
+  {
+    const std::vector<FlatSectorWheel::Obstacle> obstacles = randomObstacles(Random::uniformInt(0, 40));
+    const Vector2f observer = randomObservers(1).front();
+
+    SectorWheel listWheel;
+    FlatSectorWheel flatWheel;
+    listWheel.begin(observer);
+    flatWheel.begin(observer);
+    listWheel.addSector(Rangea(-0.3f, 0.4f), std::numeric_limits<float>::max(), SectorWheel::Sector::goal);
+    flatWheel.addSector(Rangea(-0.3f, 0.4f), std::numeric_limits<float>::max(), SectorWheel::Sector::goal);
+    for(const FlatSectorWheel::Obstacle& obstacle : obstacles)
+    {
+      listWheel.addSector(obstacle.center, obstacle.width, obstacle.type);
+      flatWheel.addSector(obstacle.center, obstacle.width, obstacle.type);
+    }
+
+    const std::list<SectorWheel::Sector>& listSectors = listWheel.finish();
+    const FlatSectorWheel::Sectors flatSectors = flatWheel.finish();
+    ASSERT_EQ(listSectors.size(), flatSectors.size());
+    auto flatSector = flatSectors.begin();
+    for(const SectorWheel::Sector& listSector : listSectors)
+    {
+      EXPECT_EQ(listSector.angleRange.min, flatSector->angleRange.min);
+      EXPECT_EQ(listSector.angleRange.max, flatSector->angleRange.max);
+      EXPECT_EQ(listSector.distance, flatSector->distance);
+      EXPECT_EQ(listSector.type, flatSector->type);
+      ++flatSector;
+    }
+  }
+}
+
+GTEST_TEST(FlatSectorWheel, ManyObserversSumUpLikeList)
+{
+  const std::vector<FlatSectorWheel::Obstacle> obstacles = randomObstacles(10);
+  const std::vector<Vector2f> observers = randomObservers(5000);
+  float listSum = 0.f;
+  float flatSum = 0.f;
+
+  for(const Vector2f& observer : observers)
+  {
+    SectorWheel wheel;
+    wheel.begin(observer);
+    for(const FlatSectorWheel::Obstacle& obstacle : obstacles)
+      wheel.addSector(obstacle.center, obstacle.width, obstacle.type);
+    for(const SectorWheel::Sector& sector : wheel.finish())
+      if(sector.type == SectorWheel::Sector::free)
+        listSum += sector.angleRange.getSize();
+  }
+  FlatSectorWheel wheel;
+  wheel.evaluate(observers, obstacles, [&](std::size_t, const FlatSectorWheel::Sectors& sectors)
+  {
+    for(const SectorWheel::Sector& sector : sectors)
+      if(sector.type == SectorWheel::Sector::free)
+        flatSum += sector.angleRange.getSize();
+  });
+
+  EXPECT_FLOAT_EQ(listSum, flatSum);
+}
+
+/**
+ * Measures the time per wheel of the list-based and the flat implementation
+ * for the case of ExpectedGoalsProvider, i.e. many observers and the same
+ * obstacles. Run with --gtest_also_run_disabled_tests.
+ */
+GTEST_TEST(FlatSectorWheel, DISABLED_TimePerWheel)
+{
+  const std::vector<FlatSectorWheel::Obstacle> obstacles = randomObstacles(10);
+  const std::vector<Vector2f> observers = randomObservers(50000);
+  float listSum = 0.f;
+  float flatSum = 0.f;
+
+  const auto listStart = std::chrono::steady_clock::now();
+  for(const Vector2f& observer : observers)
+  {
+    SectorWheel wheel;
+    wheel.begin(observer);
+    for(const FlatSectorWheel::Obstacle& obstacle : obstacles)
+      wheel.addSector(obstacle.center, obstacle.width, obstacle.type);
+    for(const SectorWheel::Sector& sector : wheel.finish())
+      if(sector.type == SectorWheel::Sector::free)
+        listSum += sector.angleRange.getSize();
+  }
+  const auto flatStart = std::chrono::steady_clock::now();
+  FlatSectorWheel wheel;
+  wheel.evaluate(observers, obstacles, [&](std::size_t, const FlatSectorWheel::Sectors& sectors)
+  {
+    for(const SectorWheel::Sector& sector : sectors)
+      if(sector.type == SectorWheel::Sector::free)
+        flatSum += sector.angleRange.getSize();
+  });
+  const auto flatEnd = std::chrono::steady_clock::now();
+
+  EXPECT_FLOAT_EQ(listSum, flatSum);
+  const double listTime = std::chrono::duration<double, std::micro>(flatStart - listStart).count() / observers.size();
+  const double flatTime = std::chrono::duration<double, std::micro>(flatEnd - flatStart).count() / observers.size();
+  RecordProperty("sectorWheelMicroseconds", std::to_string(listTime));
+  RecordProperty("flatSectorWheelMicroseconds", std::to_string(flatTime));
+  std::cout << "SectorWheel: " << listTime << " us, FlatSectorWheel: " << flatTime << " us per wheel" << std::endl;
+}
@@ -0,0 +1,157 @@
+#include "Debugging/DebugImageCodec.h"
+
+#include <gtest/gtest.h>
+#include <cstring>
+
+static void fill(Image<PixelTypes::GrayscaledPixel>& image, int frame)
+{
+  for(unsigned y = 0; y < image.height; ++y)
+    for(unsigned x = 0; x < image.width; ++x)
+      image[y][x] = static_cast<PixelTypes::GrayscaledPixel>(x < 20 && y < 10 ? x * y + frame : 0);
+}
+
+static bool equal(const DebugImage& a, const DebugImage& b)
+{
+  return a.type == b.type && a.width == b.width && a.height == b.height
+         && !std::memcmp(a.data, b.data, a.width * a.height * PixelTypes::pixelSize(a.type));
+}
+
+GTEST_TEST(DebugImageCodec, LosslessAtFullRate)
+{
+  DebugImageEncoder::setLinkState(0.f, 0.f);
+  DebugImageEncoder encoder;
+  DebugImageDecoder decoder;
+  Image<PixelTypes::GrayscaledPixel> image(63, 37);
+  CompressedDebugImage compressed;
+  DebugImage decoded;
+  for(int frame = 0; frame < 40; ++frame)
+  {
+    fill(image, frame);
+    const DebugImage original(image);
+    encoder.encode("test", original, compressed);
+    EXPECT_EQ(frame % DebugImageEncoder::keyFrameInterval == 0, compressed.keyFrame);
+    EXPECT_LT(compressed.data.size(), image.width * image.height / 4u);
+    ASSERT_TRUE(decoder.decode("test", compressed, decoded));
+    EXPECT_TRUE(equal(original, decoded));
+  }
+}
+
+GTEST_TEST(DebugImageCodec, DownscalesWithBacklog)
+{
+  DebugImageEncoder::setLinkState(0.f, 0.2f);
+  DebugImageEncoder encoder;
+  DebugImageDecoder decoder;
+  Image<PixelTypes::GrayscaledPixel> image(16, 8);
+  for(unsigned y = 0; y < image.height; ++y)
+    for(unsigned x = 0; x < image.width; ++x)
+      image[y][x] = static_cast<PixelTypes::GrayscaledPixel>(x + y * 16);
+  CompressedDebugImage compressed;
+  DebugImage decoded;
+  encoder.encode("test", DebugImage(image), compressed);
+  EXPECT_EQ(2, compressed.scale);
+  ASSERT_TRUE(decoder.decode("test", compressed, decoded));
+  ASSERT_EQ(16, decoded.width);
+  ASSERT_EQ(8, decoded.height);
+  const auto view = decoded.getView<PixelTypes::GrayscaledPixel>();
+  for(unsigned y = 0; y < image.height; ++y)
+    for(unsigned x = 0; x < image.width; ++x)
+      EXPECT_EQ(image[y & ~1u][x & ~1u], view[y][x]);
+  DebugImageEncoder::setLinkState(0.f, 0.f);
+}
+
+GTEST_TEST(DebugImageCodec, WaitsForKeyFrameAfterLoss)
+{
+  DebugImageEncoder::setLinkState(0.f, 0.f);
+  DebugImageEncoder encoder;
+  DebugImageDecoder decoder;
+  Image<PixelTypes::GrayscaledPixel> image(32, 16);
+  CompressedDebugImage compressed;
+  DebugImage decoded;
+
+  fill(image, 0);
+  encoder.encode("test", DebugImage(image), compressed);
+  ASSERT_TRUE(decoder.decode("test", compressed, decoded));
+
+  // The second image is lost.
+  fill(image, 1);
+  encoder.encode("test", DebugImage(image), compressed);
+
+  for(unsigned frame = 2; frame < DebugImageEncoder::keyFrameInterval; ++frame)
+  {
+    fill(image, static_cast<int>(frame));
+    encoder.encode("test", DebugImage(image), compressed);
+    EXPECT_FALSE(decoder.decode("test", compressed, decoded));
+  }
+
+  fill(image, 0);
+  const DebugImage original(image);
+  encoder.encode("test", original, compressed);
+  EXPECT_TRUE(compressed.keyFrame);
+  ASSERT_TRUE(decoder.decode("test", compressed, decoded));
+  EXPECT_TRUE(equal(original, decoded));
+}
+
+GTEST_TEST(DebugImageCodec, ResyncsWhenKeyFrameRequested)
+{
+  DebugImageEncoder::setLinkState(0.f, 0.f);
+  DebugImageEncoder encoder;
+  DebugImageDecoder decoder;
+  Image<PixelTypes::GrayscaledPixel> image(32, 16);
+  CompressedDebugImage compressed;
+  DebugImage decoded;
+
+  fill(image, 0);
+  encoder.encode("resync", DebugImage(image), compressed);
+  ASSERT_TRUE(decoder.decode("resync", compressed, decoded));
+
+  // The second image is dropped from the outgoing queue, which requests a key frame.
+  fill(image, 1);
+  encoder.encode("resync", DebugImage(image), compressed);
+  DebugImageEncoder::requestKeyFrame("resync");
+
+  // The key frame follows as soon as the previous one is old enough.
+  unsigned frame = 2;
+  for(; frame < DebugImageEncoder::minKeyFrameDistance; ++frame)
+  {
+    fill(image, static_cast<int>(frame));
+    encoder.encode("resync", DebugImage(image), compressed);
+    EXPECT_FALSE(compressed.keyFrame);
+    EXPECT_FALSE(decoder.decode("resync", compressed, decoded));
+  }
+
+  fill(image, static_cast<int>(frame));
+  const DebugImage original(image);
+  encoder.encode("resync", original, compressed);
+  EXPECT_TRUE(compressed.keyFrame);
+  ASSERT_TRUE(decoder.decode("resync", compressed, decoded));
+  EXPECT_TRUE(equal(original, decoded));
+
+  fill(image, static_cast<int>(frame + 1));
+  encoder.encode("resync", DebugImage(image), compressed);
+  EXPECT_FALSE(compressed.keyFrame);
+}
+
+GTEST_TEST(DebugImageCodec, BacklogDoesNotTurnAllImagesIntoKeyFrames)
+{
+  DebugImageEncoder::setLinkState(0.f, 0.f);
+  DebugImageEncoder encoder;
+  Image<PixelTypes::GrayscaledPixel> image(32, 16);
+  CompressedDebugImage compressed;
+  unsigned congestedKeyFrames = 0;
+  unsigned otherKeyFrames = 0;
+
+  // The images of one stream are dropped in every frame.
+  for(int frame = 0; frame < 60; ++frame)
+  {
+    fill(image, frame);
+    encoder.encode("congested", DebugImage(image), compressed);
+    congestedKeyFrames += compressed.keyFrame ? 1 : 0;
+    DebugImageEncoder::requestKeyFrame("congested");
+    encoder.encode("other", DebugImage(image), compressed);
+    otherKeyFrames += compressed.keyFrame ? 1 : 0;
+  }
+
+  // Only the stream that lost images gets additional key frames and at most one per minKeyFrameDistance images.
+  EXPECT_EQ(60 / DebugImageEncoder::minKeyFrameDistance, congestedKeyFrames);
+  EXPECT_EQ(60 / DebugImageEncoder::keyFrameInterval, otherKeyFrames);
+}
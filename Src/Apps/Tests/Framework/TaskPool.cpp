@@ -0,0 +1,95 @@
+#include "Framework/TaskPool.h"
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <vector>
+
+GTEST_TEST(TaskPool, ParallelForVisitsEveryIndexOnce)
+{
+  TaskPool pool(3);
+  for(std::size_t size : {0u, 1u, 2u, 7u, 16u, 1000u})
+  {
+    std::vector<std::atomic<int>> visits(size);
+    pool.parallelFor(nullptr, 0, size, [&](std::size_t begin, std::size_t end)
+    {
+      for(std::size_t i = begin; i < end; ++i)
+        ++visits[i];
+    });
+    for(std::size_t i = 0; i < size; ++i)
+      EXPECT_EQ(1, visits[i]);
+  }
+}
+
+GTEST_TEST(TaskPool, ParallelForRespectsMinChunkSize)
+{
+  TaskPool pool(3);
+  std::atomic<std::size_t> minSize = 1000;
+  pool.parallelFor(nullptr, 10, 110, [&](std::size_t begin, std::size_t end)
+  {
+    std::size_t size = minSize;
+    while(end - begin < size && !minSize.compare_exchange_weak(size, end - begin));
+  }, 20);
+  EXPECT_GE(minSize, 20u);
+}
+
+GTEST_TEST(TaskPool, ParallelReduceMatchesSequential)
+{
+  TaskPool pool(3);
+  std::vector<float> values(10007);
+  for(std::size_t i = 0; i < values.size(); ++i)
+    values[i] = 1.f / static_cast<float>(i + 1);
+
+  auto sum = [&]
+  {
+    return pool.parallelReduce(nullptr, 0, values.size(), 0.f, [&](std::size_t begin, std::size_t end)
+    {
+      float sum = 0.f;
+      for(std::size_t i = begin; i < end; ++i)
+        sum += values[i];
+      return sum;
+    }, [](float a, float b) {return a + b;}, 64);
+  };
+
+  const float parallel = sum();
+  TaskPool::setSequential(true);
+  const float sequential = sum();
+  TaskPool::setSequential(false);
+
+  // The chunks are the same in both modes, so the results are bitwise equal.
+  EXPECT_EQ(parallel, sequential);
+  EXPECT_NEAR(9.79f, parallel, 0.01f);
+}
+
+GTEST_TEST(TaskPool, NestedCallersShareThePool)
+{
+  TaskPool pool(2);
+  std::atomic<int> count = 0;
+  pool.parallelFor(nullptr, 0, 8, [&](std::size_t begin, std::size_t end)
+  {
+    for(std::size_t i = begin; i < end; ++i)
+      pool.parallelFor(nullptr, 0, 100, [&](std::size_t begin, std::size_t end) {count += static_cast<int>(end - begin);});
+  });
+  EXPECT_EQ(800, count);
+}
+
+GTEST_TEST(TaskPool, StartedTasksFinish)
+{
+  TaskPool pool(2);
+  std::atomic<int> count = 0;
+  {
+    std::vector<std::unique_ptr<TaskPool::Task>> tasks;
+    for(int i = 0; i < 20; ++i)
+      tasks.emplace_back(pool.start([&count] {++count;}));
+
+    // Waiting executes the task if no worker has started it yet.
+    tasks.back()->wait();
+    EXPECT_TRUE(tasks.back()->isDone());
+  } // The handles wait for the remaining tasks.
+  EXPECT_EQ(20, count);
+
+  TaskPool::setSequential(true);
+  const std::unique_ptr<TaskPool::Task> task = pool.start([&count] {++count;});
+  TaskPool::setSequential(false);
+  EXPECT_TRUE(task->isDone());
+  EXPECT_EQ(21, count);
+}
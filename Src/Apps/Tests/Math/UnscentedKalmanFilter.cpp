@@ -0,0 +1,144 @@
+#include "Math/UnscentedKalmanFilter.h"
+#include "Math/Random.h"
+#include "Math/Rotation.h"
+
+#include <gtest/gtest.h>
+#include <functional>
+#include <vector>
+
+namespace
+{
+  /** An orientation like the one InertialDataProvider estimates. */
+  struct Orientation : public Manifold<3>
+  {
+    Quaternionf orientation;
+
+    Orientation(const Quaternionf& orientation = Quaternionf::Identity()) : orientation(orientation) {}
+
+    Orientation operator+(const Vectorf& angleAxis) const
+    {
+      return Orientation(*this) += angleAxis;
+    }
+
+    Orientation& operator+=(const Vectorf& angleAxis)
+    {
+      orientation = orientation * Rotation::AngleAxis::unpack(angleAxis);
+      return *this;
+    }
+
+    Vectorf operator-(const Orientation& other) const
+    {
+      return Rotation::AngleAxis::pack(AngleAxisf(other.orientation.inverse() * orientation));
+    }
+  };
+
+  struct IMUSample
+  {
+    Quaternionf orientation; /**< The true orientation. */
+    Vector3f gyro;
+    Vector3f acc;
+  };
+
+  /** Creates the readings of a swaying torso with noisy sensors. */
+  std::vector<IMUSample> record(int frames)
+  {
+    std::vector<IMUSample> samples;
+    Quaternionf orientation = Quaternionf::Identity();
+    for(int i = 0; i < frames; ++i)
+    {
+      const Vector3f gyro(0.4f * std::sin(i * 0.02f), 0.3f * std::cos(i * 0.015f), 0.1f);
+      orientation = orientation * Rotation::AngleAxis::unpack(Vector3f(gyro * 0.012f));
+      const Vector3f acc = orientation.inverse() * Vector3f(0.f, 0.f, 9.81f);
+      samples.push_back({orientation,
+                         gyro + Vector3f(Random::normal(0.01f), Random::normal(0.01f), Random::normal(0.01f)),
+                         acc + Vector3f(Random::normal(0.3f), Random::normal(0.3f), Random::normal(0.3f))});
+    }
+    return samples;
+  }
+}
+
+GTEST_TEST(UnscentedKalmanFilter, LinearModelsMatchKalmanFilter)
+{
+  // For linear models, the unscented transform is exact, i.e. the filter must
+  // produce the same estimates as a Kalman filter.
+  UKF<2> ukf((Vector2f() << 0.f, 1.f).finished());
+  ukf.cov = Matrix2f::Identity();
+  Vector2d x(0.0, 1.0);
+  Matrix2d P = Matrix2d::Identity();
+
+  // A position moving with a constant speed is measured.
+  const Matrix2f dynamicNoise = Vector2f(0.01f, 0.02f).asDiagonal();
+  const Matrix2f measurementNoise = Vector2f(0.04f, 0.25f).asDiagonal();
+  const Matrix2d F = (Matrix2d() << 1.0, 0.1, 0.0, 1.0).finished();
+  const auto dynamicModel = [](Vector2f& state) {state.x() += state.y() * 0.1f;};
+  const auto measurementModel = [](const Vector2f& state) -> Vector2f {return state;};
+  const auto positionModel = [](const Vector2f& state) {return state.x();};
+
+  for(int i = 1; i <= 100; ++i)
+  {
+    // Type-erased models must still be accepted.
+    if(i % 2)
+      ukf.predict(std::function<void(Vector2f&)>(dynamicModel), dynamicNoise);
+    else
+      ukf.predict(dynamicModel, dynamicNoise);
+    x = F * x;
+    P = F * P * F.transpose() + dynamicNoise.cast<double>();
+
+    const Vector2f measurement(i * 0.2f + Random::normal(0.2f), 2.f + Random::normal(0.5f));
+    ukf.update<2>(measurement, measurementModel, measurementNoise);
+    Matrix2d K = P * (P + measurementNoise.cast<double>()).inverse();
+    x += K * (measurement.cast<double>() - x);
+    P -= K * P;
+
+    if(i % 3 == 0)
+    {
+      const float position = i * 0.2f + Random::normal(0.2f);
+      ukf.update(position, positionModel, 0.04f);
+      const Vector2d k = P.col(0) / (P(0, 0) + 0.04);
+      x += k * (position - x.x());
+      P -= k * P.row(0);
+    }
+
+    EXPECT_NEAR(x.x(), ukf.mean.x(), 1e-3);
+    EXPECT_NEAR(x.y(), ukf.mean.y(), 1e-3);
+    for(int j = 0; j < 4; ++j)
+      EXPECT_NEAR(P(j), ukf.cov(j), 1e-5);
+  }
+  EXPECT_NEAR(2.f, ukf.mean.y(), 0.2f);
+}
+
+GTEST_TEST(UnscentedKalmanFilter, ManifoldFilterTracksOrientation)
+{
+  const std::vector<IMUSample> samples = record(1000);
+  const Matrix3f dynamicNoise = Vector3f::Constant(sqr(0.05f)).asDiagonal();
+  const Matrix3f measurementNoise = Vector3f::Constant(sqr(1.f)).asDiagonal();
+
+  // The filter starts with a wrong tilt and must find the actual one.
+  UKFM<Orientation> ukf(Orientation{});
+  ukf.init(Orientation(Quaternionf(AngleAxisf(0.5f, Vector3f::UnitX()))), Matrix3f::Identity() * 0.1f);
+
+  float errorSum = 0.f;
+  for(std::size_t i = 0; i < samples.size(); ++i)
+  {
+    const IMUSample& sample = samples[i];
+    ukf.predict([&](Orientation& state)
+    {
+      state.orientation = state.orientation * Rotation::AngleAxis::unpack(Vector3f(sample.gyro * 0.012f));
+    }, dynamicNoise);
+    ukf.update<3>(sample.acc, [](const Orientation& state) -> Vector3f
+    {
+      return state.orientation.inverse() * Vector3f(0.f, 0.f, 9.81f);
+    }, measurementNoise);
+
+    // Only the direction of gravity is observable.
+    const Vector3f estimated = ukf.mean.orientation.inverse() * Vector3f::UnitZ();
+    const Vector3f actual = sample.orientation.inverse() * Vector3f::UnitZ();
+    const float error = std::acos(std::min(1.f, estimated.dot(actual)));
+    if(i >= 10)
+    {
+      EXPECT_LT(error, 5_deg);
+      errorSum += error;
+    }
+  }
+  EXPECT_LT(errorSum / static_cast<float>(samples.size() - 10), 2_deg);
+}
@@ -0,0 +1,95 @@
+#include "Math/Eigen.h"
+#include "Math/Random.h"
+#include "Tools/Modeling/BallPhysics.h"
+
+#include <gtest/gtest.h>
+#include <limits>
+
+static constexpr float friction = -0.3f;
+
+/** Random ball hypotheses, including resting balls. The number is not a multiple of 4 to also test the remainder. */
+static void createHypotheses(BallPhysics::Vectors& positions, BallPhysics::Vectors& velocities)
+{
+  positions.clear();
+  velocities.clear();
+  for(int i = 0; i < 103; ++i)
+  {
+    positions.push_back(Vector2f(Random::uniform(-4500.f, 4500.f), Random::uniform(-3000.f, 3000.f)));
+    velocities.push_back(i % 10 ? Vector2f::polar(Random::uniform(0.f, 3000.f), Random::uniform(-pi, pi)) : Vector2f::Zero());
+  }
+}
+
+GTEST_TEST(BallPhysics, batchPropagationMatchesScalar)
+{
+  BallPhysics::Vectors positions, velocities, result;
+  createHypotheses(positions, velocities);
+
+  for(float t : {0.f, 0.1f, 1.f, 5.f, 100.f})
+  {
+    BallPhysics::propagateBallPositions(positions, velocities, t, friction, result);
+    ASSERT_EQ(positions.size(), result.size());
+    for(std::size_t i = 0; i < positions.size(); ++i)
+      EXPECT_TRUE(result[i].isApprox(BallPhysics::propagateBallPosition(positions[i], velocities[i], t, friction), 1e-5f)) << "t: " << t << ", i: " << i;
+  }
+
+  BallPhysics::getEndPositions(positions, velocities, friction, result);
+  ASSERT_EQ(positions.size(), result.size());
+  for(std::size_t i = 0; i < positions.size(); ++i)
+    EXPECT_TRUE(result[i].isApprox(BallPhysics::getEndPosition(positions[i], velocities[i], friction), 1e-5f)) << "i: " << i;
+
+  std::vector<float> times;
+  for(int i = 0; i < 50; ++i)
+    times.push_back(0.25f * static_cast<float>(i));
+  BallPhysics::propagateBallPosition(positions[1], velocities[1], times, friction, result);
+  ASSERT_EQ(times.size(), result.size());
+  for(std::size_t i = 0; i < times.size(); ++i)
+    EXPECT_TRUE(result[i].isApprox(BallPhysics::propagateBallPosition(positions[1], velocities[1], times[i], friction), 1e-5f)) << "t: " << times[i];
+}
+
+GTEST_TEST(BallPhysics, batchTimesForDistancesMatchScalar)
+{
+  const Vector2f velocity(1500.f, -800.f);
+  std::vector<float> distances, result;
+  for(int i = 0; i < 71; ++i)
+    distances.push_back(100.f * static_cast<float>(i));
+  BallPhysics::timesForDistances(velocity, distances, friction, result);
+  ASSERT_EQ(distances.size(), result.size());
+  for(std::size_t i = 0; i < distances.size(); ++i)
+  {
+    const float expected = BallPhysics::timeForDistance(velocity, distances[i], friction);
+    if(expected == std::numeric_limits<float>::max())
+      EXPECT_EQ(expected, result[i]) << "distance: " << distances[i];
+    else
+      EXPECT_NEAR(expected, result[i], 1e-3f) << "distance: " << distances[i];
+  }
+}
+
+GTEST_TEST(BallPhysics, interceptionTimesAreAchievable)
+{
+  BallPhysics::Vectors robots, positions;
+  std::vector<float> speeds, times;
+  for(int i = 0; i < 43; ++i)
+  {
+    robots.push_back(Vector2f(Random::uniform(-4500.f, 4500.f), Random::uniform(-3000.f, 3000.f)));
+    speeds.push_back(Random::uniform(100.f, 400.f));
+  }
+
+  for(const Vector2f& velocity : {Vector2f(0.f, 0.f), Vector2f(2000.f, 500.f), Vector2f(-300.f, -1200.f)})
+  {
+    const Vector2f ball(-1000.f, 200.f);
+    BallPhysics::computeInterceptionTimes(ball, velocity, friction, robots, speeds, times, &positions);
+    ASSERT_EQ(robots.size(), times.size());
+    ASSERT_EQ(robots.size(), positions.size());
+    for(std::size_t i = 0; i < robots.size(); ++i)
+    {
+      Vector2f expectedPosition;
+      const float expected = BallPhysics::computeInterceptionTime(ball, velocity, friction, robots[i], speeds[i], &expectedPosition);
+      EXPECT_NEAR(expected, times[i], 1e-3f * std::max(1.f, expected)) << "i: " << i;
+      EXPECT_LT((expectedPosition - positions[i]).norm(), 1.f) << "i: " << i;
+
+      // The robot reaches the interception position in time and the ball is there at that time.
+      EXPECT_LE((positions[i] - robots[i]).norm() / speeds[i], times[i] + 1e-3f) << "i: " << i;
+      EXPECT_LT((BallPhysics::propagateBallPosition(ball, velocity, times[i], friction) - positions[i]).norm(), 1.f) << "i: " << i;
+    }
+  }
+}
@@ -0,0 +1,59 @@
+#include "Tools/Modeling/SampleSet.h"
+
+#include <gtest/gtest.h>
+
+namespace
+{
+  struct Sample
+  {
+    bool left = false;
+    int id = -1;
+  };
+
+  void init(SampleSet<Sample>& samples, int numberOfActiveSamples)
+  {
+    int id = 0;
+    samples.initInTwoGroups(numberOfActiveSamples, [&id](Sample& sample, bool left)
+    {
+      sample.left = left;
+      sample.id = id++;
+    });
+  }
+
+  int countLeft(const SampleSet<Sample>& samples, int numberOfActiveSamples)
+  {
+    int left = 0;
+    for(int i = 0; i < numberOfActiveSamples; ++i)
+      left += samples.at(i).left ? 1 : 0;
+    return left;
+  }
+}
+
+/** Returning from a penalty while the frame runs late must keep poses on both sides of the goal. */
+GTEST_TEST(SampleSet, returnFromPenaltyWithReducedSampleCount)
+{
+  SampleSet<Sample> samples(100);
+  for(int numberOfActiveSamples = 2; numberOfActiveSamples <= samples.size(); ++numberOfActiveSamples)
+  {
+    init(samples, numberOfActiveSamples);
+    EXPECT_EQ(numberOfActiveSamples / 2, countLeft(samples, numberOfActiveSamples)) << "active: " << numberOfActiveSamples;
+    EXPECT_NEAR(samples.size() / 2, countLeft(samples, samples.size()), 1) << "active: " << numberOfActiveSamples;
+  }
+}
+
+/** Reducing the number of samples after the reset must still keep both groups. */
+GTEST_TEST(SampleSet, thinOutKeepsBothGroups)
+{
+  SampleSet<Sample> samples(100);
+  for(int numberOfActiveSamples : {100, 51, 30})
+    for(int targetNumberOfSamples = 2; targetNumberOfSamples <= numberOfActiveSamples; ++targetNumberOfSamples)
+    {
+      init(samples, numberOfActiveSamples);
+      samples.thinOut(numberOfActiveSamples, targetNumberOfSamples);
+      const int left = countLeft(samples, targetNumberOfSamples);
+      EXPECT_GT(left, 0) << "active: " << numberOfActiveSamples << ", target: " << targetNumberOfSamples;
+      EXPECT_LT(left, targetNumberOfSamples) << "active: " << numberOfActiveSamples << ", target: " << targetNumberOfSamples;
+      for(int i = 1; i < targetNumberOfSamples; ++i)
+        EXPECT_LT(samples.at(i - 1).id, samples.at(i).id);
+    }
+}
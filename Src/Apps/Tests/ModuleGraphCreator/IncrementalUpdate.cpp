@@ -0,0 +1,107 @@
+/**
+ * @file ModuleGraphCreator/IncrementalUpdate.cpp
+ *
+ * This file implements a test that compares updating the module graph with
+ * calculating it from scratch for random configuration changes.
+ */
+
+#include "ModuleGraphCreator/ModuleGraphCreatorTest.h"
+#include "Math/Random.h"
+
+#include <gtest/gtest.h>
+
+namespace
+{
+  /** The modules that can provide each representation (see TestModules.h). */
+  const std::vector<std::pair<std::string, std::vector<std::string>>> candidates =
+  {
+    {"A", {"Ac", "Bm", "Cm"}},
+    {"B", {"Bc", "Cc", "Dt"}},
+    {"C", {"Dc", "Ec", "At", "Et"}},
+    {"D", {"Am", "Bt"}},
+    {"aA", {"Ct"}},
+  };
+
+  /** Provides a random representation in a random thread by a random module or not at all. */
+  void change(Configuration& config)
+  {
+    Configuration::Thread& thread = config()[Random::uniformInt(static_cast<int>(config().size()) - 1)];
+    const auto& candidate = candidates[Random::uniformInt(static_cast<int>(candidates.size()) - 1)];
+    auto rp = std::find_if(thread.representationProviders.begin(), thread.representationProviders.end(),
+                           [&](const Configuration::RepresentationProvider& rp) {return rp.representation == candidate.first;});
+    if(rp != thread.representationProviders.end())
+      thread.representationProviders.erase(rp);
+    if(Random::bernoulli(0.7))
+      thread.representationProviders.emplace_back(candidate.first, candidate.second[Random::uniformInt(static_cast<int>(candidate.second.size()) - 1)]);
+  }
+
+  bool update(ModuleGraphCreator& moduleGraphCreator, const Configuration& config)
+  {
+    OutBinaryMemory out(100);
+    out << config;
+    InBinaryMemory in(out.data());
+    return moduleGraphCreator.update(in);
+  }
+
+  void expectEqual(const std::vector<ModuleGraphCreator::ExecutionValues::StringVector>& a,
+                   const std::vector<ModuleGraphCreator::ExecutionValues::StringVector>& b)
+  {
+    ASSERT_EQ(a.size(), b.size());
+    for(std::size_t i = 0; i < a.size(); ++i)
+      EXPECT_EQ(a[i].vector, b[i].vector);
+  }
+}
+
+GTEST_TEST(ModuleGraphCreatorIncremental, EqualsFullCalculation)
+{
+  FunctionList::execute();
+  Blackboard blackboard;
+  Configuration config = createConfig({{}, {}, {}});
+  ModuleGraphCreator incremental(config);
+  int valid = 0;
+
+  // Errors of invalid configurations are expected.
+  testing::internal::CaptureStderr();
+  for(int step = 0; step < 1000; ++step)
+  {
+    const Configuration previous = config;
+    change(config);
+    if(Random::bernoulli(0.2))
+      change(config);
+
+    ModuleGraphCreator full(config);
+    const bool incrementalValid = update(incremental, config);
+    ASSERT_EQ(update(full, config), incrementalValid);
+    if(!incrementalValid)
+    {
+      // Continue with the last valid configuration.
+      config = previous;
+      continue;
+    }
+
+    ++valid;
+    for(std::size_t i = 0; i < config().size(); ++i)
+    {
+      const ModuleGraphCreator::ExecutionValues a = incremental.getExecutionValues(i);
+      const ModuleGraphCreator::ExecutionValues b = full.getExecutionValues(i);
+      expectEqual(a.received, b.received);
+      expectEqual(a.sent, b.sent);
+      ASSERT_EQ(a.modules.size(), b.modules.size());
+      for(std::size_t j = 0; j < a.modules.size(); ++j)
+      {
+        EXPECT_EQ(a.modules[j].module, b.modules[j].module);
+        EXPECT_EQ(a.modules[j].required, b.modules[j].required);
+      }
+      ASSERT_EQ(a.providers.size(), b.providers.size());
+      for(std::size_t j = 0; j < a.providers.size(); ++j)
+      {
+        EXPECT_EQ(a.providers[j].representation, b.providers[j].representation);
+        EXPECT_EQ(a.providers[j].provider, b.providers[j].provider);
+      }
+    }
+  }
+  testing::internal::GetCapturedStderr();
+
+  // Otherwise, the test would not test much.
+  EXPECT_GT(valid, 100);
+}
@@ -0,0 +1,199 @@
+#include "Tools/Motion/KinematicsCache.h"
+#include "MathBase/Random.h"
+
+#include <gtest/gtest.h>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+namespace
+{
+  RobotDimensions dimensions()
+  {
+    RobotDimensions robotDimensions;
+    robotDimensions.yHipOffset = 50.f;
+    robotDimensions.upperLegLength = 100.f;
+    robotDimensions.lowerLegLength = 102.9f;
+    robotDimensions.footHeight = 45.19f;
+    robotDimensions.hipToNeckLength = 211.5f;
+    robotDimensions.armOffset = Vector3f(0.f, 98.f, 185.f);
+    robotDimensions.yOffsetElbowToShoulder = 15.f;
+    robotDimensions.upperArmLength = 105.f;
+    robotDimensions.xOffsetElbowToWrist = 55.95f;
+    return robotDimensions;
+  }
+
+  MassCalibration masses()
+  {
+    MassCalibration massCalibration;
+    FOREACH_ENUM(Limbs::Limb, limb)
+    {
+      massCalibration.masses[limb].mass = Random::uniform(50.f, 500.f);
+      massCalibration.masses[limb].offset = Vector3f(Random::uniform(-30.f, 30.f), Random::uniform(-30.f, 30.f), Random::uniform(-30.f, 30.f));
+    }
+    massCalibration.onRead();
+    return massCalibration;
+  }
+
+  void randomize(JointAngles& jointAngles, Joints::Joint first, Joints::Joint end)
+  {
+    for(int joint = first; joint < end; ++joint)
+    {
+      jointAngles.angles[joint] = Random::uniform(-1.f, 1.f);
+      jointAngles.variance[joint] = Random::uniform(0.f, 0.01f);
+    }
+  }
+
+  /**
+   * Creates the joint data a Motion frame calculates models for: The measured,
+   * the requested, and predicted joint angles. Several modules do so for the
+   * same ones, and the requests often only differ in the arms or in the legs.
+   * @param measured The measured joint angles.
+   * @param request The requested joint angles.
+   * @param armRequest The requested joint angles with other arm joints.
+   * @return The joint data in the order the models are calculated.
+   */
+  std::array<const JointAngles*, 10> createMotionFrame(JointAngles& measured, JointAngles& request, JointAngles& armRequest)
+  {
+    randomize(measured, Joints::headYaw, Joints::numOfJoints);
+    request = measured;
+    randomize(request, Joints::lHipYawPitch, Joints::numOfJoints);
+    armRequest = request;
+    randomize(armRequest, Joints::lShoulderPitch, Joints::firstLegJoint);
+    return {&measured, &measured, &measured, &request, &request, &armRequest, &armRequest, &measured, &request, &armRequest};
+  }
+
+  /** Changes the joints of some random chains. */
+  void change(JointAngles& jointAngles)
+  {
+    if(Random::bernoulli(0.3))
+      randomize(jointAngles, Joints::headYaw, Joints::firstArmJoint);
+    if(Random::bernoulli(0.3))
+      randomize(jointAngles, Joints::lShoulderPitch, Joints::firstRightArmJoint);
+    if(Random::bernoulli(0.3))
+      randomize(jointAngles, Joints::rShoulderPitch, Joints::firstLegJoint);
+    if(Random::bernoulli(0.3))
+      randomize(jointAngles, Joints::lHipYawPitch, Joints::firstRightLegJoint);
+    if(Random::bernoulli(0.3))
+      randomize(jointAngles, Joints::rHipYawPitch, Joints::numOfJoints);
+  }
+
+  void expectEqual(const SE3WithCov& a, const SE3WithCov& b)
+  {
+    EXPECT_TRUE(a.translation == b.translation);
+    EXPECT_TRUE(a.rotation == b.rotation);
+    EXPECT_TRUE(a.covariance == b.covariance);
+  }
+}
+
+GTEST_TEST(KinematicsCache, EqualsCalculation)
+{
+  const RobotDimensions robotDimensions = dimensions();
+  const MassCalibration massCalibration = masses();
+  JointAngles jointAngles;
+  randomize(jointAngles, Joints::headYaw, Joints::numOfJoints);
+  std::vector<JointAngles> previous;
+
+  for(int frame = 0; frame < 100; ++frame)
+  {
+    KinematicsCache::beginFrame();
+    for(int i = 0; i < 10; ++i)
+    {
+      // Sometimes repeat joint data of this frame.
+      if(!previous.empty() && Random::bernoulli(0.3))
+        jointAngles = previous[Random::uniformInt(static_cast<int>(previous.size()) - 1)];
+      else
+        change(jointAngles);
+      previous.push_back(jointAngles);
+
+      const RobotModel cached(jointAngles, robotDimensions, massCalibration);
+      RobotModel calculated;
+      calculated.calculate(jointAngles, robotDimensions, massCalibration);
+      FOREACH_ENUM(Limbs::Limb, limb)
+        expectEqual(calculated.limbs[limb], cached.limbs[limb]);
+      expectEqual(calculated.soleLeft, cached.soleLeft);
+      expectEqual(calculated.soleRight, cached.soleRight);
+      EXPECT_TRUE(calculated.centerOfMass == cached.centerOfMass);
+    }
+    previous.clear();
+  }
+
+  const KinematicsCache::Statistics statistics = KinematicsCache::takeStatistics();
+  EXPECT_GT(statistics.hits, 0u);
+  EXPECT_GT(statistics.partialHits, 0u);
+  EXPECT_EQ(100u, statistics.misses);
+  KinematicsCache::disable();
+}
+
+GTEST_TEST(KinematicsCache, MotionFrameReusesModels)
+{
+  const RobotDimensions robotDimensions = dimensions();
+  const MassCalibration massCalibration = masses();
+  constexpr unsigned frames = 100;
+
+  KinematicsCache::takeStatistics();
+  for(unsigned frame = 0; frame < frames; ++frame)
+  {
+    JointAngles measured, request, armRequest;
+    const auto jointAngles = createMotionFrame(measured, request, armRequest);
+
+    KinematicsCache::beginFrame();
+    for(const JointAngles* j : jointAngles)
+    {
+      RobotModel calculated;
+      calculated.calculate(*j, robotDimensions, massCalibration);
+      EXPECT_TRUE(calculated.centerOfMass == RobotModel(*j, robotDimensions, massCalibration).centerOfMass);
+    }
+  }
+
+  // Only the first model of each frame is calculated from scratch and the
+  // first one of each request is derived from a previous one.
+  const KinematicsCache::Statistics statistics = KinematicsCache::takeStatistics();
+  EXPECT_EQ(7 * frames, statistics.hits);
+  EXPECT_EQ(2 * frames, statistics.partialHits);
+  EXPECT_EQ(frames, statistics.misses);
+  KinematicsCache::disable();
+}
+
+/**
+ * Measures the time of the models of a Motion frame with and without the
+ * cache. Run with --gtest_also_run_disabled_tests, preferably on the robot.
+ */
+GTEST_TEST(KinematicsCache, DISABLED_MotionFrameTime)
+{
+  const RobotDimensions robotDimensions = dimensions();
+  const MassCalibration massCalibration = masses();
+  constexpr unsigned frames = 10000;
+
+  // The joint data is created in advance, so only the models are measured.
+  std::vector<std::array<JointAngles, 3>> jointAngles(frames);
+  std::vector<std::array<const JointAngles*, 10>> motionFrames;
+  for(std::array<JointAngles, 3>& j : jointAngles)
+    motionFrames.push_back(createMotionFrame(j[0], j[1], j[2]));
+
+  const auto measure = [&](bool cached)
+  {
+    Vector3f sum = Vector3f::Zero();
+    const auto start = std::chrono::steady_clock::now();
+    for(const auto& motionFrame : motionFrames)
+    {
+      if(cached)
+        KinematicsCache::beginFrame();
+      for(const JointAngles* j : motionFrame)
+        sum += RobotModel(*j, robotDimensions, massCalibration).centerOfMass;
+    }
+    const double time = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() / frames;
+    KinematicsCache::disable();
+    EXPECT_TRUE(std::isfinite(sum.sum()));
+    return time;
+  };
+
+  const double uncached = measure(false);
+  const double cached = measure(true);
+  RecordProperty("uncachedMicrosecondsPerFrame", std::to_string(uncached));
+  RecordProperty("cachedMicrosecondsPerFrame", std::to_string(cached));
+  std::cout << "Models per Motion frame without cache: " << uncached << " us, with cache: " << cached
+            << " us, saved: " << uncached - cached << " us per 12 ms cycle" << std::endl;
+}
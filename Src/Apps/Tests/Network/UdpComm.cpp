@@ -0,0 +1,73 @@
+#include "Network/UdpComm.h"
+#include "Platform/Time.h"
+
+#include <gtest/gtest.h>
+#include <chrono>
+#include <string>
+#include <thread>
+
+namespace
+{
+  constexpr int port = 39871;
+
+  /** Reads batches until the expected number of packets was received or a timeout occurs. */
+  int readAll(UdpComm& socket, int expected, std::vector<std::string>& payloads, std::vector<UdpComm::Packet>& packets)
+  {
+    for(int attempt = 0; attempt < 100 && static_cast<int>(packets.size()) < expected; ++attempt)
+    {
+      const int packetsRead = socket.readBatch();
+      if(packetsRead < 0)
+        return packetsRead;
+      for(int i = 0; i < packetsRead; ++i)
+      {
+        packets.push_back(socket.getPacket(i));
+        payloads.emplace_back(packets.back().data, packets.back().size);
+      }
+      if(!packetsRead)
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return static_cast<int>(packets.size());
+  }
+}
+
+GTEST_TEST(UdpComm, BatchesOnLoopback)
+{
+  UdpComm receiver;
+  ASSERT_TRUE(receiver.setBlocking(false));
+  ASSERT_TRUE(receiver.bind("127.0.0.1", port));
+  receiver.reserveBatch(4, 16);
+  EXPECT_EQ(0, receiver.readBatch());
+
+  UdpComm sender;
+  ASSERT_TRUE(sender.setTarget("127.0.0.1", port));
+  const unsigned start = Time::getCurrentSystemTime();
+  for(int i = 0; i < 10; ++i)
+    sender.queue(("packet " + std::to_string(i)).c_str(), 8);
+  sender.queue("this packet is too long", 23);
+  EXPECT_EQ(11, sender.flush());
+  EXPECT_EQ(0, sender.flush());
+
+  // More packets than reserved are read by several batches.
+  std::vector<std::string> payloads;
+  std::vector<UdpComm::Packet> packets;
+  EXPECT_EQ(4, receiver.readBatch());
+  for(int i = 0; i < 4; ++i)
+  {
+    packets.push_back(receiver.getPacket(i));
+    payloads.emplace_back(packets.back().data, packets.back().size);
+  }
+  ASSERT_EQ(11, readAll(receiver, 11, payloads, packets));
+
+  const unsigned end = Time::getCurrentSystemTime();
+  for(int i = 0; i < 10; ++i)
+    EXPECT_EQ("packet " + std::to_string(i), payloads[i]);
+  EXPECT_EQ("this packet is ", payloads[10].substr(0, 15));
+  EXPECT_EQ(16, packets[10].size); // Truncated
+  for(const UdpComm::Packet& packet : packets)
+  {
+    EXPECT_EQ(0x7f000001u, packet.ip);
+    EXPECT_LE(start, packet.timestamp);
+    EXPECT_GE(end, packet.timestamp);
+  }
+  EXPECT_EQ(0, receiver.readBatch());
+}
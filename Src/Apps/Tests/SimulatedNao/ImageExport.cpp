@@ -0,0 +1,42 @@
+#include "SimulatedNao/ImageExport.h"
+
+#include <gtest/gtest.h>
+#include <QBuffer>
+
+/** A camera pixel for which the general version of exportImage is used. */
+struct GenericYUYVPixel : PixelTypes::YUYVPixel {};
+
+template<typename Pixel>
+static QImage exportAndLoad(const Image<Pixel>& image, ImageExport::ExportMode mode)
+{
+  QBuffer buffer;
+  buffer.open(QIODevice::WriteOnly);
+  EXPECT_TRUE(ImageExport::exportImage(image, buffer, mode));
+  return QImage::fromData(buffer.data(), "PNG");
+}
+
+GTEST_TEST(ImageExport, CameraImageLikeGeneralVersion)
+{
+  // An odd width and all values of each channel, including the extremes.
+  Image<PixelTypes::YUYVPixel> image(37, 29);
+  Image<GenericYUYVPixel> generic(image.width, image.height);
+  for(unsigned y = 0; y < image.height; ++y)
+    for(unsigned x = 0; x < image.width; ++x)
+    {
+      const unsigned i = y * image.width + x;
+      image[y][x] = PixelTypes::YUYVPixel(static_cast<unsigned char>(i * 7), static_cast<unsigned char>(i * 13 + 128),
+                                          static_cast<unsigned char>(255 - i * 7), static_cast<unsigned char>(i * 31));
+      static_cast<PixelTypes::YUYVPixel&>(generic[y][x]) = image[y][x];
+    }
+
+  for(ImageExport::ExportMode mode : {ImageExport::rgb, ImageExport::raw, ImageExport::grayscale})
+  {
+    const QImage fast = exportAndLoad(image, mode);
+    const QImage reference = exportAndLoad(generic, mode);
+    ASSERT_FALSE(fast.isNull());
+    ASSERT_EQ(static_cast<int>(image.width * 2), fast.width());
+    ASSERT_EQ(static_cast<int>(image.height), fast.height());
+    EXPECT_EQ(reference.format(), fast.format()) << "mode " << mode;
+    EXPECT_TRUE(reference == fast) << "mode " << mode;
+  }
+}
@@ -0,0 +1,152 @@
+#include "SimulatedNao/LogExtractor.h"
+#include "SimulatedNao/LogPlayer.h"
+#include "Framework/LoggingTools.h"
+#include "Streaming/FunctionList.h"
+#include "Streaming/InStreams.h"
+#include "Streaming/OutStreams.h"
+#include "Streaming/TypeInfo.h"
+
+#include <gtest/gtest.h>
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+/** The contents of a file written by LogExtractor::saveColumns. */
+struct Columns
+{
+  struct Column
+  {
+    std::string name;
+    std::vector<unsigned> offsets;
+    std::vector<char> data;
+  };
+
+  std::vector<std::string> threads;
+  std::vector<unsigned char> threadOfFrame;
+  std::vector<Column> columns;
+
+  bool read(const std::string& fileName)
+  {
+    InBinaryFile stream(fileName);
+    if(!stream.exists())
+      return false;
+    unsigned char version;
+    stream >> version;
+    EXPECT_EQ(1, version);
+    TypeInfo typeInfo(false);
+    stream >> typeInfo;
+    unsigned size;
+    stream >> size;
+    threads.resize(size);
+    for(std::string& thread : threads)
+      stream >> thread;
+    stream >> size;
+    threadOfFrame.resize(size);
+    stream.read(threadOfFrame.data(), size);
+    stream >> size;
+    columns.resize(size);
+    for(Column& column : columns)
+    {
+      stream >> column.name;
+      column.offsets.resize(threadOfFrame.size() + 1);
+      stream.read(column.offsets.data(), column.offsets.size() * sizeof(unsigned));
+      column.data.resize(column.offsets.back());
+      stream.read(column.data.data(), column.data.size());
+    }
+    return true;
+  }
+};
+
+/**
+ * Writes a log with alternating threads, a message that is logged twice in
+ * a frame, frames without some of the messages, and an unfinished frame at
+ * the end.
+ */
+static void writeLog(const std::string& fileName)
+{
+  MessageQueue queue;
+  const auto frame = [&queue](const char* thread, const std::vector<std::pair<MessageID, unsigned>>& messages, bool finished = true)
+  {
+    queue.bin(idFrameBegin) << std::string(thread);
+    for(const auto& [id, value] : messages)
+      queue.bin(id) << value;
+    if(finished)
+      queue.bin(idFrameFinished) << std::string(thread);
+  };
+  frame("Cognition", {{idFrameInfo, 1}});
+  frame("Motion", {{idJointAngles, 10}, {idJointAngles, 11}});
+  frame("Cognition", {{idFrameInfo, 2}, {idJointAngles, 12}, {idFrameInfo, 3}});
+  frame("Motion", {});
+  frame("Audio", {{idFrameInfo, 4}});
+  frame("Cognition", {{idFrameInfo, 5}}, false);
+
+  OutBinaryFile stream(fileName);
+  ASSERT_TRUE(stream.exists());
+  stream << LoggingTools::logFileUncompressed << queue;
+}
+
+GTEST_TEST(LogExtractor, SaveColumnsMatchesFrames)
+{
+  FunctionList::execute();
+  const std::filesystem::path directory = std::filesystem::temp_directory_path();
+  const std::string logFileName = (directory / "LogExtractorTest.log").generic_string();
+  const std::string columnsFileName = (directory / "LogExtractorTest.columns").generic_string();
+  writeLog(logFileName);
+
+  {
+    MessageQueue target;
+    LogPlayer logPlayer(target);
+    ASSERT_TRUE(logPlayer.open(logFileName));
+    ASSERT_EQ(5u, logPlayer.frames());
+
+    const std::vector<MessageID> messageIDs = {idFrameInfo, idJointAngles};
+    ASSERT_TRUE(LogExtractor(logPlayer).saveColumns(columnsFileName, messageIDs, TypeInfo(true)));
+    Columns columns;
+    ASSERT_TRUE(columns.read(columnsFileName));
+    ASSERT_EQ(logPlayer.frames(), columns.threadOfFrame.size());
+    EXPECT_EQ((std::vector<std::string>{"Cognition", "Motion", "Audio"}), columns.threads);
+    ASSERT_EQ(messageIDs.size(), columns.columns.size());
+    EXPECT_EQ("FrameInfo", columns.columns[0].name);
+    EXPECT_EQ("JointAngles", columns.columns[1].name);
+
+    // Each row must contain the last message of the frame played back by "log goto".
+    for(size_t frame = 0; frame < logPlayer.frames(); ++frame)
+    {
+      ASSERT_LT(columns.threadOfFrame[frame], columns.threads.size());
+      EXPECT_EQ(logPlayer.threadOf(frame), columns.threads[columns.threadOfFrame[frame]]);
+      target.clear();
+      logPlayer.playBack(frame);
+      for(size_t i = 0; i < messageIDs.size(); ++i)
+      {
+        std::vector<char> expected;
+        for(MessageQueue::Message message : target)
+          if(message.id() == messageIDs[i])
+            expected.assign(message.data(), message.data() + message.size());
+        const Columns::Column& column = columns.columns[i];
+        ASSERT_LE(column.offsets[frame], column.offsets[frame + 1]);
+        EXPECT_EQ(expected, std::vector<char>(column.data.begin() + column.offsets[frame], column.data.begin() + column.offsets[frame + 1]))
+          << column.name << " in frame " << frame;
+      }
+    }
+
+    // The values that won, to check the comparison itself.
+    const auto value = [&columns](size_t column, size_t frame)
+    {
+      const Columns::Column& c = columns.columns[column];
+      EXPECT_EQ(sizeof(unsigned), c.offsets[frame + 1] - c.offsets[frame]);
+      unsigned value = 0;
+      std::memcpy(&value, c.data.data() + c.offsets[frame], sizeof(unsigned));
+      return value;
+    };
+    EXPECT_EQ(1u, value(0, 0));
+    EXPECT_EQ(11u, value(1, 1));
+    EXPECT_EQ(3u, value(0, 2));
+    EXPECT_EQ(12u, value(1, 2));
+    EXPECT_EQ(4u, value(0, 4));
+    EXPECT_EQ(columns.columns[0].offsets[3], columns.columns[0].offsets[4]);
+  }
+
+  std::filesystem::remove(logFileName);
+  std::filesystem::remove(columnsFileName);
+}
@@ -0,0 +1,124 @@
+#include "Representations/Infrastructure/SensorData/JointSensorData.h"
+#include "Streaming/FieldPlan.h"
+#include "Streaming/FunctionList.h"
+#include "Streaming/MessageQueue.h"
+#include "Streaming/OutStreams.h"
+#include "Streaming/TypeInfo.h"
+#include "Streaming/TypeRegistry.h"
+
+#include <gtest/gtest.h>
+#include <string>
+
+namespace
+{
+  JointSensorData jointSensorDataOfFrame(int frame)
+  {
+    JointSensorData jointSensorData;
+    FOREACH_ENUM(Joints::Joint, joint)
+    {
+      jointSensorData.angles[joint] = static_cast<float>(frame) + static_cast<float>(joint) * 0.01f;
+      jointSensorData.currents[joint] = static_cast<short>(frame * 100 + joint);
+      jointSensorData.temperatures[joint] = static_cast<unsigned char>(30 + joint);
+      jointSensorData.status[joint] = static_cast<JointSensorData::TemperatureStatus>((frame + joint) % JointSensorData::numOfTemperatureStatuss);
+    }
+    jointSensorData.timestamp = 1000 + frame * 12;
+    return jointSensorData;
+  }
+}
+
+GTEST_TEST(FieldPlan, DecodesJointSensorData)
+{
+  FunctionList::execute();
+  const TypeInfo typeInfo(true);
+
+  // A synthetic log of a Motion thread.
+  MessageQueue log;
+  const int numOfFrames = 10;
+  for(int frame = 0; frame < numOfFrames; ++frame)
+  {
+    log.bin(idFrameBegin) << std::string("Motion");
+    log.bin(idJointSensorData) << jointSensorDataOfFrame(frame);
+    log.bin(idFrameFinished) << std::string("Motion");
+  }
+
+  const FieldPlan angles(typeInfo, "JointSensorData", "angles");
+  const FieldPlan knee(typeInfo, "JointSensorData", std::string("angles.") + TypeRegistry::getEnumName(Joints::lKneePitch));
+  const FieldPlan timestamp(typeInfo, "JointSensorData", "timestamp");
+  const FieldPlan current(typeInfo, "JointSensorData", std::string("currents.") + TypeRegistry::getEnumName(Joints::lShoulderPitch));
+  const FieldPlan status(typeInfo, "JointSensorData", "status");
+  ASSERT_EQ(static_cast<std::size_t>(Joints::numOfJoints), angles.getColumns());
+  ASSERT_EQ(1u, knee.getColumns());
+  ASSERT_EQ(1u, timestamp.getColumns());
+  ASSERT_EQ(static_cast<std::size_t>(Joints::numOfJoints), status.getColumns());
+
+  int frame = 0;
+  for(MessageQueue::Message message : log)
+    if(message.id() == idJointSensorData)
+    {
+      const JointSensorData expected = jointSensorDataOfFrame(frame++);
+      double values[Joints::numOfJoints];
+      ASSERT_TRUE(angles.decode(message.data(), message.size(), values));
+      FOREACH_ENUM(Joints::Joint, joint)
+        EXPECT_FLOAT_EQ(expected.angles[joint], static_cast<float>(values[joint]));
+      ASSERT_TRUE(knee.decode(message.data(), message.size(), values));
+      EXPECT_FLOAT_EQ(expected.angles[Joints::lKneePitch], static_cast<float>(values[0]));
+      ASSERT_TRUE(timestamp.decode(message.data(), message.size(), values));
+      EXPECT_EQ(expected.timestamp, values[0]);
+      ASSERT_TRUE(current.decode(message.data(), message.size(), values));
+      EXPECT_EQ(expected.currents[Joints::lShoulderPitch], values[0]);
+      ASSERT_TRUE(status.decode(message.data(), message.size(), values));
+      FOREACH_ENUM(Joints::Joint, joint)
+        EXPECT_EQ(static_cast<double>(expected.status[joint]), values[joint]);
+
+      // Messages that are too short are detected.
+      EXPECT_FALSE(status.decode(message.data(), message.size() - 1, values));
+    }
+  EXPECT_EQ(numOfFrames, frame);
+}
+
+GTEST_TEST(FieldPlan, StaticArraysHaveNoSize)
+{
+  TypeInfo typeInfo(false);
+  typeInfo.primitives = {"int", "float", "std::string"};
+  typeInfo.classes["Element"] = {{"int*", "values"}, {"float", "weight"}};
+  typeInfo.classes["Test"] = {{"float[2]", "fixed"}, {"std::string[2]", "names"}, {"Element[3]", "elements"}, {"int", "after"}};
+
+  OutBinaryMemory stream;
+  stream << 1.5f << 2.5f;
+  stream << std::string("a") << std::string("bcd");
+  for(int i = 0; i < 3; ++i)
+  {
+    stream << static_cast<unsigned>(i);
+    for(int j = 0; j < i; ++j)
+      stream << j;
+    stream << static_cast<float>(i) * 0.5f;
+  }
+  stream << 42;
+
+  double values[2];
+  const FieldPlan fixed(typeInfo, "Test", "fixed");
+  ASSERT_EQ(2u, fixed.getColumns());
+  ASSERT_TRUE(fixed.decode(stream.data(), stream.size(), values));
+  EXPECT_EQ(1.5, values[0]);
+  EXPECT_EQ(2.5, values[1]);
+
+  const FieldPlan second(typeInfo, "Test", "fixed[1]");
+  ASSERT_TRUE(second.decode(stream.data(), stream.size(), values));
+  EXPECT_EQ(2.5, values[0]);
+
+  double value;
+  const FieldPlan after(typeInfo, "Test", "after");
+  ASSERT_TRUE(after.decode(stream.data(), stream.size(), &value));
+  EXPECT_EQ(42.0, value);
+  EXPECT_FALSE(after.decode(stream.data(), stream.size() - 1, &value));
+
+  const FieldPlan weight(typeInfo, "Test", "elements[2].weight");
+  ASSERT_TRUE(weight.decode(stream.data(), stream.size(), &value));
+  EXPECT_EQ(1.0, value);
+
+  const FieldPlan element(typeInfo, "Test", "elements[2].values[1]");
+  ASSERT_TRUE(element.decode(stream.data(), stream.size(), &value));
+  EXPECT_EQ(1.0, value);
+
+  EXPECT_THROW(FieldPlan(typeInfo, "Test", "elements[3].weight"), std::runtime_error);
+}
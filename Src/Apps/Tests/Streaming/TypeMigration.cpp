@@ -0,0 +1,104 @@
+#include "Streaming/TypeMigration.h"
+#include "Streaming/InStreams.h"
+#include "Streaming/OutStreams.h"
+
+#include <gtest/gtest.h>
+
+namespace
+{
+  TypeInfo oldTypeInfo()
+  {
+    TypeInfo typeInfo(false);
+    typeInfo.primitives = {"short", "int", "float", "std::string"};
+    typeInfo.enums["Color"] = {"red", "green", "blue"};
+    typeInfo.classes["Element"] = {{"int", "x"}};
+    typeInfo.classes["Test"] = {{"short", "number"}, {"float", "oldName"}, {"Color", "color"}, {"int[3]", "array"},
+                                {"Element*", "elements"}, {"std::string", "text"}, {"float", "dropped"}};
+    return typeInfo;
+  }
+
+  TypeInfo newTypeInfo()
+  {
+    TypeInfo typeInfo(false);
+    typeInfo.primitives = {"unsigned char", "int", "float", "std::string"};
+    typeInfo.enums["Color"] = {"blue", "red", "yellow"};
+    typeInfo.classes["Element"] = {{"float", "y"}, {"int", "x"}};
+    typeInfo.classes["Test"] = {{"unsigned char", "number"}, {"float", "newName"}, {"int[4]", "array"}, {"Color", "color"},
+                                {"Element*", "elements"}, {"std::string", "text"}, {"int", "added"}};
+    return typeInfo;
+  }
+}
+
+GTEST_TEST(TypeMigration, ConvertsBinaryData)
+{
+  const TypeMigration migration(oldTypeInfo(), newTypeInfo(), "Test");
+  ASSERT_TRUE(migration.isValid());
+
+  OutBinaryMemory source;
+  source << static_cast<short>(300) << 1.5f << static_cast<unsigned char>(2) << 1 << 2 << 3
+         << 2u << 10 << 20 << std::string("text") << 7.f;
+
+  OutBinaryMemory current;
+  current << static_cast<unsigned char>(0) << 0.f << 4 << 5 << 6 << 7 << static_cast<unsigned char>(2)
+          << 1u << 8.f << 9 << std::string() << 42;
+
+  OutBinaryMemory target;
+  ASSERT_TRUE(migration.apply(source.data(), source.size(), current.data(), current.size(), target));
+
+  InBinaryMemory stream(target.data(), target.size());
+  float newName, y0, y1;
+  unsigned char number, color;
+  int array[4], x0, x1, added;
+  unsigned count;
+  std::string text;
+  stream >> number >> newName >> array[0] >> array[1] >> array[2] >> array[3] >> color
+         >> count >> y0 >> x0 >> y1 >> x1 >> text >> added;
+  EXPECT_TRUE(stream.eof());
+
+  EXPECT_EQ(1.5f, newName); // Renamed
+  EXPECT_EQ(255, number); // Clipped
+  EXPECT_EQ(0, color); // "blue" mapped
+  EXPECT_EQ(1, array[0]);
+  EXPECT_EQ(2, array[1]);
+  EXPECT_EQ(3, array[2]);
+  EXPECT_EQ(7, array[3]); // Kept
+  EXPECT_EQ(2u, count);
+  EXPECT_EQ(8.f, y0); // Kept from current element
+  EXPECT_EQ(10, x0);
+  EXPECT_EQ(0.f, y1); // Zero in new element
+  EXPECT_EQ(20, x1);
+  EXPECT_EQ("text", text);
+  EXPECT_EQ(42, added); // Kept
+}
+
+GTEST_TEST(TypeMigration, ScalesChangedNumbers)
+{
+  TypeInfo oldInfo(false);
+  oldInfo.primitives = {"short", "unsigned"};
+  oldInfo.classes["Audio"] = {{"unsigned", "channels"}, {"short*", "samples"}};
+  TypeInfo newInfo(false);
+  newInfo.primitives = {"float", "unsigned"};
+  newInfo.classes["Audio"] = {{"unsigned", "channels"}, {"float*", "samples"}};
+
+  const TypeMigration migration(oldInfo, newInfo, "Audio", {{"Audio", "samples", 1.0 / 32767.0}});
+  OutBinaryMemory source;
+  source << 2u << 3u << static_cast<short>(32767) << static_cast<short>(-32767) << static_cast<short>(0);
+  OutBinaryMemory current;
+  current << 4u << 0u;
+  OutBinaryMemory target;
+  ASSERT_TRUE(migration.apply(source.data(), source.size(), current.data(), current.size(), target));
+
+  InBinaryMemory stream(target.data(), target.size());
+  unsigned channels, count;
+  float samples[3];
+  stream >> channels >> count >> samples[0] >> samples[1] >> samples[2];
+  EXPECT_EQ(2u, channels);
+  EXPECT_EQ(3u, count);
+  EXPECT_FLOAT_EQ(1.f, samples[0]);
+  EXPECT_FLOAT_EQ(-1.f, samples[1]);
+  EXPECT_FLOAT_EQ(0.f, samples[2]);
+
+  // Incomplete data is detected.
+  OutBinaryMemory incomplete;
+  EXPECT_FALSE(migration.apply(source.data(), source.size() - 1, current.data(), current.size(), incomplete));
+}
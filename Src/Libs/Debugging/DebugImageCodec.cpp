@@ -0,0 +1,231 @@
+/**
+ * @file DebugImageCodec.cpp
+ *
+ * This file implements the classes that compress and decompress debug images.
+ */
+
+#include "DebugImageCodec.h"
+#include "Platform/Time.h"
+#include <algorithm>
+#include <cstring>
+
+std::atomic<float> DebugImageEncoder::throughput = 0.f;
+std::atomic<float> DebugImageEncoder::backlog = 0.f;
+std::recursive_mutex DebugImageEncoder::_mutex;
+std::unordered_map<std::string, unsigned> DebugImageEncoder::keyFrameRequests;
+
+/**
+ * Copies every scale-th pixel of every scale-th row of an image.
+ * @param image The image.
+ * @param scale The step size in both dimensions.
+ * @param pixels The pixels copied.
+ */
+static void downscale(const DebugImage& image, unsigned scale, std::vector<unsigned char>& pixels)
+{
+  const std::size_t pixelSize = PixelTypes::pixelSize(image.type);
+  const std::size_t rowSize = image.width * pixelSize;
+  pixels.resize((image.width + scale - 1) / scale * ((image.height + scale - 1) / scale) * pixelSize);
+  unsigned char* dest = pixels.data();
+  for(unsigned y = 0; y < image.height; y += scale)
+  {
+    const unsigned char* src = static_cast<const unsigned char*>(image.data) + y * rowSize;
+    if(scale == 1)
+    {
+      std::memcpy(dest, src, rowSize);
+      dest += rowSize;
+    }
+    else
+      for(unsigned x = 0; x < image.width; x += scale, dest += pixelSize)
+        std::memcpy(dest, src + x * pixelSize, pixelSize);
+  }
+}
+
+/**
+ * Replicates downscaled pixels to fill an image in its original resolution.
+ * @param pixels The downscaled pixels.
+ * @param scale The step size in both dimensions.
+ * @param image The image. Its type and size must already be set.
+ */
+static void upscale(const std::vector<unsigned char>& pixels, unsigned scale, DebugImage& image)
+{
+  const std::size_t pixelSize = PixelTypes::pixelSize(image.type);
+  const std::size_t rowSize = image.width * pixelSize;
+  const std::size_t srcRowSize = (image.width + scale - 1) / scale * pixelSize;
+  unsigned char* dest = static_cast<unsigned char*>(image.data);
+  for(unsigned y = 0; y < image.height; ++y, dest += rowSize)
+    if(y % scale)
+      std::memcpy(dest, dest - rowSize, rowSize);
+    else
+    {
+      const unsigned char* src = pixels.data() + y / scale * srcRowSize;
+      if(scale == 1)
+        std::memcpy(dest, src, rowSize);
+      else
+        for(unsigned x = 0; x < image.width; ++x)
+          std::memcpy(dest + x * pixelSize, src + x / scale * pixelSize, pixelSize);
+    }
+}
+
+/**
+ * Encodes bytes or their differences to reference bytes. Each zero is
+ * followed by the number of further zeros (at most 255), all other values are
+ * stored as they are.
+ * @param pixels The bytes to encode.
+ * @param reference The reference bytes. If \c nullptr, the bytes themselves are encoded.
+ * @param size The number of bytes.
+ * @param data The encoded data.
+ */
+static void encodeRuns(const unsigned char* pixels, const unsigned char* reference, std::size_t size, std::vector<unsigned char>& data)
+{
+  data.clear();
+  for(std::size_t i = 0; i < size;)
+  {
+    const unsigned char base = reference ? reference[i] : 0;
+    if(pixels[i] != base)
+      data.push_back(static_cast<unsigned char>(pixels[i] - base));
+    else
+    {
+      std::size_t run = 1;
+      while(run < 256 && i + run < size && pixels[i + run] == (reference ? reference[i + run] : 0))
+        ++run;
+      data.push_back(0);
+      data.push_back(static_cast<unsigned char>(run - 1));
+      i += run - 1;
+    }
+    ++i;
+  }
+}
+
+/**
+ * Decodes bytes encoded by \c encodeRuns .
+ * @param data The encoded data.
+ * @param pixels The decoded bytes. The size must already be set. If
+ *               differences are decoded, it must contain the reference bytes.
+ * @param differences Were differences encoded?
+ * @return Did the data match the number of bytes?
+ */
+static bool decodeRuns(const std::vector<unsigned char>& data, std::vector<unsigned char>& pixels, bool differences)
+{
+  unsigned char* p = pixels.data();
+  unsigned char* const end = p + pixels.size();
+  for(std::size_t i = 0; i < data.size(); ++i)
+    if(data[i])
+    {
+      if(p == end)
+        return false;
+      *p = differences ? static_cast<unsigned char>(*p + data[i]) : data[i];
+      ++p;
+    }
+    else
+    {
+      if(++i == data.size() || static_cast<std::size_t>(end - p) <= data[i])
+        return false;
+      if(!differences)
+        std::memset(p, 0, data[i] + 1);
+      p += data[i] + 1;
+    }
+  return p == end;
+}
+
+void DebugImageEncoder::setLinkState(float throughput, float backlog)
+{
+  DebugImageEncoder::throughput = throughput;
+  DebugImageEncoder::backlog = backlog;
+}
+
+void DebugImageEncoder::requestKeyFrame(const std::string& id)
+{
+  SYNC;
+  ++keyFrameRequests[id];
+}
+
+void DebugImageEncoder::encode(const std::string& id, const DebugImage& image, CompressedDebugImage& compressed)
+{
+  Stream& stream = streams[id];
+  const float rate = throughput;
+  const float fill = backlog;
+  unsigned requests;
+  {
+    SYNC;
+    const auto request = keyFrameRequests.find(id);
+    requests = request == keyFrameRequests.end() ? 0 : request->second;
+  }
+  compressed.sequence = stream.sequence++;
+
+  // Skip the image if the stream would use more than its share of the throughput.
+  if(stream.scale && rate > 0.f
+     && static_cast<float>(Time::getTimeSince(stream.timeOfLastImage)) < static_cast<float>(stream.sizeOfLastImage) * 1000.f / (throughputShare * rate))
+  {
+    compressed.type = stream.type;
+    compressed.width = stream.width;
+    compressed.height = stream.height;
+    compressed.scale = stream.scale;
+    compressed.keyFrame = false;
+    compressed.data.clear();
+    return;
+  }
+
+  // The fuller the outgoing queue, the coarser the image.
+  const unsigned char scale = fill < 0.1f ? 1 : fill < 0.3f ? 2 : 4;
+  downscale(image, scale, pixels);
+
+  compressed.type = image.type;
+  compressed.width = image.width;
+  compressed.height = image.height;
+  compressed.scale = scale;
+  compressed.keyFrame = scale != stream.scale || image.type != stream.type || image.width != stream.width
+                        || image.height != stream.height || compressed.sequence - stream.lastKeyFrame >= keyFrameInterval
+                        || (requests != stream.keyFrameRequests && compressed.sequence - stream.lastKeyFrame >= minKeyFrameDistance);
+  encodeRuns(pixels.data(), compressed.keyFrame ? nullptr : stream.previous.data(), pixels.size(), compressed.data);
+
+  if(compressed.keyFrame)
+  {
+    stream.lastKeyFrame = compressed.sequence;
+    stream.keyFrameRequests = requests;
+  }
+  stream.previous.swap(pixels);
+  stream.type = image.type;
+  stream.width = image.width;
+  stream.height = image.height;
+  stream.scale = scale;
+  stream.timeOfLastImage = Time::getCurrentSystemTime();
+  stream.sizeOfLastImage = compressed.data.size();
+}
+
+bool DebugImageDecoder::decode(const std::string& id, const CompressedDebugImage& compressed, DebugImage& image)
+{
+  Stream& stream = streams[id];
+  const unsigned scale = std::max<unsigned>(compressed.scale, 1);
+  const std::size_t size = (compressed.width + scale - 1) / scale * ((compressed.height + scale - 1) / scale)
+                           * PixelTypes::pixelSize(compressed.type);
+
+  if(compressed.keyFrame)
+    stream.previous.resize(size);
+  else if(!stream.valid || compressed.sequence != stream.nextSequence || stream.previous.size() != size)
+  {
+    // A difference to an image that was lost cannot be decoded. Wait for the next key frame.
+    stream.valid = false;
+    return false;
+  }
+
+  stream.valid = compressed.data.empty() && !compressed.keyFrame ? true : decodeRuns(compressed.data, stream.previous, !compressed.keyFrame);
+  if(!stream.valid)
+    return false;
+  stream.nextSequence = compressed.sequence + 1;
+
+  image.allocate(compressed.type, compressed.width, compressed.height);
+  upscale(stream.previous, scale, image);
+  return true;
+}
+
+void _sendDebugImage(const char* id, const DebugImage& image)
+{
+#ifdef TARGET_ROBOT
+  static thread_local DebugImageEncoder encoder;
+  static thread_local CompressedDebugImage compressed;
+  encoder.encode(id, image, compressed);
+  OUTPUT(idDebugImageCompressed, bin, id << compressed);
+#else
+  OUTPUT(idDebugImage, bin, id << image);
+#endif
+}
@@ -0,0 +1,120 @@
+/**
+ * @file DebugImageCodec.h
+ *
+ * This file declares the classes that compress debug images on the robot and
+ * decompress them again on the PC. An image can be downscaled by only keeping
+ * every n-th pixel of every n-th row. The remaining pixels are encoded as
+ * differences to the previous image of the same stream (or as they are in a
+ * key frame) and runs of zero bytes are collapsed. Thereby, static parts of
+ * an image and sparse debug images cost almost no bandwidth. The encoder
+ * selects the scale and skips images depending on the throughput and the
+ * backlog of the debug connection, which the DebugHandler reports.
+ */
+
+#pragma once
+
+#include "Debugging/DebugImages.h"
+#include "Platform/Thread.h"
+#include "Streaming/AutoStreamable.h"
+#include <atomic>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+STREAMABLE(CompressedDebugImage,
+{,
+  (PixelTypes::PixelType)(PixelTypes::Grayscale) type, /**< The pixel type of the image. */
+  (unsigned short)(0) width, /**< The width of the original image in pixels of its type. */
+  (unsigned short)(0) height, /**< The height of the original image in pixels. */
+  (unsigned char)(1) scale, /**< Only every scale-th pixel of every scale-th row was encoded. */
+  (unsigned)(0) sequence, /**< The number of this image in its stream. */
+  (bool)(true) keyFrame, /**< Were the pixels encoded without referring to the previous image? */
+  (std::vector<unsigned char>) data, /**< The run-length encoded pixels or differences to the previous ones. Empty: repeat the previous image. */
+});
+
+class DebugImageEncoder
+{
+public:
+  static constexpr unsigned keyFrameInterval = 30; /**< Every n-th image is a key frame, so a stream recovers from lost images. */
+  static constexpr float throughputShare = 0.25f; /**< The share of the link throughput a single image stream may use. */
+  static constexpr unsigned minKeyFrameDistance = 10; /**< Requested key frames are delayed until this many images followed the previous one. */
+
+  /**
+   * Reports the state of the debug connection to all encoders.
+   * @param throughput The estimated throughput of the connection in bytes/s.
+   *                   0 if unknown.
+   * @param backlog The ratio of the outgoing queue that is still occupied (0..1).
+   */
+  static void setLinkState(float throughput, float backlog);
+
+  /**
+   * Lets the encoders encode one of the next images of a stream as a key
+   * frame. This must be called if compressed images of the stream were
+   * dropped before they were sent, because the receiver cannot decode
+   * differences to them. Since key frames are large, the request is only
+   * granted if the previous key frame of the stream is at least
+   * minKeyFrameDistance images old. Otherwise, it is delayed until then.
+   * @param id The name of the stream.
+   */
+  static void requestKeyFrame(const std::string& id);
+
+  /**
+   * Encodes the next image of a stream. If the stream would exceed its share
+   * of the throughput, the image is skipped. It is replaced by an empty
+   * difference, which tells the receiver to repeat the previous image, because
+   * debug images are only shown as long as they are sent in every frame.
+   * @param id The name of the stream.
+   * @param image The image.
+   * @param compressed The compressed image.
+   */
+  void encode(const std::string& id, const DebugImage& image, CompressedDebugImage& compressed);
+
+private:
+  /** The state of a stream of images. */
+  struct Stream
+  {
+    std::vector<unsigned char> previous; /**< The pixels encoded last. */
+    PixelTypes::PixelType type = PixelTypes::Grayscale; /**< The pixel type of the image encoded last. */
+    unsigned short width = 0; /**< The width of the image encoded last. */
+    unsigned short height = 0; /**< The height of the image encoded last. */
+    unsigned char scale = 0; /**< The scale of the image encoded last (0: none encoded yet). */
+    unsigned sequence = 0; /**< The number of the next image. */
+    unsigned lastKeyFrame = 0; /**< The number of the last key frame. */
+    unsigned timeOfLastImage = 0; /**< When was the last image encoded? */
+    std::size_t sizeOfLastImage = 0; /**< The number of bytes of the image encoded last. */
+    unsigned keyFrameRequests = 0; /**< The number of key frame requests when the last key frame was encoded. */
+  };
+
+  static std::atomic<float> throughput; /**< The estimated throughput of the debug connection in bytes/s. */
+  static std::atomic<float> backlog; /**< The ratio of the outgoing debug queue that is still occupied. */
+  static DECLARE_SYNC; /**< Protects the key frame requests. */
+  static std::unordered_map<std::string, unsigned> keyFrameRequests; /**< How often key frames were requested per stream. */
+
+  std::unordered_map<std::string, Stream> streams; /**< The streams of this thread. */
+  std::vector<unsigned char> pixels; /**< A buffer for the pixels of the current image. */
+};
+
+class DebugImageDecoder
+{
+public:
+  /**
+   * Decodes the next image of a stream.
+   * @param id The name of the stream.
+   * @param compressed The compressed image.
+   * @param image The decoded image in its original resolution.
+   * @return Could the image be decoded? Differences can only be decoded if
+   *         the previous image of the stream was decoded.
+   */
+  bool decode(const std::string& id, const CompressedDebugImage& compressed, DebugImage& image);
+
+private:
+  /** The state of a stream of images. */
+  struct Stream
+  {
+    std::vector<unsigned char> previous; /**< The pixels decoded last. */
+    unsigned nextSequence = 0; /**< The number of the image that can be decoded next. */
+    bool valid = false; /**< Can the next image be decoded if it is not a key frame? */
+  };
+
+  std::unordered_map<std::string, Stream> streams; /**< The streams received so far. */
+};
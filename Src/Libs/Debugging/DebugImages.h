@@ -89,24 +89,26 @@ public:
 
   void from(const Image<PixelTypes::YUYVPixel>& image)
   {
-    size_t size = image.width * image.height * sizeof(PixelTypes::YUYVPixel);
-    if(isReference || !data || size > maxSize)
-    {
-      if(!isReference && data)
-        Memory::alignedFree(data);
-      isReference = false;
-      data = Memory::alignedMalloc(size, 32);
-      maxSize = size;
-    }
-    width = static_cast<unsigned short>(image.width);
-    height = static_cast<unsigned short>(image.height);
-    type = PixelTypes::PixelType::YUYV;
-    memcpy(data, image[0], size);
+    allocate(PixelTypes::PixelType::YUYV, static_cast<unsigned short>(image.width), static_cast<unsigned short>(image.height));
+    memcpy(data, image[0], image.width * image.height * sizeof(PixelTypes::YUYVPixel));
   }
 
   void from(const Image<PixelTypes::GrayscaledPixel>& image)
   {
-    size_t size = image.width * image.height * sizeof(PixelTypes::GrayscaledPixel);
+    allocate(PixelTypes::PixelType::Grayscale, static_cast<unsigned short>(image.width), static_cast<unsigned short>(image.height));
+    memcpy(data, image[0], image.width * image.height * sizeof(PixelTypes::GrayscaledPixel));
+  }
+
+  /**
+   * Sets the format of this image and makes sure that it owns a buffer large
+   * enough for its pixels. The previous contents are lost.
+   * @param type The pixel type.
+   * @param width The width in pixels of the given type.
+   * @param height The height in pixels.
+   */
+  void allocate(PixelTypes::PixelType type, unsigned short width, unsigned short height)
+  {
+    const size_t size = width * height * PixelTypes::pixelSize(type);
     if(isReference || !data || size > maxSize)
     {
       if(!isReference && data)
@@ -115,10 +117,9 @@ public:
       data = Memory::alignedMalloc(size, 32);
       maxSize = size;
     }
-    width = static_cast<unsigned short>(image.width);
-    height = static_cast<unsigned short>(image.height);
-    type = PixelTypes::PixelType::Grayscale;
-    memcpy(data, image[0], size);
+    this->type = type;
+    this->width = width;
+    this->height = height;
   }
 
   unsigned short getImageWidth() const
@@ -133,20 +134,15 @@ protected:
    */
   void read(In& stream) override
   {
+    PixelTypes::PixelType type;
+    unsigned short width;
+    unsigned short height;
     STREAM(type);
     STREAM(width);
     STREAM(height);
 
-    const size_t size = width * height * PixelTypes::pixelSize(type);
-    if(isReference || !data || size > maxSize)
-    {
-      if(!isReference && data)
-        Memory::alignedFree(data);
-      isReference = false;
-      data = Memory::alignedMalloc(size, 32);
-      maxSize = size;
-    }
-    stream.read(data, size);
+    allocate(type, width, height);
+    stream.read(data, width * height * PixelTypes::pixelSize(type));
   }
 
   /**
@@ -174,6 +170,15 @@ private:
   }
 };
 
+/**
+ * Sends a debug image. On the robot, it is sent as a \c CompressedDebugImage
+ * (see DebugImageCodec.h) that adapts to the throughput of the debug connection.
+ * Use \c SEND_DEBUG_IMAGE instead of calling this function directly.
+ * @param id The name under which it is sent.
+ * @param image The image that is sent.
+ */
+void _sendDebugImage(const char* id, const DebugImage& image);
+
 /**
  * Sends the debug image.
  * @param id The name under which it is sent.
@@ -184,8 +189,8 @@ private:
   do \
     _SEND_DEBUG_IMAGE_EXPAND(_SEND_DEBUG_IMAGE_EXPAND(_SEND_DEBUG_IMAGE_THIRD(__VA_ARGS__, _SEND_DEBUG_IMAGE_WITH_METHOD, _SEND_DEBUG_IMAGE_WITHOUT_METHOD))(id, __VA_ARGS__)) \
     while(false)
-#define _SEND_DEBUG_IMAGE_WITHOUT_METHOD(id, image) DEBUG_RESPONSE("debug images:" id) OUTPUT(idDebugImage, bin, id << DebugImage(image));
-#define _SEND_DEBUG_IMAGE_WITH_METHOD(id, image, method) DEBUG_RESPONSE("debug images:" id) OUTPUT(idDebugImage, bin, id << DebugImage(image, method));
+#define _SEND_DEBUG_IMAGE_WITHOUT_METHOD(id, image) DEBUG_RESPONSE("debug images:" id) _sendDebugImage(id, DebugImage(image));
+#define _SEND_DEBUG_IMAGE_WITH_METHOD(id, image, method) DEBUG_RESPONSE("debug images:" id) _sendDebugImage(id, DebugImage(image, method));
 
 #define _SEND_DEBUG_IMAGE_THIRD(first, second, third, ...) third
 #define _SEND_DEBUG_IMAGE_EXPAND(s) s // needed for Visual Studio
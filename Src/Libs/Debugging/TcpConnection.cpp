@@ -8,6 +8,8 @@
 
 #include "TcpConnection.h"
 #include "Platform/BHAssert.h"
+#include <algorithm>
+#include <limits>
 
 void TcpConnection::connect(const char* ip, int port, Handshake handshake, int maxPacketSendSize, int maxPacketReceiveSize)
 {
@@ -31,8 +33,22 @@ void TcpConnection::connect(const char* ip, int port, Handshake handshake, int m
 
 bool TcpConnection::sendAndReceive(const unsigned char* dataToSend, int sendSize,
                                    unsigned char*& dataRead, int& readSize)
+{
+  const TcpComm::Segment segment = {dataToSend, static_cast<std::size_t>(std::max(sendSize, 0))};
+  return sendAndReceive(&segment, sendSize > 0 ? 1 : 0, dataRead, readSize);
+}
+
+bool TcpConnection::sendAndReceive(const TcpComm::Segment* segments, int numOfSegments,
+                                   unsigned char*& dataRead, int& readSize)
 {
   ASSERT(tcpComm);
+  ASSERT(numOfSegments < TcpComm::maxSegments);
+  std::size_t size = 0;
+  for(int i = 0; i < numOfSegments; ++i)
+    size += segments[i].size;
+  ASSERT(size <= static_cast<std::size_t>(std::numeric_limits<int>::max()));
+  int sendSize = static_cast<int>(size);
+
   bool connectedBefore = isConnected();
   readSize = receive(dataRead);
 
@@ -48,8 +64,11 @@ bool TcpConnection::sendAndReceive(const unsigned char* dataToSend, int sendSize
   if((handshake != receiver || ack) &&
      isConnected() && sendSize > 0)
   {
-    if(tcpComm->send(reinterpret_cast<unsigned char*>(&sendSize), sizeof(sendSize)) && // sends size of block
-       tcpComm->send(dataToSend, sendSize))                           // sends data
+    // The size of the block is sent together with the data.
+    TcpComm::Segment packet[TcpComm::maxSegments];
+    packet[0] = {&sendSize, sizeof(sendSize)};
+    std::copy(segments, segments + numOfSegments, packet + 1);
+    if(tcpComm->send(packet, numOfSegments + 1))
     {
       ack = false;
       return true;
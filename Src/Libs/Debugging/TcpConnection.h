@@ -83,12 +83,37 @@ public:
    */
   bool sendAndReceive(const unsigned char* dataToSend, int sendSize, unsigned char*& dataRead, int& readSize);
 
+  /**
+   * The function sends and receives data. The data sent is assembled from
+   * several segments that are not copied together.
+   * @param segments The segments the data to be sent consists of. The function
+   *                 will not free them.
+   * @param numOfSegments The number of segments. At most one less than
+   *                      \c TcpComm::maxSegments . If 0, no data is sent.
+   * @param dataRead If data has been read, the parameter is initialized with
+   *                 the address of a buffer pointing to that data. The
+   *                 buffer has to be freed manually.
+   * @param readSize The size of the block read. "dataRead" is only valid
+   *                 (and has to be freed) if this parameter contains a
+   *                 positive number after the call to the function.
+   * @return Returns true if the data has been sent.
+   */
+  bool sendAndReceive(const TcpComm::Segment* segments, int numOfSegments, unsigned char*& dataRead, int& readSize);
+
   /**
    * The function states whether the connection is still established.
    * @return Does the connection still exist?
    */
   bool isConnected() const { return tcpComm && tcpComm->connected(); }
 
+  /**
+   * The function states whether data sent is still waiting for the
+   * acknowledgement of the communication partner. In this case, no further
+   * data is sent.
+   * @return Is an acknowledgement pending?
+   */
+  bool isAckPending() const { return handshake == receiver && !ack; }
+
   /**
    * The function states whether this system is the client in the connection.
    * @return Is it the client?
@@ -69,6 +69,19 @@ unsigned TimingManager::stopTiming(const char* identifier)
   return diff;
 }
 
+void TimingManager::addTiming(const char* identifier, unsigned time)
+{
+  auto timing = prvt->timing.find(identifier);
+  if(timing == prvt->timing.end())
+  {
+    prvt->watchNames.push_back(identifier);
+    prvt->idTable[identifier] = static_cast<unsigned short>(prvt->idTable.size());
+    timing = prvt->timing.insert(std::pair<const char*, unsigned long long>(identifier, 0)).first;
+  }
+  prvt->dataPrepared = false;
+  timing->second += time;
+}
+
 void TimingManager::signalThreadStart()
 {
   prvt->currentThreadStartTime = Time::getCurrentSystemTime();
@@ -27,6 +27,14 @@ public:
   /** Stops the stopwatch for the specified identifier and returns the time in us. */
   unsigned stopTiming(const char* identifier);
 
+  /**
+   * Adds time spent in other threads on behalf of this one, e.g. by the task
+   * pool, to the stopwatch for the specified identifier.
+   * @param identifier The identifier. Must not be running.
+   * @param time The time in us.
+   */
+  void addTiming(const char* identifier, unsigned time);
+
   /**
    * The TimingManager has a special stopwatch that is used to keep track
    * of the overall thread time.
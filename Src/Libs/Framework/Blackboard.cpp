@@ -5,6 +5,7 @@
  */
 
 #include "Blackboard.h"
+#include "StartupTrace.h"
 #include "Platform/BHAssert.h"
 #include "Streaming/Streamable.h"
 #include <unordered_map>
@@ -38,6 +39,12 @@ const Blackboard::Entry& Blackboard::get(const char* representation) const
   return entries->find(representation)->second;
 }
 
+void Blackboard::create(const char* representation, const std::function<void()>& create)
+{
+  StartupTrace::Scope scope(StartupTrace::allocation, representation);
+  create();
+}
+
 bool Blackboard::exists(const char* representation) const
 {
   return entries->find(representation) != entries->end();
@@ -57,6 +64,13 @@ const Streamable& Blackboard::operator[](const char* representation) const
   return *entry.data;
 }
 
+std::size_t Blackboard::getSize(const char* representation) const
+{
+  const Entry& entry = get(representation);
+  ASSERT(entry.data);
+  return entry.size;
+}
+
 void Blackboard::free(const char* representation)
 {
   Entry& entry = get(representation);
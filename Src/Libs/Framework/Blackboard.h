@@ -31,6 +31,7 @@ private:
   {
     std::unique_ptr<Streamable> data; /**< The representation. */
     int counter = 0; /**< How many modules requested its existence? */
+    std::size_t size = 0; /**< The size of the representation's type in bytes. */
     std::function<void(Streamable*)> reset;
   };
 
@@ -55,6 +56,13 @@ private:
   Entry& get(const char* representation);
   const Entry& get(const char* representation) const;
 
+  /**
+   * Creates a representation and measures how long this took.
+   * @param representation The name of the representation.
+   * @param create The function that creates it.
+   */
+  static void create(const char* representation, const std::function<void()>& create);
+
 public:
   /**
    * The default constructor creates the blackboard and sets it as
@@ -88,7 +96,8 @@ public:
     Entry& entry = get(representation);
     if(entry.counter++ == 0)
     {
-      entry.data = std::make_unique<T>();
+      create(representation, [&entry] {entry.data = std::make_unique<T>();});
+      entry.size = sizeof(T);
       if(HasReadWrite::test(dynamic_cast<T*>(&*entry.data)))
         entry.reset = [](Streamable* data)
       {
@@ -127,6 +136,14 @@ public:
   Streamable& operator[](const char* representation);
   const Streamable& operator[](const char* representation) const;
 
+  /**
+   * Return the size of the type of a representation. Memory it allocates
+   * dynamically is not included. The representation must already exist.
+   * @param representation The name of the representation.
+   * @return The size in bytes.
+   */
+  std::size_t getSize(const char* representation) const;
+
   /**
    * Return the current version.
    * It can be used to determine whether the configuration of the
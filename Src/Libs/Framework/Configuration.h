@@ -36,6 +36,31 @@ STREAMABLE(Configuration,
     (std::string) provider,
   });
 
+  STREAMABLE(ProviderBudget,
+  {,
+    (std::string) representation, /**< The representation the budget applies to. */
+    (float)(0.f) budget, /**< The soft time budget for providing the representation in ms. */
+  });
+
+  STREAMABLE(FrameRate,
+  {,
+    (float)(0.f) maxBallDistance, /**< The rate only applies if the ball was seen recently and is closer than this (in mm, 0 = always). */
+    (float)(0.f) rate, /**< The number of images per second to process (0 = all). */
+  });
+
+  /**
+   * Cognition waits for new images from both camera threads unless one of
+   * them is at least 100 ms late. A camera thread that limits its rate
+   * announces when it will process its next image, so Cognition does not wait
+   * for the images it skips. However, images skipped because of the deadline
+   * cannot be predicted and delay the images of the other camera thread.
+   */
+  STREAMABLE(FrameSchedule,
+  {,
+    (std::vector<FrameRate>) rates, /**< The target rates of a camera thread. The first one that applies is used (none = all images). */
+    (unsigned)(0) deadline, /**< Images older than this when their processing would start are skipped (in ms, 0 = none). */
+  });
+
   STREAMABLE(Thread,
   {
     /**
@@ -55,6 +80,9 @@ STREAMABLE(Configuration,
     (unsigned)(0) debugSenderInfrastructureSize,
     (std::string) executionUnit,
     (std::vector<RepresentationProvider>) representationProviders,
+    (float)(0.f) frameBudget, /**< The soft time budget of a whole frame in ms (0 = none). */
+    (std::vector<ProviderBudget>) budgets, /**< Soft time budgets of individual providers. */
+    (FrameSchedule) frameSchedule, /**< Which images a camera thread processes. */
   });
 
   /**
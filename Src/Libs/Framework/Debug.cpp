@@ -8,6 +8,7 @@
  */
 
 #include "Debug.h"
+#include "Debugging/DebugImageCodec.h"
 #include "Debugging/Debugging.h"
 #include "Platform/Time.h"
 #include "Streaming/TypeInfo.h"
@@ -172,9 +173,14 @@ bool Debug::main()
 #endif // NDEBUG
 #endif // !TARGET_ROBOT
 
-  // If there is still data to be sent, immediately start a new cycle.
+  // If there is still data that can be sent, immediately start a new cycle.
   // Otherwise, wait for the next packet to arrive.
+#ifdef TARGET_ROBOT
+  // On the robot, the data waits in the queue until the PC acknowledged the previous packet.
+  if(debugSender->size() > 0 && debugHandler.canSend())
+#else
   if(debugSender->size() > 0)
+#endif
   {
     Thread::yield();
     return false;
@@ -188,6 +194,9 @@ void Debug::removeRepetitions()
   std::unordered_map<std::string, std::array<size_t, numOfMessageIDs>> threads;
   std::string thread = "unknown";
 
+  std::unordered_map<std::string, size_t> imagesPerStream;
+  std::string id;
+
   size_t* messagesPerType = threads[thread].data();
   for(MessageQueue::Message message : *debugSender)
   {
@@ -196,10 +205,16 @@ void Debug::removeRepetitions()
       message.bin() >> thread;
       messagesPerType = threads[thread].data();
     }
+    else if(message.id() == idDebugImageCompressed)
+    {
+      message.bin() >> id;
+      ++imagesPerStream[thread + ":" + id];
+    }
     ++messagesPerType[message.id()];
   }
 
-  messagesPerType = threads["unknown"].data();
+  thread = "unknown";
+  messagesPerType = threads[thread].data();
   size_t originalSize = 0;
   size_t sizeAfterFrameBegin = 0;
 
@@ -241,6 +256,18 @@ void Debug::removeRepetitions()
       case idThread:
         return true;
 
+      // only the latest image per stream, the receiver cannot decode differences to dropped images
+      case idDebugImageCompressed:
+      {
+        message.bin() >> id;
+        size_t& images = imagesPerStream[thread + ":" + id];
+        if(--images == 0)
+          return true;
+        if(images == 1) // request once per stream
+          DebugImageEncoder::requestKeyFrame(id);
+        return false;
+      }
+
       // only the latest messages for infrastructure
       default:
         if(message.id() >= numOfDataMessageIDs)
@@ -8,10 +8,10 @@
 
 #ifdef TARGET_ROBOT
 #include "DebugHandler.h"
-#include "Platform/BHAssert.h"
+#include "Debugging/DebugImageCodec.h"
+#include "Platform/Time.h"
 #include "Streaming/InStreams.h"
-#include "Streaming/OutStreams.h"
-#include <limits>
+#include <algorithm>
 
 DebugHandler::DebugHandler(MessageQueue& in, MessageQueue& out, int maxPacketSendSize, int maxPacketReceiveSize) :
   TcpConnection(0, 9999, TcpConnection::receiver, maxPacketSendSize, maxPacketReceiveSize),
@@ -21,25 +21,46 @@ DebugHandler::DebugHandler(MessageQueue& in, MessageQueue& out, int maxPacketSen
 
 void DebugHandler::communicate(bool send)
 {
-  if(send && !sendData && !out.empty())
-  {
-    sendSize = out.size() + 8;
-    OutBinaryMemory memory(sendSize);
-    memory << out;
-    sendData = reinterpret_cast<unsigned char*>(memory.obtainData());
-    out.clear();
-  }
+  // The queue is sent from its own buffer, preceded by the header that streaming it would write.
+  const MessageQueue::QueueHeader header = out.getHeader();
+  const TcpComm::Segment segments[] = {{&header, sizeof(header)}, {out.data(), out.size()}};
+  const bool sending = send && !out.empty();
 
   unsigned char* receivedData;
   int receivedSize = 0;
 
-  ASSERT(sendSize <= std::numeric_limits<int>::max());
-  if(sendAndReceive(sendData, static_cast<int>(sendSize), receivedData, receivedSize) && sendSize)
+  // The time since the previous call only counts if the link was in use, i.e. if
+  // an acknowledgement was pending or data was waiting to be sent. Otherwise, a
+  // link that is faster than the data produced would look slow.
+  const unsigned now = Time::getRealSystemTime();
+  if(busy)
+    busyTime += now - timeOfLastCall;
+  timeOfLastCall = now;
+
+  const int bytesSentBefore = getOverallBytesSent();
+  const bool sent = sendAndReceive(segments, sending ? 2 : 0, receivedData, receivedSize) && sending;
+  if(sent)
+    out.clear();
+
+  // A new packet is only sent after the previous one was acknowledged.
+  if(unacknowledgedBytes > 0 && (sent || !isAckPending()))
+  {
+    acknowledgedBytes += unacknowledgedBytes;
+    unacknowledgedBytes = 0;
+  }
+  if(sent)
+    unacknowledgedBytes = getOverallBytesSent() - bytesSentBefore;
+  busy = isAckPending() || !out.empty();
+
+  if(Time::getRealTimeSince(timeOfLastEstimate) >= 1000)
   {
-    delete [] sendData;
-    sendData = nullptr;
-    sendSize = 0;
+    if(acknowledgedBytes > 0)
+      throughput = static_cast<float>(acknowledgedBytes) * 1000.f / static_cast<float>(std::max(busyTime, 1u));
+    timeOfLastEstimate = now;
+    busyTime = 0;
+    acknowledgedBytes = 0;
   }
+  DebugImageEncoder::setLinkState(throughput, out.getMaxCapacity() ? static_cast<float>(out.size()) / static_cast<float>(out.getMaxCapacity()) : 0.f);
 
   if(receivedSize > 0)
   {
@@ -16,10 +16,15 @@ class DebugHandler : TcpConnection
 {
 private:
   MessageQueue& in; /**< Incoming debug data is stored here. */
-  MessageQueue& out; /**< Outgoing debug data is stored here. */
+  MessageQueue& out; /**< Outgoing debug data is stored here. It is sent directly from this queue. */
 
-  unsigned char* sendData = nullptr; /**< The data to send next. */
-  size_t sendSize = 0; /**< The size of the data to send next. */
+  unsigned timeOfLastEstimate = 0; /**< When was the throughput estimated last? */
+  unsigned timeOfLastCall = 0; /**< When was communicate called last? */
+  bool busy = false; /**< Was the link in use after the last call, i.e. was data waiting to be sent or acknowledged? */
+  unsigned busyTime = 0; /**< The real time the link was in use since the last estimate (in ms). */
+  int unacknowledgedBytes = 0; /**< The number of bytes sent that the PC has not acknowledged yet. */
+  int acknowledgedBytes = 0; /**< The number of bytes the PC acknowledged since the last estimate. */
+  float throughput = 0.f; /**< The estimated throughput of the connection in bytes/s (0: unknown). */
 
 public:
   /**
@@ -32,16 +37,20 @@ public:
    */
   DebugHandler(MessageQueue& in, MessageQueue& out, int maxPacketSendSize = 0, int maxPacketReceiveSize = 0);
 
-  /**
-   * Delete buffered packet if needed.
-   */
-  ~DebugHandler() {if(sendData) delete [] sendData;}
-
   /**
    * The method performs the communication.
-   * It has to be called at the end of each frame.
+   * It has to be called at the end of each frame. The outgoing queue is
+   * only cleared after it was sent. Until then, new messages are appended
+   * to it and are sent together with the older ones.
    * @param send Send outgoing queue?
    */
   void communicate(bool send);
+
+  /**
+   * The method states whether the outgoing queue would be sent by the next
+   * call to communicate, i.e. whether calling it again immediately makes sense.
+   * @return Is the PC connected and not waiting for an acknowledgement?
+   */
+  bool canSend() const {return isConnected() && !isAckPending();}
 };
 #endif
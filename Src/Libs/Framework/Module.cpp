@@ -5,6 +5,7 @@
  */
 
 #include "Module.h"
+#include "StartupTrace.h"
 #include "Streaming/InStreams.h"
 
 ModuleBase* ModuleBase::first = nullptr;
@@ -25,6 +26,7 @@ void loadModuleParameters(Streamable& parameters, const char* moduleName, const
     name = fileName;
   if(prefix)
     name = prefix + name;
+  StartupTrace::Scope scope(StartupTrace::parameters, name.c_str());
   InMapFile stream(name);
   ASSERT(stream.exists());
   stream >> parameters;
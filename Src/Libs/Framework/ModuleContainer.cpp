@@ -25,7 +25,7 @@ ModuleContainer::ModuleContainer(const Settings& settings, const std::string& ro
   ThreadFrame(settings, robotName),
   name(config()[index].name),
   priority(config()[index].priority),
-  moduleGraphRunner(config().size()),
+  moduleGraphRunner(config),
   logger(logger)
 {
   for(ExecutionUnitCreatorBase* i = ExecutionUnitCreatorBase::first; i; i = i->next)
@@ -11,6 +11,7 @@
 #include "Streaming/TypeInfo.h"
 
 #include <algorithm>
+#include <cstring>
 #include <map>
 #include <unordered_map>
 
@@ -272,8 +273,10 @@ bool ModuleGraphCreator::calcShared(const Configuration& config, std::size_t ind
 
 bool ModuleGraphCreator::update(In& stream)
 {
-  for(std::list<Provider>& providerList : providers)
-    providerList.clear();
+  // Remember what the current providers were calculated from.
+  const bool wasValid = valid;
+  valid = false;
+  const std::vector<std::vector<std::vector<const char*>>> prevReceived = received;
 
   for(auto& thread : sent)
     for(std::vector<const char*>& s : thread)
@@ -310,18 +313,27 @@ bool ModuleGraphCreator::update(In& stream)
   if(!calcShared(config))
     return false;
 
+  // Only threads affected by the changes are calculated again.
+  std::vector<bool> affected(config().size(), true);
+  if(wasValid && prevConfig().size() == config().size() && prevConfig.defaultRepresentations == config.defaultRepresentations)
+    for(std::size_t j = 0; j < config().size(); j++)
+      affected[j] = isAffected(prevConfig, prevReceived[j], j);
+
   // Fill the list of all providers
   for(std::size_t j = 0; j < config().size(); j++)
   {
+    if(affected[j])
+      providers[j].clear();
     for(const auto& rp : config()[j].representationProviders)
     {
       auto module = modules.find(rp.provider);
-      for(const ModuleBase::Info& i : module->second->getModuleInfo())
-        if(i.update && rp.representation == i.representation)
-        {
-          providers[j].emplace_back(i.representation, module->second);
-          break;
-        }
+      if(affected[j])
+        for(const ModuleBase::Info& i : module->second->getModuleInfo())
+          if(i.update && rp.representation == i.representation)
+          {
+            providers[j].emplace_back(i.representation, module->second);
+            break;
+          }
       int index = static_cast<int>(std::distance(modules.begin(), module));
       required[j][index] = true;
     }
@@ -340,7 +352,7 @@ bool ModuleGraphCreator::update(In& stream)
   // Sort providers
   for(std::size_t i = 0; i < providers.size(); i++)
   {
-    if(!sortProviders(providedByDefault, i))
+    if(affected[i] && !sortProviders(providedByDefault, i))
       return false;
   }
 
@@ -374,9 +386,34 @@ bool ModuleGraphCreator::update(In& stream)
       }
     }
   }
+  valid = true;
   return true;
 }
 
+bool ModuleGraphCreator::isAffected(const Configuration& prevConfig, const std::vector<std::vector<const char*>>& prevReceived,
+                                    std::size_t index) const
+{
+  const std::vector<Configuration::RepresentationProvider>& prevProviders = prevConfig()[index].representationProviders;
+  const std::vector<Configuration::RepresentationProvider>& currentProviders = config()[index].representationProviders;
+  if(prevConfig()[index].name != config()[index].name || prevProviders.size() != currentProviders.size())
+    return true;
+  for(std::size_t i = 0; i < prevProviders.size(); ++i)
+    if(prevProviders[i].representation != currentProviders[i].representation
+       || prevProviders[i].provider != currentProviders[i].provider)
+      return true;
+
+  // Representations received from other threads do not need to be provided in this thread.
+  const std::vector<std::vector<const char*>>& currentReceived = received[index];
+  if(prevReceived.size() != currentReceived.size())
+    return true;
+  for(std::size_t thread = 0; thread < prevReceived.size(); ++thread)
+    if(!std::equal(prevReceived[thread].begin(), prevReceived[thread].end(),
+                   currentReceived[thread].begin(), currentReceived[thread].end(),
+                   [](const char* a, const char* b) {return !std::strcmp(a, b);}))
+      return true;
+  return false;
+}
+
 bool ModuleGraphCreator::sortProviders(const std::vector<std::string>& providedByDefault, std::size_t index)
 {
   // Collect all representations already provided by default or by other threads.
@@ -466,8 +503,11 @@ bool ModuleGraphCreator::topologicalSort(const char* threadName, Node* node, std
 
 ModuleGraphCreator::ExecutionValues::ExecutionValues(std::vector<std::vector<const char*>>& received, std::vector<std::vector<const char*>>& sent,
                                                      std::vector<std::string>& representationsToReset, std::vector<ModuleRequired>& modules,
-                                                     std::vector<Configuration::RepresentationProvider>& providers) :
-  representationsToReset(representationsToReset), modules(modules), providers(providers)
+                                                     std::vector<Configuration::RepresentationProvider>& providers, float frameBudget,
+                                                     const std::vector<Configuration::ProviderBudget>& budgets,
+                                                     const Configuration::FrameSchedule& frameSchedule) :
+  representationsToReset(representationsToReset), modules(modules), providers(providers), frameBudget(frameBudget), budgets(budgets),
+  frameSchedule(frameSchedule)
 {
   ASSERT(received.size() == sent.size());
   for(std::size_t i = 0; i < received.size(); i++)
@@ -491,5 +531,6 @@ const ModuleGraphCreator::ExecutionValues ModuleGraphCreator::getExecutionValues
   for(const Provider& provider : providers[index])
     providerList.emplace_back(provider.representation, provider.moduleBase->name);
 
-  return ExecutionValues(received[index], sent[index], representationsToReset, modulesRequired, providerList);
+  return ExecutionValues(received[index], sent[index], representationsToReset, modulesRequired, providerList,
+                         config()[index].frameBudget, config()[index].budgets, config()[index].frameSchedule);
 }
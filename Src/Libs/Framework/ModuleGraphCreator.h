@@ -75,6 +75,7 @@ private:
   std::vector<std::vector<std::vector<const char*>>> sent; /**< The list of all names of representations sent to other threads */
   std::vector<std::list<Provider>> providers; /**< The list of providers of each thread that will be executed. */
   std::vector<std::string> representationsToReset; /**< The list of all representations that must be reset. */
+  bool valid = false; /**< Was the last configuration valid, i.e. do the providers belong to it? */
 
 public:
   /**
@@ -84,7 +85,9 @@ public:
   ModuleGraphCreator(const Configuration& config);
 
   /**
-   * The function calculates all new module configurations.
+   * The function calculates all new module configurations. The providers of
+   * threads whose configuration and received representations did not change
+   * are not sorted again.
    * @param stream The stream the new configuration is read from.
    * @return Whether a valid module configuration is present.
    */
@@ -124,6 +127,16 @@ private:
                   const std::string& representation, const ModuleBase* module,
                   std::vector<std::vector<const char*>>& received) const;
 
+  /**
+   * Checks whether a thread must be calculated again.
+   * @param prevConfig The previous configuration.
+   * @param prevReceived The representations the thread received with the previous configuration.
+   * @param index The index of the thread.
+   * @return Did anything change that the providers of the thread depend on?
+   */
+  bool isAffected(const Configuration& prevConfig, const std::vector<std::vector<const char*>>& prevReceived,
+                  std::size_t index) const;
+
   /**
    * The function brings the providers in the correct sequence.
    * @param providedByDefault Representations and possible aliases provided by "default".
@@ -164,13 +177,18 @@ public: // Passing data to the public:
     ExecutionValues() = default;
     ExecutionValues(std::vector<std::vector<const char*>>& received,  std::vector<std::vector<const char*>>& sent,
                     std::vector<std::string>& representationsToReset, std::vector<ModuleRequired>& modules,
-                    std::vector<Configuration::RepresentationProvider>& providers),
+                    std::vector<Configuration::RepresentationProvider>& providers, float frameBudget,
+                    const std::vector<Configuration::ProviderBudget>& budgets,
+                    const Configuration::FrameSchedule& frameSchedule),
 
     (std::vector<StringVector>) received, /**< Which data is received from which thread. */
     (std::vector<StringVector>) sent, /**< Which data is sent to which thread. */
     (std::vector<std::string>) representationsToReset, /**< All representations that must be reset. */
     (std::vector<ModuleRequired>) modules, /**< All available modules and whether they need to be executed. */
     (std::vector<Configuration::RepresentationProvider>) providers, /**< All active modules and the order in which they must be executed. */
+    (float)(0.f) frameBudget, /**< The soft time budget of a whole frame in ms (0 = none). */
+    (std::vector<Configuration::ProviderBudget>) budgets, /**< Soft time budgets of individual providers. */
+    (Configuration::FrameSchedule) frameSchedule, /**< Which images a camera thread processes. */
   });
 
   /**
@@ -8,9 +8,14 @@
  */
 
 #include "ModuleGraphRunner.h"
-#ifdef TARGET_ROBOT
+#include "Debugging/Debugging.h"
+#include "StartupTrace.h"
 #include "Platform/Time.h"
-#endif
+#include "Streaming/InStreams.h"
+#include "Streaming/OutStreams.h"
+#include <algorithm>
+#include <array>
+#include <limits>
 
 thread_local ModuleGraphRunner* ModuleGraphRunner::instance = nullptr;
 
@@ -30,13 +35,21 @@ void ModuleGraphRunner::destroy()
 
 void ModuleGraphRunner::update(In& stream)
 {
-  providers.clear();
+  // Providers that did not change keep their recent durations.
+  std::unordered_map<void (*)(Streamable&), Provider*> previousProviders;
+  std::list<Provider> previous;
+  previous.swap(providers);
+  for(Provider& p : previous)
+    previousProviders.emplace(p.update, &p);
   representationProviders.clear();
 
   ModuleGraphCreator::ExecutionValues values;
   stream >> values;
   received = values.received;
   sent = values.sent;
+  frameBudget = values.frameBudget;
+  frameSchedule = values.frameSchedule;
+  framesSinceBudgetCheck = 0;
 
   // Adds available modules and updates if they are needed
   for(const auto& module : values.modules)
@@ -60,7 +73,13 @@ void ModuleGraphRunner::update(In& stream)
       if(i.update && rp.representation == i.representation)
       {
         providers.emplace_back(i.representation, &m->second, i.update);
+        const auto previousProvider = previousProviders.find(i.update);
+        if(previousProvider != previousProviders.end() && previousProvider->second->moduleState == &m->second)
+          providers.back().durations = previousProvider->second->durations;
         representationProviders[i.representation] = rp.provider;
+        for(const Configuration::ProviderBudget& budget : values.budgets)
+          if(budget.representation == rp.representation)
+            providers.back().budget = budget.budget;
         break;
       }
   }
@@ -82,6 +101,7 @@ void ModuleGraphRunner::update(In& stream)
   }
 
   validConfiguration = true;
+  ++version;
   stream >> nextTimestamp; // Use this timestamp after execute was called
   this->timestamp = 0; // Invalid until execute was called
 }
@@ -89,18 +109,27 @@ void ModuleGraphRunner::update(In& stream)
 void ModuleGraphRunner::execute()
 {
   instance = this;
+  StartupTrace::enable();
+  frameStart = Time::getRealTimeInMicroseconds();
+  unsigned long long providerStart = Time::getCurrentThreadTime();
 
   // Execute all providers in the given sequence
   for(Provider& p : providers)
   {
     ASSERT(p.moduleState->required);
     if(!p.moduleState->instance)
+    {
+      StartupTrace::Scope scope(StartupTrace::construction, p.moduleState->module->name);
       p.moduleState->instance = p.moduleState->module->createNew();
+    }
 #ifdef TARGET_ROBOT
     unsigned timestamp = Time::getCurrentSystemTime();
 #endif
     if(p.moduleState->instance)
       p.update(*p.moduleState->instance);
+    const unsigned long long providerEnd = Time::getCurrentThreadTime();
+    p.durations.push_front(static_cast<float>(providerEnd - providerStart) / 1000.f);
+    providerStart = providerEnd;
 #ifdef TARGET_ROBOT
     int duration = Time::getTimeSince(timestamp);
     if(timestamp > 110000 &&
@@ -115,6 +144,32 @@ void ModuleGraphRunner::execute()
   }
   BH_TRACE;
 
+  // Report where the time went if modules were initialized in this frame.
+  StartupTrace::report();
+
+  if(++framesSinceBudgetCheck >= durationWindow)
+  {
+    framesSinceBudgetCheck = 0;
+    checkBudgets();
+  }
+
+  DEBUG_RESPONSE("module:ModuleGraphRunner:durations")
+    for(const Provider& p : providers)
+      OUTPUT_TEXT(p.representation << ": 50% " << getPercentile(p, 0.5f) << " ms, 90% " << getPercentile(p, 0.9f)
+                  << " ms, 99% " << getPercentile(p, 0.99f) << " ms, budget " << p.budget << " ms");
+
+  DEBUG_RESPONSE("module:ModuleGraphRunner:sizes")
+    reportSizes();
+
+  const bool accountedTransfers = accountTransfers;
+  accountTransfers = false;
+  DEBUG_RESPONSE("module:ModuleGraphRunner:transfers")
+  {
+    if(accountedTransfers)
+      reportTransfers();
+    accountTransfers = true;
+  }
+
   if(!timestamp) // Configuration changed recently?
   {
     // all representations must be constructed now, so we can receive data
@@ -123,33 +178,140 @@ void ModuleGraphRunner::execute()
       s.clear();
     for(std::size_t i = 0; i < sent.size(); i++)
       for(const std::string& s : sent[i].vector)
-        toSend[i].emplace_back(&Blackboard::getInstance()[s.c_str()]);
+        toSend[i].emplace_back(&Blackboard::getInstance()[s.c_str()], s);
 
     for(auto& r : toReceive)
       r.clear();
     for(std::size_t i = 0; i < received.size(); i++)
       for(const std::string& r : received[i].vector)
-        toReceive[i].emplace_back(&Blackboard::getInstance()[r.c_str()]);
+        toReceive[i].emplace_back(&Blackboard::getInstance()[r.c_str()], r);
   }
 }
 
+float ModuleGraphRunner::getRemainingBudget()
+{
+  if(!instance || instance->frameBudget <= 0.f)
+    return std::numeric_limits<float>::max();
+  return instance->frameBudget - static_cast<float>(Time::getRealTimeInMicroseconds() - instance->frameStart) / 1000.f;
+}
+
+void ModuleGraphRunner::checkBudgets() const
+{
+  for(const Provider& p : providers)
+    if(p.budget > 0.f && p.durations.full())
+    {
+      const float duration = getPercentile(p, reportedPercentile);
+      if(duration > p.budget)
+        OUTPUT_WARNING("BUDGET: providing " << p.representation << " took " << duration << " ms in "
+                       << static_cast<int>(reportedPercentile * 100.f) << "% of the last " << static_cast<unsigned>(durationWindow)
+                       << " frames, but its budget is " << p.budget << " ms");
+    }
+}
+
+float ModuleGraphRunner::getPercentile(const Provider& provider, float percentile)
+{
+  if(provider.durations.empty())
+    return 0.f;
+  std::array<float, durationWindow> durations;
+  std::copy(provider.durations.begin(), provider.durations.end(), durations.begin());
+  const auto end = durations.begin() + provider.durations.size();
+  const auto nth = durations.begin() + std::min(static_cast<std::size_t>(percentile * static_cast<float>(provider.durations.size())),
+                                                provider.durations.size() - 1);
+  std::nth_element(durations.begin(), nth, end);
+  return *nth;
+}
+
+void ModuleGraphRunner::reportSizes() const
+{
+  std::size_t total = 0;
+  for(const Provider& p : providers)
+  {
+    const std::size_t size = Blackboard::getInstance().getSize(p.representation);
+    total += size;
+    OUTPUT_TEXT(p.representation << ": " << static_cast<unsigned>(size) << " bytes");
+  }
+  OUTPUT_TEXT("All representations provided: " << static_cast<unsigned>(total) << " bytes");
+}
+
+void ModuleGraphRunner::reportTransfers()
+{
+  const auto report = [](std::vector<Transfer>& transfers, const std::string& direction)
+  {
+    std::size_t totalBytes = 0;
+    double totalDuration = 0.0;
+    for(Transfer& t : transfers)
+    {
+      const double duration = t.count ? static_cast<double>(t.totalDuration) / t.count / 1000.0 : 0.0;
+      totalBytes += t.bytes;
+      totalDuration += duration;
+      OUTPUT_TEXT("  " << t.representation << ": " << static_cast<unsigned>(Blackboard::getInstance().getSize(t.representation.c_str()))
+                  << " bytes in memory, " << static_cast<unsigned>(t.bytes) << " bytes streamed, " << duration << " ms");
+      t.totalDuration = 0;
+      t.count = 0;
+    }
+    OUTPUT_TEXT(direction << ": " << static_cast<unsigned>(totalBytes) << " bytes and " << totalDuration << " ms per packet");
+  };
+
+  for(std::size_t i = 0; i < toSend.size(); ++i)
+    if(!toSend[i].empty())
+      report(toSend[i], "Sent to " + threadNames[i]);
+  for(std::size_t i = 0; i < toReceive.size(); ++i)
+    if(!toReceive[i].empty())
+      report(toReceive[i], "Received from " + threadNames[i]);
+}
+
+void ModuleGraphRunner::account(Transfer& transfer, unsigned long long start, std::size_t bytes)
+{
+  transfer.bytes = bytes;
+  transfer.totalDuration += Time::getCurrentThreadTime() - start;
+  ++transfer.count;
+}
+
 void ModuleGraphRunner::readPacket(In& stream, const std::size_t index)
 {
   unsigned timestamp;
-  stream >> timestamp;
+  stream >> timestamp >> nextFrameTimes[index];
   // Communication is only possible if both sides are based on the same module request.
   if(timestamp == this->timestamp)
-    for(Streamable* s : toReceive[index])
-      stream >> *s;
+  {
+    const PhysicalInStream* physicalStream = accountTransfers ? dynamic_cast<const PhysicalInStream*>(&stream) : nullptr;
+    if(physicalStream)
+      for(Transfer& r : toReceive[index])
+      {
+        const std::size_t position = physicalStream->getPosition();
+        const unsigned long long start = Time::getCurrentThreadTime();
+        stream >> *r.data;
+        account(r, start, physicalStream->getPosition() - position);
+      }
+    else
+      for(Transfer& r : toReceive[index])
+        stream >> *r.data;
+  }
   else
     stream.skip(10000000); // skip everything
 }
 
-void ModuleGraphRunner::writePacket(Out& stream, const std::size_t index) const
+void ModuleGraphRunner::writePacket(Out& stream, const std::size_t index)
+{
+  stream << timestamp << nextFrameTime;
+  const OutMemory* memoryStream = accountTransfers ? dynamic_cast<const OutMemory*>(&stream) : nullptr;
+  if(memoryStream)
+    for(Transfer& s : toSend[index])
+    {
+      const std::size_t size = memoryStream->size();
+      const unsigned long long start = Time::getCurrentThreadTime();
+      stream << *s.data;
+      account(s, start, memoryStream->size() - size);
+    }
+  else
+    for(const Transfer& s : toSend[index])
+      stream << *s.data;
+}
+
+unsigned ModuleGraphRunner::getNextFrameTime(const std::string& threadName) const
 {
-  stream << timestamp;
-  for(const Streamable* s : toSend[index])
-    stream << *s;
+  const auto thread = std::find(threadNames.begin(), threadNames.end(), threadName);
+  return thread == threadNames.end() ? 0 : nextFrameTimes[thread - threadNames.begin()];
 }
 
 const std::string& ModuleGraphRunner::getProvider(const std::string& representation) const
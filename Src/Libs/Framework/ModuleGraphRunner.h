@@ -11,6 +11,7 @@
 
 #include "Framework/Configuration.h"
 #include "Framework/ModuleGraphCreator.h"
+#include "MathBase/RingBuffer.h"
 
 #include <vector>
 
@@ -25,6 +26,9 @@ class Out;
 class ModuleGraphRunner
 {
 private:
+  static constexpr std::size_t durationWindow = 100; /**< The number of frames over which the durations of providers are tracked. */
+  static constexpr float reportedPercentile = 0.9f; /**< Budget overruns are reported if this percentile of the durations exceeds the budget. */
+
   /**
    * The class represents the current state of a module.
    */
@@ -51,6 +55,8 @@ private:
     const char* representation; /**< The representation that will be provided. */
     ModuleState* moduleState; /**< The moduleState that will give access to the module that provides the information. */
     void (*update)(Streamable&); /**< The update handler within the module. */
+    float budget = 0.f; /**< The soft time budget for providing the representation in ms (0 = none). */
+    RingBuffer<float, durationWindow> durations; /**< The most recent durations of providing the representation in ms. */
 
     /**
      * Constructor.
@@ -63,6 +69,27 @@ private:
     {}
   };
 
+  /**
+   * The class represents a representation exchanged with another thread and
+   * the costs of exchanging it.
+   */
+  class Transfer
+  {
+  public:
+    Streamable* data; /**< The representation in the blackboard. */
+    std::string representation; /**< The name of the representation. */
+    std::size_t bytes = 0; /**< The number of bytes it was streamed to the last time. */
+    unsigned long long totalDuration = 0; /**< The accumulated time of streaming it in µs. */
+    unsigned count = 0; /**< How often it was streamed since the costs are measured? */
+
+    /**
+     * Constructor.
+     * @param data The representation in the blackboard.
+     * @param representation The name of the representation.
+     */
+    Transfer(Streamable* data, const std::string& representation) : data(data), representation(representation) {}
+  };
+
   thread_local static ModuleGraphRunner* instance; /**< The only instance of this class in the thread. */
   std::unordered_map<std::string, ModuleBase*> allModules; /**< A map of all modules for quick access via name. */
   bool validConfiguration = false;
@@ -73,19 +100,63 @@ private:
 
   std::list<Provider> providers; /**< The list of providers that will be executed. */
   std::unordered_map<std::string, std::string> representationProviders; /**< Which representation is provided by which provider? */
-  std::vector<std::vector<Streamable*>> toReceive; /**< The list of all representations received from other threads. */
-  std::vector<std::vector<Streamable*>> toSend; /**< The list of all representations sent to other threads. */
+  std::vector<std::string> threadNames; /**< The names of all threads by their index. */
+  std::vector<std::vector<Transfer>> toReceive; /**< The list of all representations received from other threads. */
+  std::vector<std::vector<Transfer>> toSend; /**< The list of all representations sent to other threads. */
+  bool accountTransfers = false; /**< Are the costs of exchanging representations with other threads measured? */
 
+  int version = 0; /**< A version that is increased with each configuration change. */
   unsigned timestamp = 0; /**< The timestamp of the last module request. Communication is only possible if both sides use the same timestamp. */
   unsigned nextTimestamp = 0; /**< The next timestamp used to verify communication. */
 
+  float frameBudget = 0.f; /**< The soft time budget of a whole frame in ms (0 = none). */
+  unsigned long long frameStart = 0; /**< The real time when the current frame started (in µs). */
+  std::size_t framesSinceBudgetCheck = 0; /**< The number of frames executed since budget overruns were checked. */
+  Configuration::FrameSchedule frameSchedule; /**< Which images the thread processes if it is a camera thread. */
+  unsigned nextFrameTime = 0; /**< No frame of this thread will have an older timestamp than this (0 = unknown). It is sent with every packet. */
+  std::vector<unsigned> nextFrameTimes; /**< The next frame times received from the other threads by their index. */
+
+  /**
+   * Reports all providers whose durations exceed their budgets.
+   */
+  void checkBudgets() const;
+
+  /**
+   * Determines a percentile of the durations of a provider.
+   * @param provider The provider.
+   * @param percentile The percentile in [0..1].
+   * @return The duration in ms below which the given share of the recorded durations lies.
+   */
+  static float getPercentile(const Provider& provider, float percentile);
+
+  /**
+   * Outputs the memory footprint of all representations provided.
+   */
+  void reportSizes() const;
+
+  /**
+   * Outputs the costs of exchanging representations with other threads and
+   * resets the measurements.
+   */
+  void reportTransfers();
+
+  /**
+   * Measures streaming a representation.
+   * @param transfer The representation exchanged.
+   * @param start The thread time when streaming started (in µs).
+   * @param bytes The number of bytes streamed.
+   */
+  static void account(Transfer& transfer, unsigned long long start, std::size_t bytes);
+
 public:
   /**
    * The constructor.
-   * @param numberOfThreads The number of threads.
+   * @param config The configuration of all threads.
    */
-  ModuleGraphRunner(size_t numberOfThreads) : toReceive(numberOfThreads), toSend(numberOfThreads)
+  ModuleGraphRunner(const Configuration& config) : toReceive(config().size()), toSend(config().size()), nextFrameTimes(config().size())
   {
+    for(const Configuration::Thread& thread : config())
+      threadNames.emplace_back(thread.name);
     instance = this;
     for(ModuleBase* i = ModuleBase::first; i; i = i->next)
       allModules.emplace(i->name, i);
@@ -104,6 +175,38 @@ public:
   /** @return The only instance of this class in this thread. */
   static ModuleGraphRunner& getInstance() {return *instance;}
 
+  /**
+   * Returns how much of the time budget of the current frame is left. Modules can
+   * use this to reduce their work if the thread is running late. The time is
+   * measured as the real time since the first provider was executed, i.e. it also
+   * includes the time the thread was preempted.
+   * @return The remaining time in ms. It is negative if the budget is already
+   *         exceeded and float::max if the thread has no frame budget.
+   */
+  static float getRemainingBudget();
+
+  /**
+   * Returns which images the thread processes if it is a camera thread.
+   * @return The schedule from the configuration of the thread.
+   */
+  const Configuration::FrameSchedule& getFrameSchedule() const {return frameSchedule;}
+
+  /**
+   * Announces to the threads this one sends packets to that its next frame
+   * will not have an older timestamp than the given one, e.g. because a camera
+   * thread skips images to keep its target rate. Thereby, the receivers need
+   * not wait for frames that will not come.
+   * @param time The earliest timestamp of the next frame (0 = unknown).
+   */
+  void setNextFrameTime(unsigned time) {nextFrameTime = time;}
+
+  /**
+   * Returns the earliest timestamp of the next frame another thread announced.
+   * @param threadName The name of the other thread.
+   * @return The timestamp or 0 if it is unknown.
+   */
+  unsigned getNextFrameTime(const std::string& threadName) const;
+
   /**
    * Returns whether a valid module configuration is present.
    * @return Whether a valid module configuration is present.
@@ -117,6 +220,14 @@ public:
    */
   bool hasChanged() const { return !timestamp; }
 
+  /**
+   * Returns the current version. It can be used to determine whether the
+   * module configuration changed, e.g. which module provides which
+   * representation.
+   * @return The current version. It starts with 0.
+   */
+  int getVersion() const { return version; }
+
   /**
    * The function destroys all modules. It can be called to destroy the modules
    * before the destructor is called.
@@ -147,7 +258,7 @@ public:
    *               to another thread.
    * @param index The index of the thread this packet is for.
    */
-  void writePacket(Out& stream, const std::size_t index) const;
+  void writePacket(Out& stream, const std::size_t index);
 
   /**
    * The function checks whether no data would be received in a packet from a
@@ -0,0 +1,151 @@
+/**
+ * @file StartupTrace.cpp
+ *
+ * This file implements a class that measures where the time goes when the
+ * modules of a thread are initialized.
+ */
+
+#include "StartupTrace.h"
+#include "Debugging/Debugging.h"
+#include "Platform/Thread.h"
+#include "Platform/Time.h"
+#include <algorithm>
+#include <array>
+#include <cstdio>
+#include <sstream>
+
+thread_local bool StartupTrace::enabled = false;
+thread_local StartupTrace::Scope* StartupTrace::current = nullptr;
+thread_local std::vector<StartupTrace::Entry> StartupTrace::entries;
+
+StartupTrace::Scope::Scope(Phase phase, const char* name) :
+  phase(phase), name(name), start(Time::getRealTimeInMicroseconds()), parent(current)
+{
+  current = this;
+}
+
+StartupTrace::Scope::~Scope()
+{
+  const unsigned long long duration = Time::getRealTimeInMicroseconds() - start;
+  if(enabled)
+    entries.push_back({phase, name, duration - std::min(nested, duration), false});
+  if(parent)
+    parent->nested += duration;
+  current = parent;
+}
+
+StartupTrace::Deferred::Deferred(const char* name, const std::function<void()>& initialize) :
+  name(name), taskPool(TaskPool::acquire())
+{
+  task = taskPool->start([this, initialize] {run(initialize);});
+}
+
+bool StartupTrace::Deferred::isReady()
+{
+  if(!task->isDone())
+    return false;
+  record();
+  return true;
+}
+
+void StartupTrace::Deferred::wait()
+{
+  if(!task->isDone())
+  {
+    Scope scope(waiting, name.c_str());
+    task->wait();
+  }
+  record();
+}
+
+void StartupTrace::Deferred::run(const std::function<void()>& initialize)
+{
+  // The initialization may run in a worker or in the thread of the module,
+  // so its measurements are collected separately.
+  const bool wasEnabled = enabled;
+  Scope* const outerScope = current;
+  std::vector<Entry> outerEntries;
+  outerEntries.swap(entries);
+  enabled = true;
+  current = nullptr;
+
+  const unsigned long long start = Time::getRealTimeInMicroseconds();
+  {
+    Scope scope(deferred, name.c_str());
+    initialize();
+  }
+  const unsigned long long duration = Time::getRealTimeInMicroseconds() - start;
+
+  measurements.swap(entries);
+  entries.swap(outerEntries);
+  enabled = wasEnabled;
+  current = outerScope;
+  if(current)
+    current->nested += duration;
+}
+
+void StartupTrace::Deferred::record()
+{
+  if(recorded)
+    return;
+  recorded = true;
+  task->wait();
+  if(enabled)
+    for(Entry& entry : measurements)
+    {
+      entry.background = true;
+      entries.emplace_back(std::move(entry));
+    }
+  measurements.clear();
+}
+
+void StartupTrace::report()
+{
+  if(entries.empty())
+    return;
+
+  std::array<unsigned long long, numOfPhases> foreground;
+  std::array<unsigned long long, numOfPhases> background;
+  foreground.fill(0);
+  background.fill(0);
+  unsigned long long total = 0;
+  for(const Entry& entry : entries)
+  {
+    (entry.background ? background : foreground)[entry.phase] += entry.duration;
+    if(!entry.background)
+      total += entry.duration;
+  }
+
+  std::vector<std::string> lines;
+  std::stringstream line;
+  line << "Startup of " << Thread::getCurrentThreadName() << ": " << static_cast<float>(total) / 1000.f << " ms";
+  FOREACH_ENUM(Phase, phase)
+    if(foreground[phase] || background[phase])
+    {
+      line << ", " << TypeRegistry::getEnumName(phase);
+      if(foreground[phase])
+        line << " " << static_cast<float>(foreground[phase]) / 1000.f << " ms";
+      if(background[phase])
+        line << " (+" << static_cast<float>(background[phase]) / 1000.f << " ms in background)";
+    }
+  lines.emplace_back(line.str());
+
+  // The most expensive parts
+  std::sort(entries.begin(), entries.end(), [](const Entry& a, const Entry& b) {return a.duration > b.duration;});
+  for(std::size_t i = 0; i < std::min<std::size_t>(entries.size(), 10); ++i)
+  {
+    std::stringstream line;
+    line << "  " << entries[i].name << " (" << TypeRegistry::getEnumName(entries[i].phase)
+         << (entries[i].background ? ", background" : "") << "): " << static_cast<float>(entries[i].duration) / 1000.f << " ms";
+    lines.emplace_back(line.str());
+  }
+  entries.clear();
+
+  for(const std::string& text : lines)
+  {
+    OUTPUT_TEXT(text);
+#ifdef TARGET_ROBOT
+    std::printf("%s\n", text.c_str());
+#endif
+  }
+}
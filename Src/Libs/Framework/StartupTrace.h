@@ -0,0 +1,134 @@
+/**
+ * @file StartupTrace.h
+ *
+ * This file declares a class that measures where the time goes when the
+ * modules of a thread are initialized, i.e. while representations are
+ * allocated, modules are constructed, their parameters are loaded, and their
+ * neural networks are compiled. The measurements of a thread are reported
+ * after the frame in which they were taken, which is usually the first one.
+ * Measurements can be nested. Each one only contains the time not spent in
+ * the nested ones.
+ *
+ * Modules can also defer expensive parts of their initialization. These are
+ * executed in the background by the task pool, while the thread continues.
+ * A module has to wait for them before it uses their results.
+ */
+
+#pragma once
+
+#include "Framework/TaskPool.h"
+#include "Streaming/Enum.h"
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+class StartupTrace
+{
+public:
+  ENUM(Phase,
+  {,
+    allocation, /**< Allocating a representation in the blackboard. */
+    construction, /**< Constructing a module. */
+    parameters, /**< Loading the parameters of a module. */
+    compilation, /**< Compiling a neural network. */
+    deferred, /**< Initializing a module in the background. */
+    waiting, /**< Waiting for the initialization in the background. */
+  });
+
+private:
+  /** A measurement. */
+  struct Entry
+  {
+    Phase phase; /**< The phase measured. */
+    std::string name; /**< The name of what was initialized. */
+    unsigned long long duration; /**< The duration without nested scopes (in µs). */
+    bool background; /**< Was it measured in the background? */
+  };
+
+public:
+  /**
+   * Measures the time from its construction to its destruction, except for
+   * the time spent in nested scopes.
+   */
+  class Scope
+  {
+  public:
+    /**
+     * Constructor.
+     * @param phase The phase measured.
+     * @param name The name of what is initialized, e.g. a module or a representation.
+     */
+    Scope(Phase phase, const char* name);
+
+    /** Destructor. Records the measurement. */
+    ~Scope();
+
+  private:
+    Phase phase; /**< The phase measured. */
+    const char* name; /**< The name of what is initialized. */
+    unsigned long long start; /**< When the measurement started (in µs). */
+    unsigned long long nested = 0; /**< The time spent in nested scopes (in µs). */
+    Scope* parent; /**< The enclosing scope or \c nullptr. */
+
+    friend class StartupTrace;
+  };
+
+  /**
+   * A part of the initialization of a module that is executed in the background.
+   * If the initialization uses attributes of the module, the object must be
+   * declared behind them, because it waits for the initialization when it is
+   * destroyed.
+   */
+  class Deferred
+  {
+  public:
+    /**
+     * Constructor. Starts the initialization.
+     * @param name The name of what is initialized, e.g. the module.
+     * @param initialize The initialization. It must not use debugging macros.
+     */
+    Deferred(const char* name, const std::function<void()>& initialize);
+
+    /**
+     * Has the initialization finished? Never blocks.
+     * @return Can its results be used?
+     */
+    bool isReady();
+
+    /** Waits until the initialization has finished. */
+    void wait();
+
+  private:
+    /**
+     * Executes the initialization and collects its measurements.
+     * @param initialize The initialization.
+     */
+    void run(const std::function<void()>& initialize);
+
+    /** Adds the measurements of the initialization to those of this thread. */
+    void record();
+
+    std::string name; /**< The name of what is initialized. */
+    std::shared_ptr<TaskPool> taskPool; /**< The pool that executes the initialization. */
+    std::vector<Entry> measurements; /**< The measurements taken by the initialization. */
+    bool recorded = false; /**< Were the measurements already added? */
+    std::unique_ptr<TaskPool::Task> task; /**< The initialization. Destroyed first. */
+  };
+
+  /**
+   * Switches measuring on for the current thread.
+   */
+  static void enable() {enabled = true;}
+
+  /**
+   * Outputs the measurements of the current thread if there are any and
+   * removes them.
+   */
+  static void report();
+
+private:
+  thread_local static bool enabled; /**< Are measurements taken in this thread? */
+  thread_local static Scope* current; /**< The innermost scope in this thread or \c nullptr. */
+  thread_local static std::vector<Entry> entries; /**< The measurements of this thread. */
+};
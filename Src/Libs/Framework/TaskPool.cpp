@@ -0,0 +1,212 @@
+/**
+ * @file TaskPool.cpp
+ *
+ * This file implements a pool of worker threads that is shared by all threads
+ * of the process.
+ */
+
+#include "TaskPool.h"
+#include "Debugging/TimingManager.h"
+#include "Platform/Time.h"
+#include <algorithm>
+#include <thread>
+
+std::atomic<bool> TaskPool::sequential = false;
+
+std::shared_ptr<TaskPool> TaskPool::acquire()
+{
+  static DECLARE_SYNC;
+  static std::weak_ptr<TaskPool> instance;
+
+  SYNC;
+  std::shared_ptr<TaskPool> pool = instance.lock();
+  if(!pool)
+  {
+    // The thread calling a loop is the remaining one.
+    const unsigned cores = std::max(1u, std::thread::hardware_concurrency());
+    pool = std::make_shared<TaskPool>(cores - 1);
+    instance = pool;
+  }
+  return pool;
+}
+
+TaskPool::TaskPool(unsigned numOfWorkers)
+{
+  for(unsigned i = 0; i < numOfWorkers; ++i)
+  {
+    // Workers use the normal scheduler, so they never delay real-time threads.
+    workers.emplace_back(std::make_unique<Thread>());
+    workers.back()->start(this, &TaskPool::run);
+  }
+}
+
+TaskPool::~TaskPool()
+{
+  // All workers must know that they should stop before any is woken up.
+  for(std::unique_ptr<Thread>& worker : workers)
+    worker->announceStop();
+  for(std::size_t i = 0; i < workers.size(); ++i)
+    chunksAvailable.post();
+  for(std::unique_ptr<Thread>& worker : workers)
+    worker->stop();
+}
+
+std::size_t TaskPool::getNumOfChunks(std::size_t size, std::size_t minChunkSize) const
+{
+  // A few chunks per thread balance chunks that take different times.
+  return std::min((size + std::max<std::size_t>(minChunkSize, 1) - 1) / std::max<std::size_t>(minChunkSize, 1),
+                  static_cast<std::size_t>(getConcurrency()) * 4);
+}
+
+void TaskPool::parallelFor(const char* name, std::size_t begin, std::size_t end,
+                           const std::function<void(std::size_t, std::size_t)>& body, std::size_t minChunkSize)
+{
+  const std::size_t numOfChunks = getNumOfChunks(end > begin ? end - begin : 0, minChunkSize);
+  if(numOfChunks)
+    execute(name, begin, end, numOfChunks, [&body](std::size_t, std::size_t chunkBegin, std::size_t chunkEnd)
+    {
+      body(chunkBegin, chunkEnd);
+    });
+}
+
+void TaskPool::execute(const char* name, std::size_t begin, std::size_t end, std::size_t numOfChunks, const ChunkBody& body)
+{
+  Job job;
+  job.body = &body;
+  job.begin = begin;
+  job.end = end;
+  job.numOfChunks = numOfChunks;
+
+  if(sequential || workers.empty() || numOfChunks == 1 || !mayWaitForWorkers())
+  {
+    for(std::size_t chunk = 0; chunk < numOfChunks; ++chunk)
+      body(chunk, begin + chunk * (end - begin) / numOfChunks, begin + (chunk + 1) * (end - begin) / numOfChunks);
+    return;
+  }
+
+  {
+    SYNC;
+    jobs.push_back(&job);
+  }
+  for(std::size_t i = std::min(numOfChunks - 1, workers.size()); i > 0; --i)
+    chunksAvailable.post();
+
+  Job* current;
+  std::size_t chunk;
+  while(takeChunk(current, chunk, &job))
+    executeChunk(job, chunk, false);
+
+  job.finished.wait();
+  {
+    SYNC;
+    jobs.remove(&job);
+  }
+
+  if(name && Global::timingManagerExists())
+    Global::getTimingManager().addTiming(name, static_cast<unsigned>(job.workerTime));
+}
+
+std::unique_ptr<TaskPool::Task> TaskPool::start(const std::function<void()>& body)
+{
+  std::unique_ptr<Task> task(new Task(*this, body));
+  if(sequential || workers.empty() || !mayWaitForWorkers())
+    executeChunk(task->job, 0, false);
+  else
+  {
+    {
+      SYNC;
+      jobs.push_back(&task->job);
+    }
+    task->queued = true;
+    chunksAvailable.post();
+  }
+  return task;
+}
+
+TaskPool::Task::Task(TaskPool& pool, const std::function<void()>& body) :
+  pool(pool),
+  body([body](std::size_t, std::size_t, std::size_t) {body();})
+{
+  job.body = &this->body;
+  job.begin = 0;
+  job.end = 1;
+  job.numOfChunks = 1;
+}
+
+void TaskPool::Task::wait()
+{
+  if(!queued)
+    return;
+
+  Job* current;
+  std::size_t chunk;
+  if(pool.takeChunk(current, chunk, &job))
+    executeChunk(job, chunk, false);
+
+  job.finished.wait();
+  {
+    SYNC_WITH(pool);
+    pool.jobs.remove(&job);
+  }
+  queued = false;
+}
+
+bool TaskPool::mayWaitForWorkers()
+{
+  // Waiting for workers, which use the normal scheduler, would delay threads with a high priority.
+  const Thread* const caller = Thread::getCurrentThread();
+  return !caller || caller->getCurrentPriority() <= maxCallerPriority;
+}
+
+bool TaskPool::takeChunk(Job*& job, std::size_t& chunk, Job* only)
+{
+  SYNC;
+  for(Job* candidate : jobs)
+    if((!only || candidate == only) && candidate->nextChunk < candidate->numOfChunks)
+    {
+      job = candidate;
+      chunk = candidate->nextChunk++;
+      return true;
+    }
+  return false;
+}
+
+void TaskPool::executeChunk(Job& job, std::size_t chunk, bool measure)
+{
+  const unsigned long long start = measure ? Time::getCurrentThreadTime() : 0;
+  const std::size_t size = job.end - job.begin;
+  (*job.body)(chunk, job.begin + chunk * size / job.numOfChunks, job.begin + (chunk + 1) * size / job.numOfChunks);
+  if(measure)
+    job.workerTime += Time::getCurrentThreadTime() - start;
+
+  // The calling thread may destroy the job as soon as the last chunk has finished,
+  // i.e. it must not be accessed anymore after the increment.
+  const std::size_t numOfChunks = job.numOfChunks;
+  if(++job.finishedChunks == numOfChunks)
+    job.finished.post();
+}
+
+void TaskPool::run()
+{
+  Thread::nameCurrentThread("TaskPool");
+  while(true)
+  {
+    chunksAvailable.wait();
+    if(!Thread::getCurrentThread()->isRunning())
+      break;
+
+    Job* job;
+    std::size_t chunk;
+    while(takeChunk(job, chunk))
+    {
+      // The body may use these parts of Global of the thread that created the job.
+      Global::theSettings = job->globals.settings;
+      Global::theAsmjitRuntime = job->globals.asmjitRuntime;
+      Global::theTaskPool = job->globals.taskPool;
+      executeChunk(*job, chunk, true);
+    }
+    Global::theSettings = nullptr;
+    Global::theAsmjitRuntime = nullptr;
+    Global::theTaskPool = nullptr;
+  }
+}
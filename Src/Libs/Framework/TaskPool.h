@@ -0,0 +1,251 @@
+/**
+ * @file TaskPool.h
+ *
+ * This file declares a pool of worker threads that is shared by all threads
+ * of the process. Modules use it through Global::getTaskPool() to split
+ * data-parallel loops into chunks. The calling thread always executes chunks
+ * itself and only returns when all chunks are done, so the loop body may use
+ * the data of the calling thread. While a worker executes a chunk, it uses the
+ * settings, the asmjit runtime, and the task pool of the calling thread, i.e.
+ * these parts of Global are available and loops can be nested. All other
+ * parts of Global are not, i.e. debugging macros must not be used.
+ *
+ * How a range is split into chunks only depends on its size, the minimum
+ * chunk size, and the number of workers, never on the scheduling. Therefore,
+ * parallelReduce produces the same results in every run on the same machine.
+ * Loops called from threads with a priority above maxCallerPriority (e.g.
+ * Motion on the robot, but not Cognition) and all loops in sequential mode (a
+ * deterministic mode for the simulator) are executed by the calling thread
+ * alone, but still chunk by chunk.
+ *
+ * In addition, single tasks can be started in the background, e.g. to
+ * initialize something that is only needed later. Waiting for such a task
+ * executes it in the waiting thread if no worker has started it yet.
+ */
+
+#pragma once
+
+#include "Platform/Semaphore.h"
+#include "Platform/Thread.h"
+#include "Streaming/Global.h"
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <list>
+#include <memory>
+#include <vector>
+
+class TaskPool
+{
+public:
+  class Task;
+
+  static constexpr int maxCallerPriority = 10; /**< Threads with a higher priority do not wait for workers. */
+
+  /**
+   * Returns the pool of this process. It is created when it is acquired
+   * first and destroyed when the last user released it.
+   * @return The pool.
+   */
+  static std::shared_ptr<TaskPool> acquire();
+
+  /**
+   * Constructor.
+   * @param numOfWorkers The number of worker threads. The calling thread
+   *                     of a loop also executes chunks of it.
+   */
+  explicit TaskPool(unsigned numOfWorkers);
+
+  /** Stops all worker threads. */
+  ~TaskPool();
+
+  /**
+   * Switches the sequential mode on or off for all pools of the process.
+   * @param sequential Execute all loops in the calling thread?
+   */
+  static void setSequential(bool sequential) {TaskPool::sequential = sequential;}
+
+  /**
+   * Is the sequential mode active?
+   * @return Are all loops executed in the calling thread?
+   */
+  static bool isSequential() {return sequential;}
+
+  /**
+   * Returns the number of threads that can execute a loop at the same time.
+   * @return The number of workers plus the calling thread.
+   */
+  unsigned getConcurrency() const {return static_cast<unsigned>(workers.size()) + 1;}
+
+  /**
+   * Returns the number of chunks a range is split into.
+   * @param size The size of the range.
+   * @param minChunkSize The minimum number of elements per chunk.
+   * @return The number of chunks.
+   */
+  std::size_t getNumOfChunks(std::size_t size, std::size_t minChunkSize = 1) const;
+
+  /**
+   * Executes a loop body for all chunks of a range in parallel.
+   * @param name If not \c nullptr, the CPU time the workers spent is reported
+   *             to the timing manager of the calling thread under this name.
+   *             It must be a string literal, like the names of stopwatches.
+   * @param begin The first index of the range.
+   * @param end The index behind the range.
+   * @param body The loop body. It is called with the first and the behind-last
+   *             index of a chunk.
+   * @param minChunkSize The minimum number of elements per chunk.
+   */
+  void parallelFor(const char* name, std::size_t begin, std::size_t end,
+                   const std::function<void(std::size_t, std::size_t)>& body, std::size_t minChunkSize = 1);
+
+  /**
+   * Maps all chunks of a range to values in parallel and reduces them in the
+   * order of the chunks.
+   * @param name See parallelFor.
+   * @param begin The first index of the range.
+   * @param end The index behind the range.
+   * @param identity The result for an empty range.
+   * @param map Computes the value of a chunk given its first and behind-last index.
+   * @param reduce Combines two values.
+   * @param minChunkSize The minimum number of elements per chunk.
+   * @return The reduced value.
+   */
+  template<typename T, typename Map, typename Reduce>
+  T parallelReduce(const char* name, std::size_t begin, std::size_t end, const T& identity,
+                   const Map& map, const Reduce& reduce, std::size_t minChunkSize = 1);
+
+  /**
+   * Starts a task in the background. In the cases in which loops are executed
+   * by the calling thread alone, the task is executed before this method returns.
+   * @param body The task. It must not use debugging macros.
+   * @return The handle of the task. It must not outlive the pool.
+   */
+  std::unique_ptr<Task> start(const std::function<void()>& body);
+
+private:
+  /** A loop body that is called with the index, the first index, and the behind-last index of a chunk. */
+  using ChunkBody = std::function<void(std::size_t, std::size_t, std::size_t)>;
+
+  /** The parts of Global that a worker uses while it executes a chunk. */
+  struct Globals
+  {
+    Settings* settings = Global::theSettings; /**< The settings of the creating thread. */
+    asmjit::JitRuntime* asmjitRuntime = Global::theAsmjitRuntime; /**< The asmjit runtime of the creating thread. */
+    TaskPool* taskPool = Global::theTaskPool; /**< The task pool of the creating thread. */
+  };
+
+  /** A loop that is currently executed. */
+  struct Job
+  {
+    Globals globals; /**< The parts of Global of the thread that created the job. */
+    const ChunkBody* body; /**< The loop body. */
+    std::size_t begin; /**< The first index of the range. */
+    std::size_t end; /**< The index behind the range. */
+    std::size_t numOfChunks; /**< The number of chunks the range is split into. */
+    std::size_t nextChunk = 0; /**< The next chunk that is not executed yet (protected by the lock). */
+    std::atomic<std::size_t> finishedChunks = 0; /**< The number of chunks finished. */
+    std::atomic<unsigned long long> workerTime = 0; /**< The CPU time spent by the workers in us. */
+    Semaphore finished; /**< Posted when the last chunk has finished. */
+  };
+
+  /**
+   * Executes a loop body for all chunks of a range.
+   * @param name See parallelFor.
+   * @param begin The first index of the range.
+   * @param end The index behind the range.
+   * @param numOfChunks The number of chunks the range is split into.
+   * @param body The loop body.
+   */
+  void execute(const char* name, std::size_t begin, std::size_t end, std::size_t numOfChunks, const ChunkBody& body);
+
+  /**
+   * Takes the next chunk of any job.
+   * @param job The job the chunk belongs to.
+   * @param chunk The index of the chunk.
+   * @param only If not \c nullptr, only take chunks of this job.
+   * @return Was there a chunk left?
+   */
+  bool takeChunk(Job*& job, std::size_t& chunk, Job* only = nullptr);
+
+  /**
+   * Checks whether the calling thread may hand chunks to the workers.
+   * @return Is its priority low enough to wait for them?
+   */
+  static bool mayWaitForWorkers();
+
+  /**
+   * Executes a chunk and signals the job if it was the last one.
+   * @param job The job.
+   * @param chunk The index of the chunk.
+   * @param measure Add the CPU time spent to the time of the workers?
+   */
+  static void executeChunk(Job& job, std::size_t chunk, bool measure);
+
+  /** The main loop of the worker threads. */
+  void run();
+
+  static std::atomic<bool> sequential; /**< Execute all loops in the calling thread? */
+
+  DECLARE_SYNC; /**< Protects the jobs. */
+  std::list<Job*> jobs; /**< The jobs that still have chunks left. */
+  Semaphore chunksAvailable; /**< Posted for every chunk that a worker could execute. */
+  std::vector<std::unique_ptr<Thread>> workers; /**< The worker threads. */
+};
+
+/**
+ * The handle of a task that is executed in the background.
+ */
+class TaskPool::Task
+{
+public:
+  /** The destructor waits for the task, because it may still use its creator. */
+  ~Task() {wait();}
+
+  /**
+   * Has the task finished?
+   * @return Is it done?
+   */
+  bool isDone() const {return job.finishedChunks == job.numOfChunks;}
+
+  /**
+   * Waits until the task has finished. If no worker has started it yet, it is
+   * executed by the calling thread.
+   */
+  void wait();
+
+private:
+  friend class TaskPool;
+
+  /**
+   * Constructor.
+   * @param pool The pool the task is executed by.
+   * @param body The task.
+   */
+  Task(TaskPool& pool, const std::function<void()>& body);
+
+  TaskPool& pool; /**< The pool the task is executed by. */
+  ChunkBody body; /**< The task as a loop body with a single chunk. */
+  Job job; /**< The job that executes the task. */
+  bool queued = false; /**< Is the job still in the list of the pool? */
+};
+
+template<typename T, typename Map, typename Reduce>
+T TaskPool::parallelReduce(const char* name, std::size_t begin, std::size_t end, const T& identity,
+                           const Map& map, const Reduce& reduce, std::size_t minChunkSize)
+{
+  const std::size_t numOfChunks = getNumOfChunks(end > begin ? end - begin : 0, minChunkSize);
+  if(!numOfChunks)
+    return identity;
+
+  std::vector<T> values(numOfChunks, identity);
+  execute(name, begin, end, numOfChunks, [&](std::size_t chunk, std::size_t chunkBegin, std::size_t chunkEnd)
+  {
+    values[chunk] = map(chunkBegin, chunkEnd);
+  });
+
+  T result = values.front();
+  for(std::size_t i = 1; i < numOfChunks; ++i)
+    result = reduce(result, values[i]);
+  return result;
+}
@@ -16,6 +16,7 @@
 ThreadFrame::ThreadFrame(const Settings& settings, const std::string& robotName) :
   settings(settings),
   asmjitRuntime(new asmjit::JitRuntime()),
+  taskPool(TaskPool::acquire()),
   robotName(robotName)
 {
   // Set settings as soon as possible for file access.
@@ -28,6 +29,7 @@ ThreadFrame::ThreadFrame(const Settings& settings, const std::string& robotName,
   debugSender(debugSender),
   settings(settings),
   asmjitRuntime(new asmjit::JitRuntime()),
+  taskPool(TaskPool::acquire()),
   robotName(robotName)
 {
   // Set settings as soon as possible for file access and debugOut for debugging.
@@ -63,6 +65,7 @@ void ThreadFrame::setGlobals()
   Global::theDrawingManager3D = &drawingManager3D;
   Global::theTimingManager = &timingManager;
   Global::theAsmjitRuntime = asmjitRuntime;
+  Global::theTaskPool = taskPool.get();
   File::setSearchPath(settings.searchPath);
 
   Blackboard::setInstance(blackboard); // blackboard is NOT globally accessible
@@ -19,6 +19,7 @@
 #include "Debugging/DebugDrawings3D.h"
 #include "Debugging/DebugRequest.h"
 #include "Debugging/TimingManager.h"
+#include "Framework/TaskPool.h"
 #include "Platform/SystemCall.h"
 #include "Platform/Thread.h"
 #ifdef TARGET_ROBOT
@@ -62,6 +63,7 @@ private:
   DrawingManager3D drawingManager3D;
   asmjit::JitRuntime* asmjitRuntime; /**< JIT and Remote Assembler for C++ in this thread. */
   TimingManager timingManager; /**< Keeps track of the module timing in this thread. */
+  std::shared_ptr<TaskPool> taskPool; /**< The task pool shared by all threads of the process. */
 
 protected:
   const std::string robotName; /**< The name of the robot this thread belongs to. */
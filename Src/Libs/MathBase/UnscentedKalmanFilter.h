@@ -2,6 +2,8 @@
  * @file UnscentedKalmanFilter.h
  *
  * A generic implementation of an Unscented Kalman Filter.
+ * The dynamic and measurement models are passed as template parameters, so
+ * lambdas are inlined into the sigma point loops.
  *
  * @author <a href="mailto:alexists@tzi.de">Alexis Tsogias</a>
  */
@@ -13,7 +15,7 @@
 #include "MathBase/Eigen.h"
 #include "Platform/BHAssert.h"
 
-#include <functional>
+#include <array>
 #include <limits>
 
 /**
@@ -82,29 +84,31 @@ namespace impl
     /**
      * The prediction step to propagate the whole hypothesis with a given dynamic model and an operation specific noise.
      * In other works this function is referred as dynamic step.
-     * @param dynamicModel, a function to propagate the state
+     * @param dynamicModel, a callable with the signature void(State&) to propagate the state
      * @param noise, the propagation specific noise (as a variance) to quantify the uncertainty
      */
-    void predict(const std::function<void(State&)>& dynamicModel, const CovarianceType& noise);
+    template<typename DynamicModel>
+    void predict(const DynamicModel& dynamicModel, const CovarianceType& noise);
 
     /**
      * The multi dimensional update step to integrate a measurement into an existing hypothesis.
      * In other works this function is referred as measurement step.
      * @param measurement, a vector that stores all relevant data of a measurement
-     * @param measurementModel, a function that returns a measurement for a state
+     * @param measurementModel, a callable with the signature Vectorf<N>(const State&) that returns a measurement for a state
      * @param measurementNoise, the measurement specific noise (as a variance) to quantify the uncertainty
      */
-    template<unsigned N>
-    void update(const Vectorf<N>& measurement, const std::function<Vectorf<N>(const State&)>& measurementModel, const Eigen::Matrix<float, N, N>& measurementNoise);
+    template<unsigned N, typename MeasurementModel>
+    void update(const Vectorf<N>& measurement, const MeasurementModel& measurementModel, const Eigen::Matrix<float, N, N>& measurementNoise);
 
     /**
      * The single dimensional update step to integrate a measurement into an existing hypothesis.
      * In other works this function is referred as measurement step.
      * @param measurement, a float value that represents a measurement
-     * @param measurementModel, a function that returns a measurement for a state
+     * @param measurementModel, a callable with the signature float(const State&) that returns a measurement for a state
      * @param measurementNoise, the measurement specific noise (as a variance) to quantify the uncertainty
      */
-    void update(float measurement, const std::function<float(const State&)>& measurementModel, float measurementNoise);
+    template<typename MeasurementModel>
+    void update(float measurement, const MeasurementModel& measurementModel, float measurementNoise);
 
   private:
     /**
@@ -159,11 +163,12 @@ namespace impl
   /**
    * The prediction step to propagate the whole hypothesis with a given dynamic model and an operation specific noise.
    * In other works this function is referred as dynamic step.
-   * @param dynamicModel, a function to propagate the state
+   * @param dynamicModel, a callable with the signature void(State&) to propagate the state
    * @param noise, the propagation specific noise (as variance) to quantify the uncertainty
    */
   template<typename State, unsigned DOF, bool Manifold>
-  void UnscentedKalmanFilter<State, DOF, Manifold>::predict(const std::function<void(State&)>& dynamicModel, const CovarianceType& noise)
+  template<typename DynamicModel>
+  void UnscentedKalmanFilter<State, DOF, Manifold>::predict(const DynamicModel& dynamicModel, const CovarianceType& noise)
   {
     ASSERT((noise.array() >= 0.f).all());
     ASSERT(noise.trace() > 0.f);
@@ -192,12 +197,12 @@ namespace impl
    * The multi dimensional update step to integrate a measurement into an existing hypothesis.
    * In other works this function is referred as measurement step.
    * @param measurement, a vector that stores all relevant data of a measurement
-   * @param measurementModel, a function that returns a measurement for a state
+   * @param measurementModel, a callable with the signature Vectorf<N>(const State&) that returns a measurement for a state
    * @param measurementNoise, the measurement specific noise (as variance) to quantify the uncertainty
    */
   template<typename State, unsigned DOF, bool IsManifold>
-  template<unsigned N>
-  void UnscentedKalmanFilter<State, DOF, IsManifold>::update(const Vectorf<N>& measurement, const std::function<Vectorf<N>(const State&)>& measurementModel, const Eigen::Matrix<float, N, N>& measurementNoise)
+  template<unsigned N, typename MeasurementModel>
+  void UnscentedKalmanFilter<State, DOF, IsManifold>::update(const Vectorf<N>& measurement, const MeasurementModel& measurementModel, const Eigen::Matrix<float, N, N>& measurementNoise)
   {
     ASSERT((measurementNoise.diagonal().array() >= 0.f).all());
     ASSERT(measurementNoise.trace() > 0.f);
@@ -252,11 +257,12 @@ namespace impl
    * The single dimensional update step to integrate a measurement into an existing hypothesis.
    * In other works this function is referred as measurement step.
    * @param measurement, a float value that represents a measurement
-   * @param measurementModel, a function that returns a measurement for a state
+   * @param measurementModel, a callable with the signature float(const State&) that returns a measurement for a state
    * @param measurementNoise, the measurement specific noise (as variance) to quantify the uncertainty
    */
   template<typename State, unsigned DOF, bool IsManifold>
-  void UnscentedKalmanFilter<State, DOF, IsManifold>::update(float measurement, const std::function<float(const State&)>& measurementModel, float measurementNoise)
+  template<typename MeasurementModel>
+  void UnscentedKalmanFilter<State, DOF, IsManifold>::update(float measurement, const MeasurementModel& measurementModel, float measurementNoise)
   {
     ASSERT(measurementNoise > 0.f);
 
@@ -41,6 +41,7 @@ struct _WSAFramework
 #include <arpa/inet.h>
 #include <unistd.h>
 #include <sys/ioctl.h>
+#include <sys/uio.h>
 
 #define ERRNO errno
 #define RESET_ERRNO errno = 0
@@ -235,3 +236,79 @@ bool TcpComm::send(const unsigned char* buffer, int size)
     return false;
   }
 }
+
+bool TcpComm::send(const Segment* segments, int numOfSegments)
+{
+  ASSERT(numOfSegments <= maxSegments);
+#ifdef WINDOWS
+  for(int i = 0; i < numOfSegments; ++i)
+    if(!send(static_cast<const unsigned char*>(segments[i].data), static_cast<int>(segments[i].size)))
+      return false;
+  return true;
+#else
+  if(!checkConnection())
+    return false;
+
+  iovec vectors[maxSegments];
+  std::size_t size = 0;
+  for(int i = 0; i < numOfSegments; ++i)
+  {
+    vectors[i].iov_base = const_cast<void*>(segments[i].data);
+    vectors[i].iov_len = segments[i].size;
+    size += segments[i].size;
+  }
+
+  // sendmsg instead of writev, because the latter does not accept MSG_NOSIGNAL.
+  msghdr message = {};
+  message.msg_iov = vectors;
+  message.msg_iovlen = static_cast<decltype(message.msg_iovlen)>(numOfSegments);
+
+  std::size_t sent = 0;
+  RESET_ERRNO;
+  while(true)
+  {
+    const ssize_t sent2 = sendmsg(transferSocket, &message, MSG_NOSIGNAL);
+    if(sent2 > 0)
+    {
+      sent += static_cast<std::size_t>(sent2);
+      overallBytesSent += static_cast<int>(sent2);
+
+      // Skip the part already sent.
+      for(std::size_t skip = static_cast<std::size_t>(sent2); skip > 0;)
+        if(skip >= message.msg_iov->iov_len)
+        {
+          skip -= message.msg_iov->iov_len;
+          ++message.msg_iov;
+          --message.msg_iovlen;
+        }
+        else
+        {
+          message.msg_iov->iov_base = static_cast<char*>(message.msg_iov->iov_base) + skip;
+          message.msg_iov->iov_len -= skip;
+          skip = 0;
+        }
+    }
+    if(sent == size || (ERRNO != EWOULDBLOCK && ERRNO != EINPROGRESS && ERRNO != 0))
+      break;
+
+    timeval timeout;
+    timeout.tv_sec = 0;
+    timeout.tv_usec = 100000;
+    fd_set wset;
+    FD_ZERO(&wset);
+    FD_SET(transferSocket, &wset);
+    RESET_ERRNO;
+    if(select(static_cast<int>(transferSocket + 1), 0, &wset, 0, &timeout) == -1)
+      break;
+    RESET_ERRNO;
+  }
+
+  if(ERRNO == 0 && sent == size)
+    return true;
+  else
+  {
+    closeTransferSocket();
+    return false;
+  }
+#endif
+}
@@ -14,6 +14,7 @@
 #else
 #include <netinet/in.h>
 #endif
+#include <cstddef>
 
 #ifdef WINDOWS
 #define socket_t SOCKET
@@ -27,6 +28,16 @@
  */
 class TcpComm
 {
+public:
+  /** A block of bytes that is sent as a part of a larger one. */
+  struct Segment
+  {
+    const void* data; /**< The address of the bytes. */
+    std::size_t size; /**< The number of bytes. */
+  };
+
+  static constexpr int maxSegments = 8; /**< The maximum number of segments that are sent together. */
+
 private:
   socket_t createSocket = 0; /**< The handle of the basic socket. */
   socket_t transferSocket = 0; /**< The handle of the actual transfer socket. */
@@ -73,6 +84,16 @@ public:
    */
   bool send(const unsigned char* buffer, int size);
 
+  /**
+   * The function sends several blocks of bytes as a single one, i.e. without
+   * copying them together first (scatter/gather). It will return immediately
+   * unless the send buffer is full.
+   * @param segments The blocks to send.
+   * @param numOfSegments The number of blocks. At most \c maxSegments .
+   * @return Was the data successfully sent?
+   */
+  bool send(const Segment* segments, int numOfSegments);
+
   /**
    * The function receives a block of bytes.
    * @param buffer This buffer will be filled with the bytes to receive.
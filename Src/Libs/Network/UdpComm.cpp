@@ -16,6 +16,7 @@
 #include <sys/ioctl.h>
 #include <arpa/inet.h>
 #include <cstring>
+#include <ctime>
 #include <net/if.h>
 #include <ifaddrs.h>
 #endif
@@ -28,6 +29,77 @@
 #include "Platform/BHAssert.h"
 #include "Platform/Time.h"
 #include "Streaming/Output.h"
+#include <algorithm>
+#include <vector>
+
+#if defined LINUX || defined TARGET_ROBOT
+#define BATCHED_IO
+#endif
+
+struct UdpComm::Batch
+{
+  /** A packet queued for writing. */
+  struct Queued
+  {
+    std::size_t offset; /**< The offset of the payload in \c queuedData. */
+    int size; /**< The size of the payload. */
+    sockaddr_in target; /**< The receiver. */
+  };
+
+  unsigned size = 0; /**< The maximum size of a packet read. */
+  std::vector<char> buffers; /**< The payloads of all packets read, each \c size bytes long. */
+  std::vector<Packet> packets; /**< The packets read. */
+#ifdef BATCHED_IO
+  std::vector<mmsghdr> messages; /**< The message headers for recvmmsg and sendmmsg. */
+  std::vector<iovec> vectors; /**< The buffers of the messages. */
+  std::vector<sockaddr_in> senders; /**< The senders of the packets read. */
+  std::vector<char> controls; /**< The control data of the packets read, i.e. their timestamps. */
+#endif
+  std::vector<char> queuedData; /**< The payloads of all queued packets. */
+  std::vector<Queued> queued; /**< The packets queued for writing. */
+};
+
+#ifdef BATCHED_IO
+/** The space reserved for the control data of each packet read. */
+static constexpr std::size_t controlSize = CMSG_SPACE(sizeof(timespec));
+
+/**
+ * Converts a packet timestamp from the realtime clock into B-Human system time.
+ * @param tsPacket When the kernel received the packet.
+ * @return The timestamp in B-Human system time.
+ */
+static unsigned toSystemTime(const timespec& tsPacket)
+{
+  timespec tsReal;
+  clock_gettime(CLOCK_REALTIME, &tsReal);
+  const long long age = (tsReal.tv_sec - tsPacket.tv_sec) * 1000ll + (tsReal.tv_nsec - tsPacket.tv_nsec) / 1000000ll;
+  return Time::getCurrentSystemTime() - static_cast<unsigned>(std::max(0ll, age));
+}
+#endif
+
+#ifndef WINDOWS
+/**
+ * Determines the addresses of all multicast-capable IPv4 interfaces of this host.
+ * @param addresses The addresses (in network byte order).
+ * @return Could the interfaces be determined?
+ */
+static bool getLocalAddresses(std::vector<in_addr_t>& addresses)
+{
+  ifaddrs* addrs;
+  if(getifaddrs(&addrs) < 0)
+    return false;
+
+  addresses.clear();
+  for(ifaddrs* ifac = addrs; ifac != nullptr; ifac = ifac->ifa_next)
+    if(ifac->ifa_flags & IFF_MULTICAST
+       && ifac->ifa_addr
+       && ifac->ifa_addr->sa_family == AF_INET)
+      addresses.push_back(reinterpret_cast<sockaddr_in*>(ifac->ifa_addr)->sin_addr.s_addr);
+
+  freeifaddrs(addrs);
+  return true;
+}
+#endif
 
 UdpComm::UdpComm()
 {
@@ -282,7 +354,6 @@ int UdpComm::readLocal(char* data, int len)
   int size = sizeof(senderAddr);
 #else
   unsigned size = sizeof(senderAddr);
-  bool found = false;
 #endif
   int result = static_cast<int>(::recvfrom(sock, data, len, 0, reinterpret_cast<sockaddr*>(&senderAddr), &size));
   if(result <= 0)
@@ -290,26 +361,12 @@ int UdpComm::readLocal(char* data, int len)
   else
   {
 #ifndef WINDOWS
-    ifaddrs* addrs, *ifac;
-
-    if(getifaddrs(&addrs) < 0)
+    std::vector<in_addr_t> addresses;
+    if(!getLocalAddresses(addresses))
       return -1;
 
-    for(ifac = addrs; !found && ifac != nullptr; ifac = ifac->ifa_next)
-    {
-      if(ifac->ifa_flags & IFF_MULTICAST
-         && ifac->ifa_addr
-         && ifac->ifa_addr->sa_family == AF_INET)
-      {
-        if((reinterpret_cast<sockaddr_in*>(ifac->ifa_addr))->sin_addr.s_addr == senderAddr.sin_addr.s_addr)
-          found = true;
-      }
-    }
-
-    freeifaddrs(addrs);
-
     // no, packet comes from the outside -> ignore
-    return found ? result : -1;
+    return std::find(addresses.begin(), addresses.end(), senderAddr.sin_addr.s_addr) != addresses.end() ? result : -1;
 #else
     return result;
 #endif
@@ -319,13 +376,9 @@ int UdpComm::readLocal(char* data, int len)
 unsigned UdpComm::getLastReadTimestamp() const
 {
 #ifdef TARGET_ROBOT
-  ::timespec tsPacket, tsReal, tsMonotonic;
+  ::timespec tsPacket;
   VERIFY(::ioctl(sock, SIOCGSTAMPNS, &tsPacket) == 0);
-  clock_gettime(CLOCK_REALTIME, &tsReal);
-  clock_gettime(CLOCK_MONOTONIC, &tsMonotonic);
-  const long long timeInMonotonic = (tsPacket.tv_sec - tsReal.tv_sec + tsMonotonic.tv_sec) * 1000ll +
-                                    (tsPacket.tv_nsec - tsReal.tv_nsec + tsMonotonic.tv_nsec) / 1000000ll;
-  return static_cast<unsigned>(timeInMonotonic - Time::getSystemTimeBase());
+  return toSystemTime(tsPacket);
 #else
   return Time::getCurrentSystemTime();
 #endif
@@ -336,6 +389,178 @@ bool UdpComm::write(const char* data, const int len)
   return ::sendto(sock, data, len, 0, target, sizeof(sockaddr_in)) == len;
 }
 
+void UdpComm::reserveBatch(unsigned packets, unsigned size)
+{
+  ASSERT(packets > 0);
+  if(!batch)
+    batch = std::make_unique<Batch>();
+  batch->size = size;
+  batch->buffers.resize(packets * size);
+  batch->packets.resize(packets);
+#ifdef BATCHED_IO
+  static const int yes = 1;
+  if(-1 == setsockopt(sock, SOL_SOCKET, SO_TIMESTAMPNS, &yes, sizeof(yes)))
+    OUTPUT_ERROR("UdpComm: could not set SO_TIMESTAMPNS");
+  batch->messages.resize(packets);
+  batch->vectors.resize(packets);
+  batch->senders.resize(packets);
+  batch->controls.resize(packets * controlSize);
+#endif
+}
+
+int UdpComm::readBatch(bool localOnly)
+{
+  ASSERT(batch && !batch->packets.empty());
+  const unsigned capacity = static_cast<unsigned>(batch->packets.size());
+  int received = 0;
+
+#ifdef BATCHED_IO
+  for(unsigned i = 0; i < capacity; ++i)
+  {
+    batch->vectors[i] = {batch->buffers.data() + i * batch->size, batch->size};
+    msghdr& header = batch->messages[i].msg_hdr;
+    header.msg_name = &batch->senders[i];
+    header.msg_namelen = sizeof(sockaddr_in);
+    header.msg_iov = &batch->vectors[i];
+    header.msg_iovlen = 1;
+    header.msg_control = batch->controls.data() + i * controlSize;
+    header.msg_controllen = controlSize;
+    header.msg_flags = 0;
+  }
+
+  // MSG_WAITFORONE: Only wait for the first packet if the socket is blocking.
+  received = ::recvmmsg(sock, batch->messages.data(), capacity, MSG_WAITFORONE, nullptr);
+  if(received < 0)
+    return errno == EAGAIN || errno == EWOULDBLOCK ? 0 : -1;
+
+  const unsigned now = Time::getCurrentSystemTime();
+  for(int i = 0; i < received; ++i)
+  {
+    msghdr& header = batch->messages[i].msg_hdr;
+    Packet& packet = batch->packets[i];
+    packet.data = static_cast<const char*>(batch->vectors[i].iov_base);
+    packet.size = static_cast<int>(batch->messages[i].msg_len);
+    packet.ip = ntohl(batch->senders[i].sin_addr.s_addr);
+    packet.port = ntohs(batch->senders[i].sin_port);
+    packet.timestamp = now;
+    for(cmsghdr* control = CMSG_FIRSTHDR(&header); control; control = CMSG_NXTHDR(&header, control))
+      if(control->cmsg_level == SOL_SOCKET && control->cmsg_type == SCM_TIMESTAMPNS)
+      {
+        timespec tsPacket;
+        std::memcpy(&tsPacket, CMSG_DATA(control), sizeof(tsPacket));
+        packet.timestamp = toSystemTime(tsPacket);
+      }
+  }
+#else
+  for(; received < static_cast<int>(capacity); ++received)
+  {
+    // Do not block after the first packet.
+    if(received)
+    {
+#ifdef WINDOWS
+      u_long available = 0;
+      if(ioctlsocket(sock, FIONREAD, &available) || !available)
+#else
+      int available = 0;
+      if(ioctl(sock, FIONREAD, &available) || !available)
+#endif
+        break;
+    }
+
+    char* data = batch->buffers.data() + received * batch->size;
+    unsigned ip;
+    const int size = read(data, static_cast<int>(batch->size), ip);
+    if(size < 0)
+    {
+      if(received)
+        break;
+#ifdef WINDOWS
+      return WSAGetLastError() == WSAEWOULDBLOCK ? 0 : -1;
+#else
+      return errno == EAGAIN || errno == EWOULDBLOCK ? 0 : -1;
+#endif
+    }
+    batch->packets[received] = {data, std::min(size, static_cast<int>(batch->size)), ip, 0, Time::getCurrentSystemTime()};
+  }
+#endif
+
+#ifndef WINDOWS
+  if(localOnly && received > 0)
+  {
+    std::vector<in_addr_t> addresses;
+    if(!getLocalAddresses(addresses))
+      return -1;
+
+    // Keep only the packets that come from this host.
+    const auto end = std::remove_if(batch->packets.begin(), batch->packets.begin() + received, [&](const Packet& packet)
+    {
+      return std::find(addresses.begin(), addresses.end(), htonl(packet.ip)) == addresses.end();
+    });
+    received = static_cast<int>(end - batch->packets.begin());
+  }
+#else
+  static_cast<void>(localOnly);
+#endif
+
+  return received;
+}
+
+const UdpComm::Packet& UdpComm::getPacket(int index) const
+{
+  ASSERT(batch && index >= 0 && index < static_cast<int>(batch->packets.size()));
+  return batch->packets[index];
+}
+
+void UdpComm::queue(const char* data, const int len)
+{
+  if(!batch)
+    batch = std::make_unique<Batch>();
+  batch->queued.push_back({batch->queuedData.size(), len, *reinterpret_cast<sockaddr_in*>(target)});
+  batch->queuedData.insert(batch->queuedData.end(), data, data + len);
+}
+
+int UdpComm::flush()
+{
+  if(!batch || batch->queued.empty())
+    return 0;
+
+  int sent = 0;
+#ifdef BATCHED_IO
+  const std::size_t count = batch->queued.size();
+  batch->messages.resize(std::max(batch->messages.size(), count));
+  batch->vectors.resize(std::max(batch->vectors.size(), count));
+  for(std::size_t i = 0; i < count; ++i)
+  {
+    Batch::Queued& queued = batch->queued[i];
+    batch->vectors[i] = {batch->queuedData.data() + queued.offset, static_cast<std::size_t>(queued.size)};
+    msghdr& header = batch->messages[i].msg_hdr;
+    header = msghdr();
+    header.msg_name = &queued.target;
+    header.msg_namelen = sizeof(sockaddr_in);
+    header.msg_iov = &batch->vectors[i];
+    header.msg_iovlen = 1;
+  }
+
+  // sendmmsg might not send all packets at once.
+  while(sent < static_cast<int>(count))
+  {
+    const int result = ::sendmmsg(sock, batch->messages.data() + sent, static_cast<unsigned>(count - sent), 0);
+    if(result <= 0)
+      break;
+    sent += result;
+  }
+#else
+  for(const Batch::Queued& queued : batch->queued)
+    if(::sendto(sock, batch->queuedData.data() + queued.offset, queued.size, 0,
+                reinterpret_cast<const sockaddr*>(&queued.target), sizeof(sockaddr_in)) == queued.size)
+      ++sent;
+#endif
+
+  batch->queued.clear();
+  batch->queuedData.clear();
+  return sent;
+}
+
 std::string UdpComm::getWifiBroadcastAddress()
 {
   std::string wifiAddress;
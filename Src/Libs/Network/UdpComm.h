@@ -13,6 +13,7 @@ struct sockaddr_in;
 #define _WINSOCK_DEPRECATED_NO_WARNINGS
 #include <WinSock2.h>
 #endif
+#include <memory>
 #include <string>
 
 #ifdef WINDOWS
@@ -26,9 +27,23 @@ struct sockaddr_in;
  */
 class UdpComm
 {
+public:
+  /** A datagram read by \c readBatch. */
+  struct Packet
+  {
+    const char* data; /**< The payload. It stays valid until the next call of \c readBatch. */
+    int size; /**< The number of bytes received. */
+    unsigned ip; /**< The address of the sender (in host byte order). */
+    unsigned short port; /**< The port of the sender. */
+    unsigned timestamp; /**< When the datagram was received by the kernel (in B-Human system time). */
+  };
+
 private:
+  struct Batch;
+
   sockaddr* target;
   socket_t sock;
+  std::unique_ptr<Batch> batch; /**< The buffers for batched reading and writing. Created when first used. */
 
 public:
   UdpComm();
@@ -104,6 +119,43 @@ public:
    */
   bool write(const char* data, const int len);
 
+  /**
+   * The function preallocates the buffers used by \c readBatch.
+   * @param packets The maximum number of packets read at once.
+   * @param size The maximum size of a packet. Longer packets are truncated.
+   */
+  void reserveBatch(unsigned packets, unsigned size);
+
+  /**
+   * The function reads all packets that are available, but at most the
+   * number reserved. On Linux, a single system call is used. The packets
+   * can be accessed through \c getPacket.
+   * @param localOnly Only accept packets from this host.
+   * @return Number of packets received or -1 in case of an error.
+   */
+  int readBatch(bool localOnly = false);
+
+  /**
+   * The function returns a packet read by the last call of \c readBatch.
+   * @param index The index of the packet (< the number returned by \c readBatch).
+   * @return The packet.
+   */
+  const Packet& getPacket(int index) const;
+
+  /**
+   * The function queues a packet for the current target. It is sent by
+   * the next call of \c flush.
+   * @param data The payload, which is copied.
+   * @param len The number of bytes of the payload.
+   */
+  void queue(const char* data, const int len);
+
+  /**
+   * The function writes all queued packets. On Linux, a single system call is used.
+   * @return Number of packets written. The others are dropped.
+   */
+  int flush();
+
   static std::string getWifiBroadcastAddress();
 
 private:
@@ -88,6 +88,18 @@ public:
    */
   bool isRunning() const { return running; }
 
+  /**
+   * The function determines whether the thread uses the real time scheduler.
+   * @return Is its priority > 0?
+   */
+  bool isRealTime() const { return priority > 0; }
+
+  /**
+   * The function returns the scheduling priority the thread currently uses.
+   * @return The priority. Priorities > 0 use the real time scheduler.
+   */
+  int getCurrentPriority() const { return priority; }
+
   /**
    * The function returns the thread id.
    * @return The thread id. Only valid after the thread was started.
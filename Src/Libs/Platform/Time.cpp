@@ -1,4 +1,5 @@
 #include "Time.h"
+#include <chrono>
 #ifdef MACOS
 #include "Platform/BHAssert.h"
 #include <pthread.h>
@@ -129,3 +130,8 @@ unsigned long long Time::getCurrentThreadTime()
     threadTimebase = time - 1000000ll;
   return time - threadTimebase;
 }
+
+unsigned long long Time::getRealTimeInMicroseconds()
+{
+  return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
@@ -28,6 +28,14 @@ public:
    */
   static unsigned long long getCurrentThreadTime();
 
+  /**
+   * The function returns the time of a monotonic clock in microseconds. In
+   * contrast to the thread time, it also advances while the thread is not
+   * running. It is never the simulated time.
+   * @return The time in microseconds since an arbitrary point in the past.
+   */
+  static unsigned long long getRealTimeInMicroseconds();
+
   /** returns the time since aTime*/
   static int getTimeSince(unsigned aTime);
 
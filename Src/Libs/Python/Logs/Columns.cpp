@@ -0,0 +1,141 @@
+/**
+ * @file Columns.cpp
+ *
+ * This file implements the columnar extraction of fields from a log.
+ */
+
+#include "Columns.h"
+#include "Log.h"
+#include "Streaming/FieldPlan.h"
+#include <pybind11/numpy.h>
+#include <algorithm>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+
+namespace py = pybind11;
+
+py::dict extractColumns(Log& log, const std::string& thread, const std::string& representation,
+                        const std::vector<std::string>& fields, unsigned threads)
+{
+  // Find the ids the log uses for the representation and the FrameInfo.
+  const auto findId = [&log](const std::string& name)
+  {
+    const auto i = std::find(log.messageIDNames->begin(), log.messageIDNames->end(), "id" + name);
+    return i == log.messageIDNames->end() ? -1 : static_cast<int>(i - log.messageIDNames->begin());
+  };
+  const int representationId = findId(representation);
+  if(representationId < 0)
+    throw py::key_error("Log has no representation '" + representation + "'");
+  const int frameInfoId = findId("FrameInfo");
+
+  // Compile the plans before touching the log, so that errors are reported early.
+  std::vector<FieldPlan> plans;
+  plans.reserve(fields.size());
+  for(const std::string& field : fields)
+    plans.emplace_back(log.typeInfo, representation, field);
+  std::unique_ptr<FieldPlan> timePlan;
+  if(frameInfoId >= 0)
+  {
+    try
+    {
+      timePlan = std::make_unique<FieldPlan>(log.typeInfo, "FrameInfo", "time");
+    }
+    catch(const std::runtime_error&)
+    {
+      // Timestamps stay -1.
+    }
+  }
+
+  // Collect the messages of all frames of the thread that contain the representation.
+  struct Row
+  {
+    MessageQueue::Message representation;
+    MessageQueue::Message frameInfo;
+    bool hasFrameInfo;
+  };
+  std::vector<Row> rows;
+  rows.reserve(log.numberOfFrames);
+  bool inThread = false;
+  Row current{nullptr, nullptr, false};
+  bool hasRepresentation = false;
+  std::string threadName;
+  for(MessageQueue::Message message : log)
+  {
+    const MessageID id = log.id(message);
+    if(id == idFrameBegin)
+    {
+      message.bin() >> threadName;
+      inThread = threadName == thread;
+      hasRepresentation = current.hasFrameInfo = false;
+    }
+    else if(id == idFrameFinished)
+    {
+      if(inThread && hasRepresentation)
+        rows.push_back(current);
+      inThread = false;
+    }
+    else if(inThread)
+    {
+      // Like Frame, use the first message of a kind in a frame.
+      if(message.id() == representationId && !hasRepresentation)
+      {
+        current.representation = message;
+        hasRepresentation = true;
+      }
+      else if(message.id() == frameInfoId && !current.hasFrameInfo)
+      {
+        current.frameInfo = message;
+        current.hasFrameInfo = true;
+      }
+    }
+  }
+
+  // Allocate all arrays while holding the GIL.
+  py::array_t<long long> timestamps(static_cast<py::ssize_t>(rows.size()));
+  std::vector<py::array_t<double>> columns;
+  for(const FieldPlan& plan : plans)
+    columns.emplace_back(plan.getColumns() == 1 ? std::vector<py::ssize_t>{static_cast<py::ssize_t>(rows.size())}
+                                                : std::vector<py::ssize_t>{static_cast<py::ssize_t>(rows.size()), static_cast<py::ssize_t>(plan.getColumns())});
+  long long* timestampData = timestamps.mutable_data();
+  std::vector<double*> columnData;
+  for(py::array_t<double>& column : columns)
+    columnData.push_back(column.mutable_data());
+
+  const auto decode = [&](std::size_t begin, std::size_t end)
+  {
+    double time;
+    for(std::size_t i = begin; i < end; ++i)
+    {
+      const Row& row = rows[i];
+      timestampData[i] = timePlan && row.hasFrameInfo && timePlan->decode(row.frameInfo.data(), row.frameInfo.size(), &time)
+                         ? static_cast<long long>(time) : -1;
+      for(std::size_t j = 0; j < plans.size(); ++j)
+      {
+        double* values = columnData[j] + i * plans[j].getColumns();
+        if(!plans[j].decode(row.representation.data(), row.representation.size(), values))
+          std::fill(values, values + plans[j].getColumns(), std::numeric_limits<double>::quiet_NaN());
+      }
+    }
+  };
+
+  {
+    // The decoding only touches the log and the preallocated arrays.
+    py::gil_scoped_release release;
+    const std::size_t numOfThreads = std::clamp<std::size_t>(threads, 1, std::max<std::size_t>(rows.size(), 1));
+    const std::size_t chunkSize = (rows.size() + numOfThreads - 1) / numOfThreads;
+    std::vector<std::thread> workers;
+    for(std::size_t i = 1; i < numOfThreads; ++i)
+      workers.emplace_back(decode, std::min(i * chunkSize, rows.size()), std::min((i + 1) * chunkSize, rows.size()));
+    decode(0, std::min(chunkSize, rows.size()));
+    for(std::thread& worker : workers)
+      worker.join();
+  }
+
+  py::dict result;
+  result["timestamp"] = timestamps;
+  for(std::size_t i = 0; i < fields.size(); ++i)
+    result[py::str(fields[i])] = columns[i];
+  return result;
+}
@@ -0,0 +1,31 @@
+/**
+ * @file Columns.h
+ *
+ * This file declares the columnar extraction of fields from a log. Instead of
+ * converting each representation into a tree of records, the fields requested
+ * are decoded directly from the binary messages into NumPy arrays. Where the
+ * fields are located in a message is compiled once from the type info of the log.
+ */
+
+#pragma once
+
+#include <pybind11/pybind11.h>
+#include <string>
+#include <vector>
+
+class Log;
+
+/**
+ * Extracts fields of a representation from all frames of a thread.
+ * @param log The log.
+ * @param thread The name of the thread.
+ * @param representation The name of the representation.
+ * @param fields The paths of the fields.
+ * @param threads The number of threads used for decoding.
+ * @return A dictionary with an array "timestamp" (the time of the FrameInfo in the
+ *         same frame or -1) and one array per field. Each array has a row per frame
+ *         that contains the representation. Fields consisting of several values have
+ *         a column per value. Values that could not be decoded are NaN.
+ */
+pybind11::dict extractColumns(Log& log, const std::string& thread, const std::string& representation,
+                              const std::vector<std::string>& fields, unsigned threads);
@@ -9,6 +9,7 @@
 
 #pragma once
 
+#include "Columns.h"
 #include "Frame.h"
 #include "Platform/MemoryMappedFile.h"
 #include "Streaming/TypeInfo.h"
@@ -45,6 +46,8 @@ private:
   MessageID id(Message message) const;
 
   friend class Frame;
+  friend pybind11::dict extractColumns(Log& log, const std::string& thread, const std::string& representation,
+                                       const std::vector<std::string>& fields, unsigned threads);
   std::unique_ptr<MemoryMappedFile> file; /**< The memory mapped file if an uncompressed log was loaded from disk. */
   TypeInfo typeInfo;
   bool keepGoing = false;
@@ -7,6 +7,7 @@
  * @author Jan Fiedler
  */
 
+#include "Columns.h"
 #include "Log.h"
 #include "Frame.h"
 #include "Types.h"
@@ -96,6 +97,25 @@ Args:
     .def_readonly("playerNumber", &Log::playerNumber, "The player number of the log.")
     .def_readonly("suffix", &Log::suffix, "The suffix of the log.")
     .def("__len__", [](const Log& log) { return log.numberOfFrames; })
+    .def("extract", &extractColumns, R"bhdoc(Extracts fields of a representation from all frames of a thread.
+
+The fields are decoded directly from the log without creating records, which
+is much faster than iterating over the frames. Only fields of a fixed size can
+be extracted. Records (e.g. a pose) and arrays of a static size (e.g. joint
+angles) are flattened into several columns.
+
+Args:
+    thread: The name of the thread, e.g. "Cognition".
+    representation: The name of the representation, e.g. "RobotPose".
+    fields: The paths of the fields, e.g. ["translation.x", "rotation"].
+        Elements of arrays are selected by an index, e.g. "hypotheses[0].validity".
+    threads: The number of threads used for decoding.
+
+Returns:
+    A dict with the numpy array "timestamp" (the time of the FrameInfo in the same
+    frame or -1) and an array per field. Each array has a row per frame that
+    contains the representation. Values that could not be decoded are NaN.
+)bhdoc", py::arg("thread"), py::arg("representation"), py::arg("fields"), py::arg("threads") = 1)
     // The log is alive as long as a reference to a frame exists.
     .def("__iter__", &Log::iter, py::keep_alive<0, 1>()); // loop
 
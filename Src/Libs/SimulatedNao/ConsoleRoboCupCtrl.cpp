@@ -13,6 +13,7 @@
 #include "SimulatedNao/LocalConsole.h"
 #include "SimulatedNao/RemoteConsole.h"
 #include "SimulatedNao/Views/ConsoleView.h"
+#include "Framework/TaskPool.h"
 #include "Platform/File.h"
 #include "Platform/Time.h"
 #include "Streaming/FunctionList.h"
@@ -471,6 +472,16 @@ bool ConsoleRoboCupCtrl::executeConsoleCommand(std::string command, RobotConsole
     else
       printLn("Syntax Error");
   }
+  else if(buffer == "tp")
+  {
+    stream >> buffer;
+    if(buffer == "parallel")
+      TaskPool::setSequential(false);
+    else if(buffer == "sequential")
+      TaskPool::setSequential(true);
+    else
+      printLn("Syntax Error");
+  }
   else if(buffer == "sv")
   {
     stream >> buffer;
@@ -691,6 +702,7 @@ void ConsoleRoboCupCtrl::help(In& stream)
     list("  mvo <name> <x> <y> <z> [<rotx> <roty> <rotz>] : Move the object with the given name to the given position.", pattern, true);
   list("  robot ? | all | <name> {<name>} : Connect console to a set of active robots. Alternatively, double click on robot.", pattern, true);
   list("  st off | on : Switch simulation of time on or off.", pattern, true);
+  list("  tp parallel | sequential : Execute the data-parallel loops of modules in parallel or deterministically in the calling thread.", pattern, true);
   list("  # <text> : Comment.", pattern, true);
   list("Robot commands:", pattern, true);
   list("  bc [<red%> [<green%> [<blue%>]]] : Set the background color of all 3-D views.", pattern, true);
@@ -704,6 +716,7 @@ void ConsoleRoboCupCtrl::help(In& stream)
   list("  log save [<file>] : Save log file with given name or modified current log file name.", pattern, true);
   list("  log saveAudio [<file>] : Save audio data from log.", pattern, true);
   list("  log saveImages [raw] [onlyPlaying] [<takeEachNth>] [<dir>] : Save images from log.", pattern, true);
+  list("  log saveColumns <message> {<message>} [<file>] : Save messages of all frames from log as columns.", pattern, true);
   list("  log trim ( until <end frame> | from <start frame> | between <start frame> <end frame> ) : Keep only the given section of the log. 'current' can be used as frame as well.", pattern, true);
   list("  log ? [<pattern>] : Display information about log file.", pattern, true);
   list("  log load <file> | clear : Load log-file or clear all frames.", pattern, true);
@@ -961,6 +974,8 @@ void ConsoleRoboCupCtrl::createCompletion()
     "st on",
     "sv fast",
     "sv oracle",
+    "tp parallel",
+    "tp sequential",
     "vf force",
     "vp"
   };
@@ -993,6 +1008,7 @@ void ConsoleRoboCupCtrl::createCompletion()
   {
     completion.insert(std::string("log keep ") + TypeRegistry::getEnumName(i));
     completion.insert(std::string("log remove ") + TypeRegistry::getEnumName(i));
+    completion.insert(std::string("log saveColumns ") + TypeRegistry::getEnumName(i));
   }
 
   addCompletionFiles("log load ", std::string(File::getBHDir()) + "/Config/Logs/*.log");
@@ -9,6 +9,7 @@
 #pragma once
 
 #include "Platform/File.h"
+#include "ImageProcessing/ColorModelConversions.h"
 #include "ImageProcessing/Image.h"
 #include "ImageProcessing/PixelTypes.h"
 #include <QImage>
@@ -123,6 +124,52 @@ namespace ImageExport
   }
 }
 
+/**
+ * Camera images are converted directly into the scanlines of the exported
+ * image, because allocating a vector per pixel pair as the general version
+ * does is much slower than the conversion itself.
+ */
+template<>
+inline bool ImageExport::exportImage(const Image<PixelTypes::YUYVPixel>& image, QIODevice& outDevice, const ExportMode mode)
+{
+  QImage img(image.width * 2, image.height, mode == grayscale ? QImage::Format_Grayscale8 : QImage::Format_RGB888);
+  for(unsigned y = 0; y < image.height; ++y)
+  {
+    const PixelTypes::YUYVPixel* pSrc = image[y];
+    const PixelTypes::YUYVPixel* pEnd = pSrc + image.width;
+    unsigned char* p = img.scanLine(y);
+    switch(mode)
+    {
+      case rgb:
+        for(; pSrc != pEnd; ++pSrc, p += 6)
+        {
+          ColorModelConversions::fromYUVToRGB(pSrc->y0, pSrc->u, pSrc->v, p[0], p[1], p[2]);
+          ColorModelConversions::fromYUVToRGB(pSrc->y1, pSrc->u, pSrc->v, p[3], p[4], p[5]);
+        }
+        break;
+      case grayscale:
+        for(; pSrc != pEnd; ++pSrc)
+        {
+          *p++ = pSrc->y0;
+          *p++ = pSrc->y1;
+        }
+        break;
+      case raw:
+        for(; pSrc != pEnd; ++pSrc)
+        {
+          *p++ = pSrc->y0;
+          *p++ = pSrc->u;
+          *p++ = pSrc->v;
+          *p++ = pSrc->y1;
+          *p++ = pSrc->u;
+          *p++ = pSrc->v;
+        }
+        break;
+    }
+  }
+  return img.save(&outDevice, "PNG");
+}
+
 template<>
 inline bool ImageExport::exportImage(const Image<PixelTypes::GrayscaledPixel>& image, const std::string& fileName, const int imageNumber, const ExportMode mode)
 {
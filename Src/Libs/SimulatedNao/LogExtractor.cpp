@@ -23,6 +23,12 @@
 #include "Representations/Perception/ImagePreprocessing/ImageCoordinateSystem.h"
 #include "Representations/Sensing/FallDownState.h"
 #include "Framework/LoggingTools.h"
+#include "Framework/TaskPool.h"
+#include "Streaming/TypeInfo.h"
+#include <QBuffer>
+#include <algorithm>
+#include <atomic>
+#include <deque>
 #include <filesystem>
 
 /**
@@ -46,6 +52,9 @@
 // The extra comma for the last representation seems to be no problem.
 #define _DECLARE_REPRESENTATIONS_AND_MAP_LIST(type) { id##type, &the##type },
 
+/** The version of the file format written by saveColumns. */
+static const unsigned char columnsVersion = 1;
+
 LogExtractor::LogExtractor(LogPlayer& logPlayer) : logPlayer(logPlayer) {}
 
 bool LogExtractor::saveAudioFile(const std::string& fileName)
@@ -183,11 +192,72 @@ bool LogExtractor::saveImages(const std::string& path, const bool raw, const boo
 
   int skippedImageCount = 0;
 
+  /** An image that is exported in the background. */
+  struct Frame
+  {
+    CameraImage cameraImage; /**< The image if it was logged uncompressed or after decoding. */
+    JPEGImage jpegImage; /**< The image if it was logged compressed. */
+    OutBinaryMemory metaData; /**< The metadata stored in the file. */
+    std::string fileName; /**< The name of the file. */
+  };
+
+  // While the log is read in this thread, the images are decoded, converted,
+  // compressed, and written by the task pool. To limit the memory required,
+  // only a few images per thread in the pool are exported at the same time.
+  std::shared_ptr<TaskPool> taskPool = TaskPool::acquire();
+  const size_t maxNumOfTasks = 2 * taskPool->getConcurrency();
+  std::atomic<bool> written = true;
+
+  const auto exportFrame = [raw, &crcLut, &written](Frame& frame)
+  {
+    if(frame.jpegImage.timestamp)
+      frame.jpegImage.toCameraImage(frame.cameraImage);
+
+    // Write image
+    QBuffer buffer;
+    buffer.open(QIODevice::WriteOnly);
+    if(!ImageExport::exportImage(frame.cameraImage, buffer, raw ? ImageExport::raw : ImageExport::rgb))
+    {
+      written = false;
+      return;
+    }
+    QByteArray& data = buffer.buffer();
+
+    // Remove IEND chunk
+    data.chop(12);
+
+    // Write metadata
+    const unsigned int size = static_cast<unsigned int>(frame.metaData.size());
+    for(size_t i = 0; i < 4; i++)
+      data.append(reinterpret_cast<const char*>(&size)[3 - i]);
+    data.append("bhMn", 4);
+    data.append(frame.metaData.data(), static_cast<int>(frame.metaData.size()));
+    const unsigned int crc = CRC().update(crcLut, "bhMn", 4).update(crcLut, frame.metaData.data(), frame.metaData.size()).finish();
+    for(size_t i = 0; i < 4; i++)
+      data.append(reinterpret_cast<const char*>(&crc)[3 - i]);
+
+    // Write IEND chunk
+    const std::array<char, 12> endChunk{ 0, 0, 0, 0, 'I', 'E', 'N', 'D', char(0xae), char(0x42), char(0x60), char(0x82) };
+    data.append(endChunk.data(), static_cast<int>(endChunk.size()));
+
+    QFile qfile(frame.fileName.c_str());
+    if(!qfile.open(QIODevice::WriteOnly) || qfile.write(data) != data.size())
+      written = false;
+  };
+  std::deque<std::unique_ptr<TaskPool::Task>> tasks;
+
   // Use DECLARE_REPRESENTATIONS_AND_MAP as soon as the hack is no longer needed
-  return goThroughLog(
-           representations,
-           [&](const std::string&)
+  const bool finished = goThroughLog(
+                          representations,
+                          [&](const std::string&)
   {
+    // Each image is only considered once.
+    const bool isJPEG = theJPEGImage.timestamp != 0; // Assume that CameraImage and JPEGImage are not logged at the same time.
+    const unsigned timestamp = isJPEG ? theJPEGImage.timestamp : theCameraImage.timestamp;
+    if(!timestamp)
+      return true;
+    theJPEGImage.timestamp = theCameraImage.timestamp = 0;
+
     if(onlyPlaying &&
        (!theGameState.isPlaying() // isStateValid
         || theGameState.isPenalized() // isNotPenalized
@@ -195,60 +265,102 @@ bool LogExtractor::saveImages(const std::string& path, const bool raw, const boo
             && theFallDownState.state != FallDownState::staggering)/*isStanding*/))
       return true;
 
-    if(theJPEGImage.timestamp)
+    // Frame skipping: only count frames if they are from the upper camera so
+    // that always a pair of lower and upper frames is saved
+    if(theCameraInfo.camera == CameraInfo::upper && ++skippedImageCount == takeEachNthFrame)
+      skippedImageCount = 0;
+    if(skippedImageCount != 0)
+      return true;
+
+    // Copy everything the export needs, because the representations are
+    // overwritten while the log is read on.
+    std::shared_ptr<Frame> frame = std::make_shared<Frame>();
+    if(isJPEG)
     {
-      theJPEGImage.toCameraImage(theCameraImage); // Assume that CameraImage and JPEGImage are not logged at the same time.
-      theJPEGImage.timestamp = 0;
+      frame->jpegImage = theJPEGImage;
+      frame->jpegImage.timestamp = timestamp;
     }
+    else
+      frame->cameraImage = theCameraImage;
+    frame->metaData << theCameraInfo;
+    frame->metaData << theCameraMatrix;
+    frame->metaData << theImageCoordinateSystem;
+    frame->fileName = ImageExport::expandImageFileName(folderPath + TypeRegistry::getEnumName(theCameraInfo.camera), timestamp);
+
+    // Destroying a task waits for it.
+    if(tasks.size() == maxNumOfTasks)
+      tasks.pop_front();
+    tasks.emplace_back(taskPool->start([frame, &exportFrame] {exportFrame(*frame);}));
+    return true;
+  });
+  tasks.clear();
+  return finished && written;
+}
 
-    CameraImage* imageToExport = nullptr;
+bool LogExtractor::saveColumns(const std::string& fileName, const std::vector<MessageID>& messageIDs, const TypeInfo& typeInfo)
+{
+  /** The data of a message id in all frames. */
+  struct Column
+  {
+    std::vector<unsigned> offsets = {0}; /**< The offsets of the data of all frames and of the end. */
+    std::vector<char> data; /**< The data of all frames. */
+  };
 
-    if(theCameraImage.timestamp)
-      imageToExport = &theCameraImage;
+  std::vector<Column> columns(messageIDs.size());
+  std::vector<int> columnOf(numOfMessageIDs, -1);
+  for(size_t i = 0; i < messageIDs.size(); ++i)
+    columnOf[messageIDs[i]] = static_cast<int>(i);
 
-    if(imageToExport)
+  std::vector<std::string> threads;
+  std::vector<unsigned char> threadOfFrame;
+  unsigned char thread = 0;
+  for(MessageQueue::Message message : logPlayer)
+  {
+    const MessageID id = logPlayer.id(message);
+    if(id == idFrameBegin)
     {
-      // Frame skipping: only count frames if they are from the upper camera so
-      // that always a pair of lower and upper frames is saved
-      if(theCameraInfo.camera == CameraInfo::upper && ++skippedImageCount == takeEachNthFrame)
-        skippedImageCount = 0;
-      if(skippedImageCount != 0)
-        return true;
-
-      // Open PNG file
-      const std::string filename = ImageExport::expandImageFileName(folderPath + TypeRegistry::getEnumName(theCameraInfo.camera), imageToExport->timestamp);
-      QFile qfile(filename.c_str());
-      qfile.open(QIODevice::WriteOnly);
-
-      // Write image
-      ImageExport::exportImage(*imageToExport, qfile, raw ? ImageExport::raw : ImageExport::rgb);
-      imageToExport->timestamp = 0;
-
-      // Remove IEND chunk
-      qfile.resize(qfile.size() - 12);
-
-      // Write metadata
-      OutBinaryMemory metaData;
-      metaData << theCameraInfo;
-      metaData << theCameraMatrix;
-      metaData << theImageCoordinateSystem;
-      const unsigned int size = static_cast<unsigned int>(metaData.size());
-      for(size_t i = 0; i < 4; i++)
-        qfile.putChar(reinterpret_cast<const char*>(&size)[3 - i]);
-      qfile.write("bhMn");
-      qfile.write(metaData.data(), metaData.size());
-      const unsigned int crc = CRC().update(crcLut, "bhMn", 4).update(crcLut, metaData.data(), metaData.size()).finish();
-      for(size_t i = 0; i < 4; i++)
-        qfile.putChar(reinterpret_cast<const char*>(&crc)[3 - i]);
-
-      // Write IEND chunk
-      const std::array<char, 12> endChunk{ 0, 0, 0, 0, 'I', 'E', 'N', 'D', char(0xae), char(0x42), char(0x60), char(0x82) };
-      qfile.write(endChunk.data(), endChunk.size());
-      qfile.close();
+      std::string threadName;
+      message.bin() >> threadName;
+      thread = static_cast<unsigned char>(std::find(threads.begin(), threads.end(), threadName) - threads.begin());
+      if(thread == threads.size())
+        threads.emplace_back(threadName);
     }
+    else if(id == idFrameFinished)
+    {
+      threadOfFrame.push_back(thread);
+      for(Column& column : columns)
+        column.offsets.push_back(static_cast<unsigned>(column.data.size()));
+    }
+    else if(id < numOfMessageIDs && columnOf[id] >= 0)
+    {
+      // Replace the data if the message was already logged in this frame.
+      Column& column = columns[columnOf[id]];
+      column.data.resize(column.offsets.back());
+      column.data.insert(column.data.end(), message.data(), message.data() + message.size());
+    }
+  }
 
-    return true;
-  });
+  OutBinaryFile stream(fileName);
+  if(!stream.exists())
+    return false;
+
+  stream << columnsVersion;
+  stream << (logPlayer.getTypeInfo() ? *logPlayer.getTypeInfo() : typeInfo);
+  stream << static_cast<unsigned>(threads.size());
+  for(const std::string& threadName : threads)
+    stream << threadName;
+  stream << static_cast<unsigned>(threadOfFrame.size());
+  stream.write(threadOfFrame.data(), threadOfFrame.size());
+  stream << static_cast<unsigned>(columns.size());
+  for(size_t i = 0; i < columns.size(); ++i)
+  {
+    // Data of an unfinished frame at the end of the log is not written.
+    const Column& column = columns[i];
+    stream << std::string(TypeRegistry::getEnumName(messageIDs[i]) + 2);
+    stream.write(column.offsets.data(), column.offsets.size() * sizeof(unsigned));
+    stream.write(column.data.data(), column.offsets.back());
+  }
+  return true;
 }
 
 bool LogExtractor::analyzeRobotStatus()
@@ -13,9 +13,11 @@
 #include <functional>
 #include <map>
 #include <string>
+#include <vector>
 
 class LogPlayer;
 class Streamable;
+struct TypeInfo;
 
 /**
  * @class LogExtractor
@@ -43,6 +45,8 @@ public:
 
   /**
    * Writes all images in the log player queue to a bunch of image files (.png).
+   * The log is read in the calling thread, while the images are decoded,
+   * converted, and written by the task pool.
    * @param path The path of the directory in which the images are created.
    * @param raw Save color unconverted
    * @param onlyPlaying Only save images from an upright, playing robot
@@ -51,6 +55,26 @@ public:
    */
   bool saveImages(const std::string& path, bool raw, bool onlyPlaying, int takeEachNthFrame);
 
+  /**
+   * Writes selected messages of all frames to a file in which they are stored
+   * by column, i.e. each message id is stored in a single block. A frame is
+   * counted as in the log player, so the rows can be matched with "log goto".
+   * The file contains:
+   * - A version number (unsigned char).
+   * - The type information of the messages.
+   * - The names of the threads and the thread of each frame as index into
+   *   them (unsigned char).
+   * - For each selected message: the name of the type, the offsets of the
+   *   data of all frames and of the end (unsigned), and the data. The data
+   *   of a frame is empty if the message was not logged in that frame.
+   * @param fileName The name of the file to write.
+   * @param messageIDs The messages exported. If a message is logged more than
+   *                   once in a frame, the last one is exported.
+   * @param typeInfo The type information used if the log did not contain any.
+   * @return Was writing the file successful?
+   */
+  bool saveColumns(const std::string& fileName, const std::vector<MessageID>& messageIDs, const TypeInfo& typeInfo);
+
   /**
    * Analyze if the measured joint angles are jumping, which indicates defect sensors.
    * @return true if analyzing was successful
@@ -12,6 +12,7 @@
 #include "Framework/Settings.h"
 #include "Platform/File.h"
 #include "Streaming/Global.h"
+#include <algorithm>
 #include <filesystem>
 #include <snappy-c.h>
 #ifdef WINDOWS
@@ -57,64 +58,129 @@ void LogPlayer::writeMessageIDs(Out& stream)
     stream << name;
 }
 
-void LogPlayer::updateIndices()
+unsigned LogPlayer::hash(const char* data, size_t size)
 {
-  frameIndex.clear();
-  framesHaveImage.clear();
-  statsPerThread.clear();
-  annotationsPerThread.clear();
+  // FNV-1a over the size and the bytes at the beginning and the end of the log.
+  static const size_t sampleSize = 65536;
+  unsigned hash = 2166136261u;
+  const auto add = [&hash](const char* begin, const char* end)
+  {
+    for(const char* p = begin; p < end; ++p)
+      hash = (hash ^ static_cast<unsigned char>(*p)) * 16777619u;
+  };
+  add(reinterpret_cast<const char*>(&size), reinterpret_cast<const char*>(&size) + sizeof(size));
+  add(data, data + std::min(size, sampleSize));
+  add(data + size - std::min(size, sampleSize), data + size);
+  return hash;
+}
 
-  size_t frame = 0;
-  const_iterator lastFrame = begin();
-  bool hasImage = anyFrameHasImage = false;
-  std::string currentThread;
-  for(auto i = begin(); i != end(); ++i)
+size_t LogPlayer::completeSize(const char* data, size_t size)
+{
+  size_t used = 0;
+  while(used + sizeof(MessageHeader) <= size
+        && sizeof(MessageHeader) + reinterpret_cast<const MessageHeader*>(data + used)->size <= size - used)
+    used += sizeof(MessageHeader) + reinterpret_cast<const MessageHeader*>(data + used)->size;
+  return used;
+}
+
+void LogPlayer::updateIndices(bool append)
+{
+  // Messages were only appended if the ones indexed are still the same.
+  size_t start = 0;
+  if(append && sizeWhenIndexWasComputed && sizeWhenIndexWasComputed < size()
+     && hash(data(), sizeWhenIndexWasComputed) == hashWhenIndexWasComputed)
+    start = sizeWhenIndexWasComputed; // Only index the frames appended.
+  else
+  {
+    frameIndex.clear();
+    framesHaveImage.clear();
+    statsPerThread.clear();
+    annotationsPerThread.clear();
+    anyFrameHasImage = false;
+    indexState = IndexState();
+  }
+
+  // Continue with the state after the last complete frame. The statistics of
+  // the current thread are cached to avoid looking them up for each message.
+  IndexState state = indexState;
+  size_t end = start;
+  const auto getStats = [this](const std::string& thread) -> std::vector<std::pair<size_t, size_t>>&
+  {
+    auto i = statsPerThread.find(thread);
+    if(i == statsPerThread.end())
+      i = statsPerThread.insert({thread, std::vector<std::pair<size_t, size_t>>(mapLogToID.size())}).first;
+    return i->second;
+  };
+  std::vector<std::pair<size_t, size_t>>* stats = nullptr;
+  for(auto i = begin() + start; i != this->end(); ++i)
   {
     auto message = *i;
     switch(id(message))
     {
       case idFrameBegin:
-        frame = i - begin();
-        (*i).bin() >> currentThread;
-        hasImage = false;
+        state.frame = i - begin();
+        message.bin() >> state.thread;
+        state.hasImage = false;
+        stats = nullptr;
         break;
       case idFrameFinished:
-        ASSERT(frameIndex.empty() || frameIndex.back() != frame);
-        frameIndex.push_back(frame);
-        framesHaveImage.push_back(hasImage);
-        lastFrame = i;
+        ASSERT(frameIndex.empty() || frameIndex.back() != state.frame);
+        frameIndex.push_back(state.frame);
+        framesHaveImage.push_back(state.hasImage);
         break;
       case idCameraImage:
       case idJPEGImage:
-        hasImage = anyFrameHasImage = true;
+        state.hasImage = anyFrameHasImage = true;
         break;
       case idAnnotation:
       {
-        AnnotationInfo::AnnotationData& annotation = annotationsPerThread[currentThread].emplace_back();
+        AnnotationInfo::AnnotationData& annotation = annotationsPerThread[state.thread].emplace_back();
         annotation.read(*i);
         annotation.frame = static_cast<unsigned>(frameIndex.size());
       }
     }
 
-    auto j = statsPerThread.find(currentThread);
-    if(j == statsPerThread.end())
-      j = statsPerThread.insert({currentThread, std::vector<std::pair<size_t, size_t>>(mapLogToID.size())}).first;
-    auto& stat = j->second[message.id()];
+    if(!stats)
+      stats = &getStats(state.thread);
+    auto& stat = (*stats)[message.id()];
     ++stat.first;
-    stat.second +=  sizeof(MessageHeader) + message.size();
+    stat.second += sizeof(MessageHeader) + message.size();
+
+    if(id(message) == idFrameFinished)
+    {
+      end = (i - begin()) + sizeof(MessageHeader) + message.size();
+      indexState = state;
+    }
   }
 
   // If the last frame is not complete, drop partial information.
-  resize(lastFrame == 0 ? 0 : ++lastFrame - begin());
+  state = indexState;
+  stats = nullptr;
+  for(auto i = begin() + end; i != this->end(); ++i)
+  {
+    auto message = *i;
+    if(id(message) == idFrameBegin)
+    {
+      message.bin() >> state.thread;
+      stats = nullptr;
+    }
+    if(!stats)
+      stats = &getStats(state.thread);
+    auto& stat = (*stats)[message.id()];
+    --stat.first;
+    stat.second -= sizeof(MessageHeader) + message.size();
+  }
+  resize(end);
 
   for(auto& [_, annotations] : annotationsPerThread)
     while(!annotations.empty() && annotations.back().frame == frameIndex.size())
       annotations.pop_back();
 
   sizeWhenIndexWasComputed = size();
+  hashWhenIndexWasComputed = hash(data(), size());
 }
 
-bool LogPlayer::readIndices(In& stream, size_t& usedSize)
+bool LogPlayer::readIndices(In& stream, const char* data, size_t& usedSize)
 {
   unsigned char chunk;
   unsigned char version;
@@ -122,7 +188,12 @@ bool LogPlayer::readIndices(In& stream, size_t& usedSize)
   if(chunk != LoggingTools::logFileIndices || version != indexVersion)
     return false;
 
-  stream >> reinterpret_cast<unsigned*>(&usedSize)[0] >> reinterpret_cast<unsigned*>(&usedSize)[1];
+  size_t indexedSize;
+  unsigned indexedHash;
+  stream >> reinterpret_cast<unsigned*>(&indexedSize)[0] >> reinterpret_cast<unsigned*>(&indexedSize)[1] >> indexedHash;
+  if(indexedSize > usedSize || indexedHash != hash(data, indexedSize)) // The log was changed without updating the indices.
+    return false;
+  usedSize = indexedSize; // An incomplete frame at the end is not indexed.
 
   unsigned size = 0;
   stream >> size;
@@ -167,7 +238,9 @@ bool LogPlayer::readIndices(In& stream, size_t& usedSize)
     }
   }
 
+  indexState = IndexState();
   sizeWhenIndexWasComputed = usedSize;
+  hashWhenIndexWasComputed = indexedHash;
 
   return true;
 }
@@ -175,40 +248,45 @@ bool LogPlayer::readIndices(In& stream, size_t& usedSize)
 void LogPlayer::writeIndices(Out& stream) const
 {
   if(sizeWhenIndexWasComputed != size())
-    const_cast<LogPlayer*>(this)->updateIndices();
+    const_cast<LogPlayer*>(this)->updateIndices(true);
 
-  stream << static_cast<unsigned char>(LoggingTools::logFileIndices) << indexVersion;
+  OutBinaryMemory index;
+  index << static_cast<unsigned char>(LoggingTools::logFileIndices) << indexVersion;
 
-  stream << static_cast<unsigned>(size()) << static_cast<unsigned>(size() >> 32);
+  index << static_cast<unsigned>(size()) << static_cast<unsigned>(size() >> 32) << hashWhenIndexWasComputed;
 
-  stream << static_cast<unsigned>(frameIndex.size());
+  index << static_cast<unsigned>(frameIndex.size());
   std::vector<size_t> offsets;
   offsets.reserve(frameIndex.size());
   for(size_t i = 0; i < frameIndex.size(); ++i)
     offsets.push_back(frameIndex[i] | (framesHaveImage[i] ? 1ull << 63 : 0));
-  stream.write(offsets.data(), offsets.size() * sizeof(offsets[0]));
+  index.write(offsets.data(), offsets.size() * sizeof(offsets[0]));
 
-  stream << static_cast<unsigned>(statsPerThread.size());
+  index << static_cast<unsigned>(statsPerThread.size());
   for(const auto& [threadName, stats] : statsPerThread)
   {
-    stream << threadName;
-    stream << static_cast<unsigned>(stats.size());
-    stream.write(stats.data(), stats.size() * sizeof(stats[0]));
+    index << threadName;
+    index << static_cast<unsigned>(stats.size());
+    index.write(stats.data(), stats.size() * sizeof(stats[0]));
   }
 
-  stream << static_cast<unsigned>(annotationsPerThread.size());
+  index << static_cast<unsigned>(annotationsPerThread.size());
   for(const auto& [threadName, annotations] : annotationsPerThread)
   {
-    stream << threadName << static_cast<unsigned>(annotations.size());
+    index << threadName << static_cast<unsigned>(annotations.size());
     for(const AnnotationInfo::AnnotationData& annotation : annotations)
-      stream << annotation.annotationNumber << annotation.frame << annotation.name << annotation.annotation;
+      index << annotation.annotationNumber << annotation.frame << annotation.name << annotation.annotation;
   }
+
+  // The size at the end allows to check whether the index is complete.
+  stream.write(index.data(), index.size());
+  stream << static_cast<unsigned>(index.size());
 }
 
 std::pair<size_t, size_t> LogPlayer::statOf(MessageID id, const std::string& threadName) const
 {
   if(sizeWhenIndexWasComputed != size())
-    const_cast<LogPlayer*>(this)->updateIndices();
+    const_cast<LogPlayer*>(this)->updateIndices(true);
 
   const MessageID logId = mapIDToLog[id];
   if(threadName.empty())
@@ -250,6 +328,8 @@ void LogPlayer::clear()
   annotationsPerThread.clear();
   currentFrame = 0;
   sizeWhenIndexWasComputed = 0;
+  hashWhenIndexWasComputed = 0;
+  indexState = IndexState();
 }
 
 bool LogPlayer::open(const std::string& fileName)
@@ -304,30 +384,47 @@ bool LogPlayer::open(const std::string& fileName)
           size_t usedSize = header.sizeLow | static_cast<size_t>(header.sizeHigh) << 32;
           const size_t position = stream.getPosition();
           size_t remainingSize = stream.getSize() - position;
-          bool hasIndex = header.messages != 0x0fffffff && usedSize != remainingSize;
-          if(hasIndex)
+
+          // Removes everything behind the messages from the file.
+          const auto truncate = [&]
           {
-            stream.skip(usedSize);
-            if(!readIndices(stream, usedSize)) // Wrong index version -> remove index from file.
+            file = nullptr;
             {
-              file = nullptr;
-              {
-                File f(fileName, "rb+");
+              File f(fileName, "rb+");
 #ifdef WINDOWS
-                _chsize_s(_fileno(static_cast<FILE*>(f.getNativeFile())), position + usedSize);
+              _chsize_s(_fileno(static_cast<FILE*>(f.getNativeFile())), position + usedSize);
 #else
-                ftruncate(fileno(static_cast<FILE*>(f.getNativeFile())), position + usedSize);
+              ftruncate(fileno(static_cast<FILE*>(f.getNativeFile())), position + usedSize);
 #endif
-              }
-              remainingSize = usedSize;
+            }
+            remainingSize = usedSize;
+            file = std::make_unique<MemoryMappedFile>(fileName);
+          };
+
+          bool hasIndex = header.messages != 0x0fffffff && usedSize < remainingSize;
+          if(hasIndex)
+          {
+            // An index is only used if it ends exactly at the end of the file.
+            unsigned indexSize = 0;
+            if(remainingSize - usedSize >= sizeof(indexSize))
+              std::memcpy(&indexSize, file->getData() + file->getSize() - sizeof(indexSize), sizeof(indexSize));
+            stream.skip(usedSize);
+            if(remainingSize - usedSize != indexSize + sizeof(indexSize)
+               || !readIndices(stream, file->getData() + position, usedSize)) // Incomplete, outdated, or wrong index version -> remove index from file.
+            {
+              truncate();
               hasIndex = false;
-              file = std::make_unique<MemoryMappedFile>(fileName);
             }
           }
           if(!hasIndex) // No index -> create one and append it to file.
           {
-            if(header.messages == 0x0fffffff)
-              usedSize = remainingSize;
+            // The recording might have been interrupted or the file was truncated.
+            if(header.messages == 0x0fffffff || usedSize > remainingSize)
+            {
+              usedSize = completeSize(file->getData() + position, remainingSize);
+              if(usedSize < remainingSize)
+                truncate();
+            }
 
             setBuffer(file->getData() + position, usedSize);
             updateIndices();
@@ -347,6 +444,7 @@ bool LogPlayer::open(const std::string& fileName)
             }
 
             file = std::make_unique<MemoryMappedFile>(fileName); // reopen file
+            usedSize = sizeWhenIndexWasComputed; // An incomplete frame at the end is not indexed.
           }
           setBuffer(file->getData() + position, usedSize);
           this->file = std::move(file);
@@ -411,7 +509,7 @@ void LogPlayer::filter(const std::function<bool(const_iterator)>& keep)
 const std::unordered_map<std::string, std::vector<AnnotationInfo::AnnotationData>>& LogPlayer::annotations() const
 {
   if(sizeWhenIndexWasComputed != size())
-    const_cast<LogPlayer*>(this)->updateIndices();
+    const_cast<LogPlayer*>(this)->updateIndices(true);
 
   return annotationsPerThread;
 }
@@ -33,7 +33,7 @@
 
 class LogPlayer : public MessageQueue
 {
-  static const unsigned char indexVersion = 2; /**< The version of the index chunk. */
+  static const unsigned char indexVersion = 4; /**< The version of the index chunk. */
   MessageQueue& target; /**< The queue played back messages are copied to. */
   std::string path; /**< The file system path to the log file. */
   std::unique_ptr<MemoryMappedFile> file; /**< The memory mapped file if an uncompressed log was loaded from disk. */
@@ -48,6 +48,16 @@ class LogPlayer : public MessageQueue
   std::unordered_map<std::string, std::vector<std::pair<size_t, size_t>>> statsPerThread; /**< How often is each message id present in each thread and how much space is used? */
   std::unordered_map<std::string, std::vector<AnnotationInfo::AnnotationData>> annotationsPerThread; /**< Annotations per thread. */
   size_t sizeWhenIndexWasComputed = 0; /**< Remembers the size of the message queue when the indices were computed. */
+  unsigned hashWhenIndexWasComputed = 0; /**< Remembers the hash of the message queue when the indices were computed. */
+
+  /** The state of indexing after the last complete frame. */
+  struct IndexState
+  {
+    size_t frame = 0; /**< The byte offset of the last frame begun. */
+    bool hasImage = false; /**< Does the last frame begun contain an image? */
+    std::string thread; /**< The name of the thread of the last frame begun. */
+  };
+  IndexState indexState; /**< The state to continue indexing with if messages are appended. */
   size_t currentFrame = -1; /**< The current frame, i.e. the one that was last played back. */
 
   /**
@@ -63,25 +73,49 @@ class LogPlayer : public MessageQueue
    */
   void writeMessageIDs(Out& stream);
 
+  /**
+   * Calculates a hash that identifies the messages of a log.
+   * @param data The messages.
+   * @param size The number of bytes of the messages.
+   * @return The hash.
+   */
+  static unsigned hash(const char* data, size_t size);
+
+  /**
+   * Determines how many bytes of a log contain complete messages. The
+   * recording of a log might have been interrupted or the file was truncated.
+   * @param data The messages.
+   * @param size The number of bytes available.
+   * @return The number of bytes up to the end of the last complete message.
+   */
+  static size_t completeSize(const char* data, size_t size);
+
   /**
    * Update the indices, i.e. \c frameIndex , \c framesHaveImage ,
    * \c statsPerThread , and \c annotationsPerThread. In addition,
    * \c anyFrameHasImage and \c sizeWhenIndexWasComputed are updated as well.
    * If the last frame in the log is not complete, the queue is resized to
    * discard that frame.
+   * @param append Were messages possibly only appended since the indices were
+   *               updated last? If so and the messages indexed are unchanged,
+   *               only the new messages are indexed.
    */
-  void updateIndices();
+  void updateIndices(bool append = false);
 
   /**
    * Load the indices from a stream, i.e. \c frameIndex , \c framesHaveImage ,
    * \c statsPerThread , and \c annotationsPerThread. In addition,
-   * \c anyFrameHasImage and \c sizeWhenIndexWasComputed are updated as well.
+   * \c anyFrameHasImage , \c sizeWhenIndexWasComputed , and
+   * \c hashWhenIndexWasComputed are updated as well.
    * @param stream The stream to read from.
-   * @param usedSize The size of that queue that contains complete frames. It is expected
-   *                 that the queue will be resized to this value.
-   * @return Could the indices be read? If not, they had the wrong format.
+   * @param data The messages the indices are for.
+   * @param usedSize The size of the messages. It is replaced by the size of the
+   *                 part that contains complete frames. It is expected that the
+   *                 queue will be resized to this value.
+   * @return Could the indices be read? If not, they had the wrong format or
+   *         do not match the messages.
    */
-  bool readIndices(In& stream, size_t& usedSize);
+  bool readIndices(In& stream, const char* data, size_t& usedSize);
 
   /**
    * Write the indices to a stream.
@@ -236,6 +270,13 @@ public:
    */
   std::string threadOf(size_t frame) const;
 
+  /**
+   * Returns the type information of the log file entries.
+   * @return The type information or \c nullptr if the log file did not
+   *         contain any, i.e. the entries have the current types.
+   */
+  const TypeInfo* getTypeInfo() const {return typeInfo.get();}
+
   /** Request that the type information will be inserted into the target queue. */
   void requestTypeInfo() {typeInfoRequested = true;}
 };
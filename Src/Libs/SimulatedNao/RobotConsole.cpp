@@ -894,6 +894,20 @@ bool RobotConsole::handleMessage(MessageQueue::Message message)
       incompleteImages[id].timestamp = Time::getCurrentSystemTime();
       break;
     }
+    case idDebugImageCompressed:
+    {
+      std::string id;
+      CompressedDebugImage compressed;
+      stream >> id >> compressed;
+      ImagePtr& imagePtr = incompleteImages[id];
+      if(!imagePtr.image)
+        imagePtr.image = new DebugImage();
+      if(debugImageDecoder.decode(id, compressed, *imagePtr.image))
+        imagePtr.timestamp = Time::getCurrentSystemTime();
+      else if(!imagePtr.timestamp)
+        incompleteImages.erase(id);
+      break;
+    }
     case idDebugResponse:
     {
       std::string description;
@@ -1579,6 +1593,44 @@ bool RobotConsole::log(In& stream)
 
       return logExtractor.saveAudioFile(File::isAbsolute(option) ? option : "Sounds/" + option);
     }
+    else if(command == "saveColumns")
+    {
+      // The last parameter is the file name if it is not a message id.
+      std::vector<MessageID> messageIDs;
+      std::string fileName;
+      while(!option.empty())
+      {
+        MessageID messageID = undefined;
+        FOREACH_ENUM(MessageID, i, numOfDataMessageIDs)
+          if(option == TypeRegistry::getEnumName(i))
+            messageID = i;
+        std::string next;
+        stream >> next;
+        if(messageID != undefined)
+          messageIDs.push_back(messageID);
+        else if(next.empty())
+          fileName = option;
+        else
+          return false;
+        option = next;
+      }
+      if(messageIDs.empty())
+        return false;
+
+      if(fileName.empty())
+      {
+        std::string::size_type pos = logFile.rfind('.');
+        if(pos == std::string::npos)
+          return false;
+        else
+          fileName = logFile.substr(0, pos) + "_Columns";
+      }
+      if(!File::hasExtension(fileName))
+        fileName += ".columns";
+
+      SYNC;
+      return logExtractor.saveColumns(File::isAbsolute(fileName) ? fileName : "Logs/" + fileName, messageIDs, typeInfo);
+    }
     else if(command == "keep" || command == "remove")
     {
       std::vector<MessageID> messageIDs;
@@ -13,6 +13,7 @@
 #endif
 
 #include "Debugging/DebugDrawings3D.h"
+#include "Debugging/DebugImageCodec.h"
 #include "Debugging/DebugImages.h"
 #include "Framework/ThreadFrame.h"
 #include "LogExtractor.h"
@@ -170,6 +171,7 @@ public:
   std::unordered_map<std::string, std::list<ImageViewCommand>> imageViewCommands; /**< Commands executed after a click per image view. */
   ModuleInfo moduleInfo; /**< The current state of all solution requests. */
   DebugImageConverter debugImageConverter; /**< Helper for all image view to convert debug images. */
+  DebugImageDecoder debugImageDecoder; /**< Decodes the compressed debug images sent by a remote robot. */
   ConsoleRoboCupCtrl* ctrl; /**< A pointer to the controller object. */
   SharedAutonomyRequest sharedAutonomyRequest; /**< The command sent to the robot */
   unsigned timeSharedAutonomyRequestSent = 0; /**< When was the command sent? Set to 0 to force sending immediately. */
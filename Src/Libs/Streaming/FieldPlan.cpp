@@ -0,0 +1,348 @@
+/**
+ * @file FieldPlan.cpp
+ *
+ * This file implements a class that locates a field in the binary
+ * representation of a type.
+ */
+
+#include "FieldPlan.h"
+#include "Streaming/TypeInfo.h"
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+/**
+ * Reads a value from a buffer that might not be aligned.
+ * @param p The address of the value.
+ * @return The value converted to a double.
+ */
+template<typename T> static double read(const char* p)
+{
+  T value;
+  std::memcpy(&value, p, sizeof(T));
+  return static_cast<double>(value);
+}
+
+FieldPlan::FieldPlan(const TypeInfo& typeInfo, const std::string& type, const std::string& path) :
+  typeInfo(typeInfo)
+{
+  std::string current = type;
+  getLayout(current);
+
+  std::size_t pending = 0;
+  const auto flush = [&]
+  {
+    if(pending)
+      steps.push_back({Step::skip, pending, 0});
+    pending = 0;
+  };
+
+  std::size_t start = 0;
+  while(start < path.size())
+  {
+    std::size_t end = path.find('.', start);
+    if(end == std::string::npos)
+      end = path.size();
+    const std::string component = path.substr(start, end - start);
+    start = end + 1;
+
+    // Select an attribute of a record.
+    const std::string name = component.substr(0, component.find('['));
+    if(!name.empty())
+    {
+      const auto c = typeInfo.classes.find(current);
+      if(c == typeInfo.classes.end())
+        throw std::runtime_error("Type " + current + " has no attribute '" + name + "'");
+      const TypeInfo::Attribute* found = nullptr;
+      for(const TypeInfo::Attribute& attribute : c->second)
+      {
+        if(attribute.name == name)
+        {
+          found = &attribute;
+          break;
+        }
+        const std::size_t layout = getLayout(attribute.type);
+        if(layouts[layout].kind == Layout::fixed)
+          pending += layouts[layout].size;
+        else
+        {
+          flush();
+          steps.push_back({Step::skipLayout, 0, layout});
+        }
+      }
+      if(!found)
+        throw std::runtime_error("Type " + current + " has no attribute '" + name + "'");
+      current = found->type;
+    }
+
+    // Select elements of arrays.
+    for(std::size_t bracket = component.find('['); bracket != std::string::npos; bracket = component.find('[', bracket + 1))
+    {
+      const std::size_t index = std::stoul(component.substr(bracket + 1));
+      if(current.back() == ']')
+      {
+        // Arrays of a static size are streamed without their size.
+        const std::size_t typeBracket = current.find_last_of('[');
+        if(index >= std::stoul(current.substr(typeBracket + 1)))
+          throw std::runtime_error("Index " + std::to_string(index) + " is out of range of " + current);
+        current = current.substr(0, typeBracket);
+        const std::size_t element = getLayout(current);
+        if(layouts[element].kind == Layout::fixed)
+          pending += index * layouts[element].size;
+        else if(index)
+        {
+          flush();
+          steps.push_back({Step::skipElements, index, element});
+        }
+      }
+      else if(current.back() == '*')
+      {
+        current = current.substr(0, current.size() - 1);
+        flush();
+        steps.push_back({Step::select, index, getLayout(current)});
+      }
+      else
+        throw std::runtime_error("Type " + current + " is not an array");
+    }
+  }
+  flush();
+
+  fieldSize = flatten(current, 0);
+}
+
+bool FieldPlan::getPrimitive(const std::string& type, Primitive& primitive, std::size_t& size)
+{
+  static const std::unordered_map<std::string, std::pair<Primitive, std::size_t>> primitives =
+  {
+    {"bool", {boolType, sizeof(char)}},
+    {"char", {charType, sizeof(char)}},
+    {"signed char", {signedCharType, sizeof(signed char)}},
+    {"unsigned char", {unsignedCharType, sizeof(unsigned char)}},
+    {"short", {shortType, sizeof(short)}},
+    {"unsigned short", {unsignedShortType, sizeof(unsigned short)}},
+    {"int", {intType, sizeof(int)}},
+    {"unsigned", {unsignedType, sizeof(unsigned)}},
+    {"unsigned int", {unsignedType, sizeof(unsigned)}},
+    {"float", {floatType, sizeof(float)}},
+    {"double", {doubleType, sizeof(double)}},
+    {"Angle", {floatType, sizeof(float)}}
+  };
+
+  const auto i = primitives.find(type);
+  if(i == primitives.end())
+    return false;
+  primitive = i->second.first;
+  size = i->second.second;
+  return true;
+}
+
+std::size_t FieldPlan::getLayout(const std::string& type)
+{
+  const auto i = layoutIndices.find(type);
+  if(i != layoutIndices.end())
+    return i->second;
+
+  Layout layout;
+  Primitive primitive;
+  if(type.back() == ']')
+  {
+    // Arrays of a static size are streamed without their size.
+    const std::size_t bracket = type.find_last_of('[');
+    const std::size_t count = std::stoul(type.substr(bracket + 1));
+    const std::size_t element = getLayout(type.substr(0, bracket));
+    if(layouts[element].kind == Layout::fixed)
+      layout.size = count * layouts[element].size;
+    else
+    {
+      layout.kind = Layout::staticArray;
+      layout.element = element;
+      layout.count = count;
+    }
+  }
+  else if(type.back() == '*')
+  {
+    layout.kind = Layout::array;
+    layout.element = getLayout(type.substr(0, type.size() - 1));
+  }
+  else if(type == "std::string")
+    layout.kind = Layout::string;
+  else if(getPrimitive(type, primitive, layout.size))
+    ;
+  else if(typeInfo.enums.find(type) != typeInfo.enums.end())
+    layout.size = sizeof(unsigned char);
+  else if(const auto c = typeInfo.classes.find(type); c != typeInfo.classes.end())
+  {
+    for(const TypeInfo::Attribute& attribute : c->second)
+    {
+      const std::size_t attributeLayout = getLayout(attribute.type);
+      layout.attributes.push_back(attributeLayout);
+      if(layouts[attributeLayout].kind == Layout::fixed)
+        layout.size += layouts[attributeLayout].size;
+      else
+        layout.kind = Layout::record;
+    }
+  }
+  else
+    throw std::runtime_error("Type " + type + " not found in the type info of the log");
+
+  layouts.push_back(layout);
+  layoutIndices[type] = layouts.size() - 1;
+  return layouts.size() - 1;
+}
+
+std::size_t FieldPlan::flatten(const std::string& type, std::size_t offset)
+{
+  std::size_t size;
+  Primitive primitive;
+  if(type.back() == ']')
+  {
+    const std::size_t bracket = type.find_last_of('[');
+    const std::size_t count = std::stoul(type.substr(bracket + 1));
+    for(std::size_t i = 0; i < count; ++i)
+      offset = flatten(type.substr(0, bracket), offset);
+    return offset;
+  }
+  else if(type.back() == '*' || type == "std::string")
+    throw std::runtime_error("Type " + type + " has no fixed size");
+  else if(getPrimitive(type, primitive, size))
+  {
+    values.push_back({offset, primitive});
+    return offset + size;
+  }
+  else if(typeInfo.enums.find(type) != typeInfo.enums.end())
+  {
+    values.push_back({offset, unsignedCharType});
+    return offset + sizeof(unsigned char);
+  }
+  else
+  {
+    for(const TypeInfo::Attribute& attribute : typeInfo.classes.find(type)->second)
+      offset = flatten(attribute.type, offset);
+    return offset;
+  }
+}
+
+const char* FieldPlan::skip(std::size_t index, const char* p, const char* end) const
+{
+  const Layout& layout = layouts[index];
+  switch(layout.kind)
+  {
+    case Layout::fixed:
+      return static_cast<std::size_t>(end - p) >= layout.size ? p + layout.size : nullptr;
+    case Layout::string:
+    case Layout::array:
+    {
+      unsigned count;
+      if(static_cast<std::size_t>(end - p) < sizeof(count))
+        return nullptr;
+      std::memcpy(&count, p, sizeof(count));
+      p += sizeof(count);
+      if(layout.kind == Layout::string)
+        return static_cast<std::size_t>(end - p) >= count ? p + count : nullptr;
+      const Layout& element = layouts[layout.element];
+      if(element.kind == Layout::fixed)
+        return static_cast<std::size_t>(end - p) / std::max<std::size_t>(element.size, 1) >= count ? p + count * element.size : nullptr;
+      for(unsigned i = 0; i < count && p; ++i)
+        p = skip(layout.element, p, end);
+      return p;
+    }
+    case Layout::staticArray:
+      for(std::size_t i = 0; i < layout.count && p; ++i)
+        p = skip(layout.element, p, end);
+      return p;
+    case Layout::record:
+      for(std::size_t attribute : layout.attributes)
+        if(!(p = skip(attribute, p, end)))
+          return nullptr;
+      return p;
+  }
+  return nullptr;
+}
+
+bool FieldPlan::decode(const char* data, std::size_t size, double* row) const
+{
+  const char* p = data;
+  const char* const end = data + size;
+  for(const Step& step : steps)
+  {
+    if(step.kind == Step::skip)
+    {
+      if(static_cast<std::size_t>(end - p) < step.value)
+        return false;
+      p += step.value;
+    }
+    else if(step.kind == Step::skipLayout)
+    {
+      if(!(p = skip(step.layout, p, end)))
+        return false;
+    }
+    else if(step.kind == Step::skipElements)
+    {
+      for(std::size_t i = 0; i < step.value; ++i)
+        if(!(p = skip(step.layout, p, end)))
+          return false;
+    }
+    else
+    {
+      unsigned count;
+      if(static_cast<std::size_t>(end - p) < sizeof(count))
+        return false;
+      std::memcpy(&count, p, sizeof(count));
+      p += sizeof(count);
+      if(step.value >= count)
+        return false;
+      const Layout& element = layouts[step.layout];
+      if(element.kind == Layout::fixed)
+      {
+        if(static_cast<std::size_t>(end - p) < step.value * element.size)
+          return false;
+        p += step.value * element.size;
+      }
+      else
+        for(std::size_t i = 0; i < step.value; ++i)
+          if(!(p = skip(step.layout, p, end)))
+            return false;
+    }
+  }
+
+  if(static_cast<std::size_t>(end - p) < fieldSize)
+    return false;
+  for(const Value& value : values)
+  {
+    const char* v = p + value.offset;
+    switch(value.primitive)
+    {
+      case boolType:
+        *row++ = *v ? 1.0 : 0.0;
+        break;
+      case charType:
+        *row++ = read<char>(v);
+        break;
+      case signedCharType:
+        *row++ = read<signed char>(v);
+        break;
+      case unsignedCharType:
+        *row++ = read<unsigned char>(v);
+        break;
+      case shortType:
+        *row++ = read<short>(v);
+        break;
+      case unsignedShortType:
+        *row++ = read<unsigned short>(v);
+        break;
+      case intType:
+        *row++ = read<int>(v);
+        break;
+      case unsignedType:
+        *row++ = read<unsigned>(v);
+        break;
+      case floatType:
+        *row++ = read<float>(v);
+        break;
+      case doubleType:
+        *row++ = read<double>(v);
+        break;
+    }
+  }
+  return true;
+}
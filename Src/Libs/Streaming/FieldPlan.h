@@ -0,0 +1,138 @@
+/**
+ * @file FieldPlan.h
+ *
+ * This file declares a class that locates a field in the binary representation
+ * of a type as described by a type info, e.g. the one of a log. Where the field
+ * is located is compiled once, so that it can be decoded from many messages
+ * quickly, e.g. to extract the field from all frames of a log.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+struct TypeInfo;
+
+/** A compiled description of how to find a field in the binary representation of a type. */
+class FieldPlan
+{
+public:
+  /**
+   * Compiles the plan.
+   * @param typeInfo The type info of the log.
+   * @param type The type the messages contain (i.e. the name of the representation).
+   * @param path The path to the field, e.g. "translation.x" or "hypotheses[0].validity".
+   *             The field must have a fixed size. Records and arrays of a static size
+   *             are flattened into several columns.
+   * @throws std::runtime_error The path cannot be resolved.
+   */
+  FieldPlan(const TypeInfo& typeInfo, const std::string& type, const std::string& path);
+
+  /** Returns the number of values the field consists of. */
+  std::size_t getColumns() const {return values.size();}
+
+  /**
+   * Decodes the field from a message.
+   * @param data The start of the message payload.
+   * @param size The size of the message payload.
+   * @param row The array that receives getColumns() values.
+   * @return Was the field found inside the message?
+   */
+  bool decode(const char* data, std::size_t size, double* row) const;
+
+private:
+  enum Primitive : unsigned char
+  {
+    boolType,
+    charType,
+    signedCharType,
+    unsignedCharType,
+    shortType,
+    unsignedShortType,
+    intType,
+    unsignedType,
+    floatType,
+    doubleType,
+  };
+
+  /** The binary layout of a type. */
+  struct Layout
+  {
+    enum Kind : unsigned char
+    {
+      fixed, /**< The type always has the same size. */
+      string, /**< A string (size followed by characters). */
+      array, /**< An array with a variable size (size followed by elements). */
+      staticArray, /**< An array with a static size whose elements have a variable size (only elements). */
+      record, /**< A record with at least one attribute of a variable size. */
+    } kind = fixed;
+    std::size_t size = 0; /**< The size of the type if it is fixed. */
+    std::size_t element = 0; /**< The layout of the elements if it is an array. */
+    std::size_t count = 0; /**< The number of elements if it is an array with a static size. */
+    std::vector<std::size_t> attributes; /**< The layouts of the attributes if it is a record. */
+  };
+
+  /** A step to reach the field. */
+  struct Step
+  {
+    enum Kind : unsigned char
+    {
+      skip, /**< Skip a number of bytes. */
+      skipLayout, /**< Skip a value of a variable size. */
+      select, /**< Skip to an element of an array with a variable size. */
+      skipElements, /**< Skip a number of elements of a variable size. */
+    } kind;
+    std::size_t value; /**< The number of bytes or elements to skip or the index of the element to select. */
+    std::size_t layout; /**< The layout to skip or the layout of the array elements. */
+  };
+
+  /** A primitive value of the field. */
+  struct Value
+  {
+    std::size_t offset; /**< The offset relative to the start of the field. */
+    Primitive primitive; /**< The type of the value. */
+  };
+
+  /**
+   * Determines the primitive type and the size of a type name.
+   * @param type The name of the type.
+   * @param primitive The primitive type if it is one.
+   * @param size The size of the type in a binary stream.
+   * @return Is the type a primitive type of a fixed size?
+   */
+  static bool getPrimitive(const std::string& type, Primitive& primitive, std::size_t& size);
+
+  /**
+   * Returns the index of the layout of a type. It is created if it does not exist yet.
+   * @param type The name of the type.
+   * @return The index in \c layouts.
+   */
+  std::size_t getLayout(const std::string& type);
+
+  /**
+   * Adds all primitive values of a type of a fixed size to \c values.
+   * @param type The name of the type.
+   * @param offset The offset of the type relative to the start of the field.
+   * @return The offset behind the type.
+   */
+  std::size_t flatten(const std::string& type, std::size_t offset);
+
+  /**
+   * Skips a value.
+   * @param layout The layout of the value.
+   * @param p The start of the value.
+   * @param end The end of the message.
+   * @return The address behind the value or \c nullptr if the message is too short.
+   */
+  const char* skip(std::size_t layout, const char* p, const char* end) const;
+
+  const TypeInfo& typeInfo; /**< The type info of the log. */
+  std::vector<Layout> layouts; /**< The layouts of all types required. */
+  std::unordered_map<std::string, std::size_t> layoutIndices; /**< The indices of the layouts by type names. */
+  std::vector<Step> steps; /**< The steps to reach the field. */
+  std::vector<Value> values; /**< The primitive values the field consists of. */
+  std::size_t fieldSize = 0; /**< The size of the field. */
+};
@@ -15,3 +15,4 @@ thread_local DrawingManager* Global::theDrawingManager = nullptr;
 thread_local DrawingManager3D* Global::theDrawingManager3D = nullptr;
 thread_local TimingManager* Global::theTimingManager = nullptr;
 thread_local asmjit::JitRuntime* Global::theAsmjitRuntime = nullptr;
+thread_local TaskPool* Global::theTaskPool = nullptr;
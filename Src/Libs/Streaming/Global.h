@@ -16,6 +16,7 @@ class DebugDataTable;
 class DrawingManager;
 class DrawingManager3D;
 class ReleaseOptions;
+class TaskPool;
 class TimingManager;
 namespace asmjit
 {
@@ -41,6 +42,7 @@ private:
   static thread_local DrawingManager3D* theDrawingManager3D;
   static thread_local TimingManager* theTimingManager;
   static thread_local asmjit::JitRuntime* theAsmjitRuntime;
+  static thread_local TaskPool* theTaskPool;
 
 public:
   /**
@@ -103,13 +105,26 @@ public:
    */
   static TimingManager& getTimingManager() { return *theTimingManager; }
 
+  /**
+   * The method returns whether the timing manager was already instantiated.
+   * @return Is it safe to use getTimingManager()?
+   */
+  static bool timingManagerExists() {return theTimingManager != nullptr;}
+
   /**
    * The method returns a reference to the thread wide instance.
    * @return the instance of the asmjit runtime in this thread.
    */
   static asmjit::JitRuntime& getAsmjitRuntime() { return *theAsmjitRuntime; }
 
+  /**
+   * The method returns a reference to the process wide instance.
+   * @return the task pool shared by all threads.
+   */
+  static TaskPool& getTaskPool() { return *theTaskPool; }
+
   friend class ThreadFrame; // The class ThreadFrame can set these pointers.
   friend class ConsoleRoboCupCtrl; // The class ConsoleRoboCupCtrl can set theSettings.
   friend class RobotConsole; // The class RobotConsole can set theDebugOut.
+  friend class TaskPool; // The class TaskPool installs the pointers of the calling thread in its workers.
 };
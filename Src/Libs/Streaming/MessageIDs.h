@@ -121,6 +121,7 @@ ENUM(MessageID,
   idDebugDrawing,
   idDebugDrawing3D,
   idDebugImage,
+  idDebugImageCompressed,
   idDebugRequest,
   idDebugResponse,
   idDrawingManager,
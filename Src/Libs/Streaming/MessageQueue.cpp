@@ -46,6 +46,7 @@ size_t MessageQueue::calcMaxCapacity(MessageID id) const
   constexpr unsigned unprotected = bit(idDebugDrawing - numOfDataMessageIDs)
     | bit(idDebugDrawing3D - numOfDataMessageIDs)
     | bit(idDebugImage - numOfDataMessageIDs)
+    | bit(idDebugImageCompressed - numOfDataMessageIDs)
     | bit(idPlot - numOfDataMessageIDs)
     | bit(idText - numOfDataMessageIDs);
 
@@ -119,7 +120,7 @@ void MessageQueue::read(In& stream)
 
 void MessageQueue::write(Out& stream) const
 {
-  const QueueHeader header = {used, 0, used >> 32};
+  const QueueHeader header = getHeader();
   stream.write(&header, sizeof(header));
   append(stream);
 }
@@ -175,6 +175,12 @@ public:
      */
     size_t size() const {return reinterpret_cast<const MessageHeader*>(buffer)->size;}
 
+    /**
+     * Returns the message's payload.
+     * @return The address of the first byte behind the \c MessageHeader .
+     */
+    const char* data() const {return buffer + sizeof(MessageHeader);}
+
     /**
      * Returns a stream that allows reading the message in binary format.
      * @return The binary stream.
@@ -307,6 +313,12 @@ public:
    */
   void resize(size_t size);
 
+  /**
+   * Returns the maximum capacity of the queue.
+   * @return The capacity in bytes.
+   */
+  size_t getMaxCapacity() const {return maxCapacity;}
+
   /**
    * Is the queue empty?
    * @return Is it?
@@ -349,6 +361,20 @@ public:
    */
   void append(Out& stream) const;
 
+  /**
+   * Returns the header that precedes the messages when the queue is streamed.
+   * Together with \c data() , it allows sending the queue without streaming
+   * it into another buffer first.
+   * @return The header.
+   */
+  QueueHeader getHeader() const {return {used, 0, used >> 32};}
+
+  /**
+   * Returns the memory block containing the messages.
+   * @return The address of the first of \c size() bytes.
+   */
+  const char* data() const {return buffer;}
+
   /**
    * Filters messages based on a used-defined criterion.
    * @param keep A function that returns whether a message should be kept. The
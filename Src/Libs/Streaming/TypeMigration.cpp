@@ -0,0 +1,467 @@
+/**
+ * @file TypeMigration.cpp
+ *
+ * This file implements a class that converts binary data streamed with an older
+ * specification of a type into the binary format of its current specification.
+ */
+
+#include "TypeMigration.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+
+/** The sizes of the primitive types in the binary format. */
+static const std::size_t primitiveSizes[] = {1, 1, 1, 1, 2, 2, 4, 4, 4, 8, 0, 1};
+
+template<typename T> bool TypeMigration::Reader::read(T& value)
+{
+  if(static_cast<std::size_t>(end - data) < sizeof(T))
+    return false;
+  std::memcpy(&value, data, sizeof(T));
+  data += sizeof(T);
+  return true;
+}
+
+/**
+ * Writes a number clipped to the range of its new type.
+ * @param value The number.
+ * @param target The stream the number is written to.
+ */
+template<typename T> static void writeNumber(double value, Out& target)
+{
+  T result;
+  if constexpr(std::is_floating_point<T>::value)
+    result = static_cast<T>(value);
+  else if(std::isnan(value))
+    result = 0;
+  else
+    result = static_cast<T>(std::clamp(value, static_cast<double>(std::numeric_limits<T>::lowest()),
+                                       static_cast<double>(std::numeric_limits<T>::max())));
+  target.write(&result, sizeof(result));
+}
+
+TypeMigration::TypeMigration(const TypeInfo& source, const TypeInfo& target, const std::string& type,
+                             const std::vector<Scaling>& scalings)
+{
+  root = compile(source, target, type, type, 1.0, scalings);
+  sourceLayouts.clear();
+  targetLayouts.clear();
+}
+
+TypeMigration::Primitive TypeMigration::getPrimitive(const TypeInfo& typeInfo, const std::string& type)
+{
+  if(typeInfo.enums.find(type) != typeInfo.enums.end())
+    return enumType;
+  else if(typeInfo.primitives.find(type) == typeInfo.primitives.end())
+    return numOfPrimitives;
+  else if(type == "bool")
+    return boolType;
+  else if(type == "char")
+    return charType;
+  else if(type == "signed char")
+    return signedCharType;
+  else if(type == "unsigned char")
+    return unsignedCharType;
+  else if(type == "short")
+    return shortType;
+  else if(type == "unsigned short")
+    return unsignedShortType;
+  else if(type == "int")
+    return intType;
+  else if(type == "unsigned" || type == "unsigned int")
+    return unsignedType;
+  else if(type == "float" || type == "Angle")
+    return floatType;
+  else if(type == "double")
+    return doubleType;
+  else if(type == "std::string")
+    return stringType;
+  else
+    return numOfPrimitives;
+}
+
+int TypeMigration::createLayout(const TypeInfo& typeInfo, const std::string& type, std::unordered_map<std::string, int>& cache)
+{
+  const auto i = cache.find(type);
+  if(i != cache.end())
+    return i->second;
+
+  Layout layout;
+  if(!type.empty() && (type.back() == ']' || type.back() == '*'))
+  {
+    const bool isStatic = type.back() == ']';
+    const std::size_t endOfType = isStatic ? type.find_last_of('[') : type.size() - 1;
+    const int element = createLayout(typeInfo, type.substr(0, endOfType), cache);
+    if(element < 0)
+      return -1;
+    layout.kind = isStatic ? Layout::staticArray : Layout::dynamicArray;
+    layout.count = isStatic ? std::strtoul(type.c_str() + endOfType + 1, nullptr, 10) : 0;
+    layout.isFixed = isStatic && layouts[element].isFixed;
+    layout.size = layout.isFixed ? layout.count * layouts[element].size : 0;
+    layout.children.push_back(element);
+  }
+  else if(typeInfo.classes.find(type) != typeInfo.classes.end())
+  {
+    layout.kind = Layout::structure;
+    layout.isFixed = true;
+    layout.size = 0;
+    for(const TypeInfo::Attribute& attribute : typeInfo.classes.find(type)->second)
+    {
+      const int child = createLayout(typeInfo, attribute.type, cache);
+      if(child < 0)
+        return -1;
+      layout.isFixed &= layouts[child].isFixed;
+      layout.size += layouts[child].size;
+      layout.children.push_back(child);
+    }
+    if(!layout.isFixed)
+      layout.size = 0;
+  }
+  else
+  {
+    const Primitive primitive = getPrimitive(typeInfo, type);
+    if(primitive == numOfPrimitives)
+      return -1;
+    layout.kind = primitive == stringType ? Layout::string : Layout::fixed;
+    layout.isFixed = primitive != stringType;
+    layout.size = primitiveSizes[primitive];
+  }
+
+  layouts.push_back(layout);
+  cache[type] = static_cast<int>(layouts.size() - 1);
+  return static_cast<int>(layouts.size() - 1);
+}
+
+int TypeMigration::compile(const TypeInfo& source, const TypeInfo& target, const std::string& sourceType, const std::string& targetType,
+                           double factor, const std::vector<Scaling>& scalings)
+{
+  Step step;
+  step.sourceLayout = createLayout(source, sourceType, sourceLayouts);
+  step.targetLayout = createLayout(target, targetType, targetLayouts);
+  if(step.sourceLayout < 0 || step.targetLayout < 0)
+    return -1;
+
+  const Layout::Kind sourceKind = layouts[step.sourceLayout].kind;
+  const Layout::Kind targetKind = layouts[step.targetLayout].kind;
+  if(target.areTypesEqual(source, targetType, sourceType))
+    step.kind = Step::copy;
+  else if(sourceKind != targetKind)
+    step.kind = Step::keep;
+  else if(sourceKind == Layout::staticArray || sourceKind == Layout::dynamicArray)
+  {
+    const std::size_t sourceEnd = sourceKind == Layout::staticArray ? sourceType.find_last_of('[') : sourceType.size() - 1;
+    const std::size_t targetEnd = targetKind == Layout::staticArray ? targetType.find_last_of('[') : targetType.size() - 1;
+    step.element = compile(source, target, sourceType.substr(0, sourceEnd), targetType.substr(0, targetEnd), factor, scalings);
+    if(step.element < 0)
+      return -1;
+    step.kind = sourceKind == Layout::staticArray ? Step::staticArray : Step::dynamicArray;
+    if(step.kind == Step::dynamicArray)
+      appendZero(layouts[step.targetLayout].children[0], step.zero);
+  }
+  else if(sourceKind == Layout::structure)
+  {
+    const std::vector<TypeInfo::Attribute>& sourceAttributes = source.classes.find(sourceType)->second;
+    const std::vector<TypeInfo::Attribute>& targetAttributes = target.classes.find(targetType)->second;
+    std::vector<int> matches(targetAttributes.size(), -1);
+    std::vector<bool> used(sourceAttributes.size(), false);
+    for(std::size_t i = 0; i < targetAttributes.size(); ++i)
+      for(std::size_t j = 0; j < sourceAttributes.size(); ++j)
+        if(targetAttributes[i].name == sourceAttributes[j].name)
+        {
+          matches[i] = static_cast<int>(j);
+          used[j] = true;
+          break;
+        }
+
+    // An attribute was renamed if an unused one with the same type is found at the same position.
+    for(std::size_t i = 0; i < targetAttributes.size(); ++i)
+      if(matches[i] < 0 && i < sourceAttributes.size() && !used[i]
+         && target.areTypesEqual(source, targetAttributes[i].type, sourceAttributes[i].type))
+      {
+        matches[i] = static_cast<int>(i);
+        used[i] = true;
+      }
+
+    step.kind = Step::structure;
+    int previous = -1;
+    for(std::size_t i = 0; i < targetAttributes.size(); ++i)
+    {
+      int child;
+      if(matches[i] < 0)
+      {
+        Step keep;
+        keep.kind = Step::keep;
+        keep.sourceLayout = -1;
+        keep.targetLayout = createLayout(target, targetAttributes[i].type, targetLayouts);
+        steps.push_back(keep);
+        child = static_cast<int>(steps.size() - 1);
+      }
+      else
+      {
+        double attributeFactor = factor;
+        for(const Scaling& scaling : scalings)
+          if(scaling.type == targetType && scaling.attribute == targetAttributes[i].name)
+            attributeFactor = scaling.factor;
+        child = compile(source, target, sourceAttributes[matches[i]].type, targetAttributes[i].type, attributeFactor, scalings);
+        if(child < 0)
+          return -1;
+        step.inOrder &= matches[i] > previous;
+        previous = matches[i];
+      }
+      step.attributes.emplace_back(matches[i], child);
+    }
+  }
+  else
+  {
+    step.from = getPrimitive(source, sourceType);
+    step.to = getPrimitive(target, targetType);
+    if(step.from == enumType && step.to == enumType)
+    {
+      step.kind = Step::enumeration;
+      const std::vector<std::string>& sourceConstants = source.enums.find(sourceType)->second;
+      const std::vector<std::string>& targetConstants = target.enums.find(targetType)->second;
+      for(const std::string& constant : sourceConstants)
+      {
+        const auto i = std::find(targetConstants.begin(), targetConstants.end(), constant);
+        step.constants.push_back(i == targetConstants.end() ? -1 : static_cast<int>(i - targetConstants.begin()));
+      }
+    }
+    else if(step.from < stringType && step.to < stringType)
+    {
+      step.kind = Step::number;
+      step.factor = factor;
+    }
+    else
+      step.kind = Step::keep;
+  }
+
+  steps.push_back(step);
+  return static_cast<int>(steps.size() - 1);
+}
+
+void TypeMigration::appendZero(int layout, std::vector<char>& zero) const
+{
+  const Layout& l = layouts[layout];
+  if(l.isFixed)
+    zero.insert(zero.end(), l.size, 0);
+  else if(l.kind == Layout::string || l.kind == Layout::dynamicArray)
+    zero.insert(zero.end(), sizeof(unsigned), 0);
+  else if(l.kind == Layout::staticArray)
+    for(std::size_t i = 0; i < l.count; ++i)
+      appendZero(l.children[0], zero);
+  else
+    for(const int child : l.children)
+      appendZero(child, zero);
+}
+
+bool TypeMigration::skip(int layout, Reader& reader) const
+{
+  const Layout& l = layouts[layout];
+  if(l.isFixed)
+    return reader.skip(l.size);
+
+  switch(l.kind)
+  {
+    case Layout::string:
+    {
+      unsigned size;
+      return reader.read(size) && reader.skip(size);
+    }
+    case Layout::staticArray:
+      for(std::size_t i = 0; i < l.count; ++i)
+        if(!skip(l.children[0], reader))
+          return false;
+      return true;
+    case Layout::dynamicArray:
+    {
+      unsigned count;
+      if(!reader.read(count))
+        return false;
+      const Layout& element = layouts[l.children[0]];
+      if(element.isFixed)
+        return reader.skip(count * element.size);
+      for(unsigned i = 0; i < count; ++i)
+        if(!skip(l.children[0], reader))
+          return false;
+      return true;
+    }
+    default:
+      for(const int child : l.children)
+        if(!skip(child, reader))
+          return false;
+      return true;
+  }
+}
+
+bool TypeMigration::copy(int layout, Reader& reader, Out& target) const
+{
+  const char* const start = reader.data;
+  if(!skip(layout, reader))
+    return false;
+  target.write(start, reader.data - start);
+  return true;
+}
+
+bool TypeMigration::apply(const void* source, std::size_t sourceSize, const void* current, std::size_t currentSize, Out& target) const
+{
+  Reader sourceReader = {static_cast<const char*>(source), static_cast<const char*>(source) + sourceSize};
+  Reader currentReader = {static_cast<const char*>(current), static_cast<const char*>(current) + currentSize};
+  return root >= 0 && apply(root, sourceReader, currentReader, target);
+}
+
+bool TypeMigration::apply(int step, Reader& source, Reader& current, Out& target) const
+{
+  const Step& s = steps[step];
+  switch(s.kind)
+  {
+    case Step::copy:
+      return copy(s.sourceLayout, source, target) && skip(s.targetLayout, current);
+
+    case Step::keep:
+      return (s.sourceLayout < 0 || skip(s.sourceLayout, source)) && copy(s.targetLayout, current, target);
+
+    case Step::number:
+    {
+      double value;
+      bool b;
+      char c;
+      signed char sc;
+      unsigned char uc;
+      short sh;
+      unsigned short ush;
+      int i;
+      unsigned u;
+      float f;
+      bool complete;
+      switch(s.from)
+      {
+        case boolType: complete = source.read(b); value = b; break;
+        case charType: complete = source.read(c); value = c; break;
+        case signedCharType: complete = source.read(sc); value = sc; break;
+        case unsignedCharType: complete = source.read(uc); value = uc; break;
+        case shortType: complete = source.read(sh); value = sh; break;
+        case unsignedShortType: complete = source.read(ush); value = ush; break;
+        case intType: complete = source.read(i); value = i; break;
+        case unsignedType: complete = source.read(u); value = u; break;
+        case floatType: complete = source.read(f); value = f; break;
+        default: complete = source.read(value);
+      }
+      if(!complete || !current.skip(primitiveSizes[s.to]))
+        return false;
+      if(s.from != s.to)
+        value *= s.factor;
+      switch(s.to)
+      {
+        case boolType: b = value != 0.0; target.write(&b, sizeof(b)); break;
+        case charType: writeNumber<char>(value, target); break;
+        case signedCharType: writeNumber<signed char>(value, target); break;
+        case unsignedCharType: writeNumber<unsigned char>(value, target); break;
+        case shortType: writeNumber<short>(value, target); break;
+        case unsignedShortType: writeNumber<unsigned short>(value, target); break;
+        case intType: writeNumber<int>(value, target); break;
+        case unsignedType: writeNumber<unsigned>(value, target); break;
+        case floatType: writeNumber<float>(value, target); break;
+        default: writeNumber<double>(value, target);
+      }
+      return true;
+    }
+
+    case Step::enumeration:
+    {
+      unsigned char value;
+      unsigned char currentValue;
+      if(!source.read(value) || !current.read(currentValue))
+        return false;
+      if(value < s.constants.size() && s.constants[value] >= 0)
+        currentValue = static_cast<unsigned char>(s.constants[value]);
+      target.write(&currentValue, sizeof(currentValue));
+      return true;
+    }
+
+    case Step::staticArray:
+    {
+      const Layout& sourceLayout = layouts[s.sourceLayout];
+      const Layout& targetLayout = layouts[s.targetLayout];
+      const std::size_t count = std::min(sourceLayout.count, targetLayout.count);
+      for(std::size_t i = 0; i < count; ++i)
+        if(!apply(s.element, source, current, target))
+          return false;
+      for(std::size_t i = count; i < targetLayout.count; ++i)
+        if(!copy(targetLayout.children[0], current, target))
+          return false;
+      for(std::size_t i = count; i < sourceLayout.count; ++i)
+        if(!skip(sourceLayout.children[0], source))
+          return false;
+      return true;
+    }
+
+    case Step::dynamicArray:
+    {
+      unsigned sourceCount;
+      unsigned currentCount;
+      if(!source.read(sourceCount) || !current.read(currentCount))
+        return false;
+      target.write(&sourceCount, sizeof(sourceCount));
+      const unsigned count = std::min(sourceCount, currentCount);
+      for(unsigned i = 0; i < count; ++i)
+        if(!apply(s.element, source, current, target))
+          return false;
+      for(unsigned i = count; i < sourceCount; ++i)
+      {
+        Reader zero = {s.zero.data(), s.zero.data() + s.zero.size()};
+        if(!apply(s.element, source, zero, target))
+          return false;
+      }
+      for(unsigned i = count; i < currentCount; ++i)
+        if(!skip(layouts[s.targetLayout].children[0], current))
+          return false;
+      return true;
+    }
+
+    default:
+    {
+      const std::vector<int>& sourceAttributes = layouts[s.sourceLayout].children;
+      if(s.inOrder)
+      {
+        // Skip the old attributes that are not used on the way.
+        int next = 0;
+        for(const auto& [attribute, child] : s.attributes)
+        {
+          for(; next < attribute; ++next)
+            if(!skip(sourceAttributes[next], source))
+              return false;
+          if(!apply(child, source, current, target))
+            return false;
+          if(attribute >= 0)
+            ++next;
+        }
+        for(; next < static_cast<int>(sourceAttributes.size()); ++next)
+          if(!skip(sourceAttributes[next], source))
+            return false;
+        return true;
+      }
+      else
+      {
+        // Determine where each old attribute starts.
+        std::vector<Reader> starts;
+        starts.reserve(sourceAttributes.size());
+        for(const int attribute : sourceAttributes)
+        {
+          starts.push_back(source);
+          if(!skip(attribute, source))
+            return false;
+        }
+        for(const auto& [attribute, child] : s.attributes)
+        {
+          Reader reader = attribute >= 0 ? starts[attribute] : source;
+          if(!apply(child, reader, current, target))
+            return false;
+        }
+        return true;
+      }
+    }
+  }
+}
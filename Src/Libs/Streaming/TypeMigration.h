@@ -0,0 +1,225 @@
+/**
+ * @file TypeMigration.h
+ *
+ * This file declares a class that converts binary data streamed with an older
+ * specification of a type into the binary format of its current specification.
+ * The specifications are compared once and compiled into a plan of steps,
+ * which is then applied to each message directly on the binary data:
+ *
+ * - Parts that are equal in both specifications are copied as they are.
+ * - Attributes are matched by name. An attribute that is not found is
+ *   assumed to be renamed if the attribute at the same position in the old
+ *   specification has an equal type and is not used otherwise.
+ * - Attributes only present in the old specification are dropped.
+ * - Attributes only present in the current specification, or whose types
+ *   are incompatible, keep their current values.
+ * - Numbers are converted between all primitive numeric types, clipping
+ *   them to the range of the new type. Optionally, they are scaled.
+ * - Enumeration constants are mapped by name. Unknown constants keep the
+ *   current value.
+ * - Arrays are resized. Elements that are missing in the old data keep their
+ *   current values or, in dynamic arrays, are zero.
+ */
+
+#pragma once
+
+#include "Streaming/TypeInfo.h"
+#include <cstddef>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class TypeMigration
+{
+public:
+  /** A factor that numbers of an attribute are multiplied with if their primitive type has changed. */
+  struct Scaling
+  {
+    std::string type; /**< The name of the class the attribute belongs to. */
+    std::string attribute; /**< The name of the attribute. */
+    double factor; /**< The factor. */
+  };
+
+  /**
+   * Compiles the plan to convert a type.
+   * @param source The type information the data was streamed with.
+   * @param target The type information the data is converted to.
+   * @param type The name of the type in both type informations.
+   * @param scalings Numbers that are scaled when converted.
+   */
+  TypeMigration(const TypeInfo& source, const TypeInfo& target, const std::string& type,
+                const std::vector<Scaling>& scalings = {});
+
+  /**
+   * Could a plan be compiled, i.e. are all primitive types known?
+   * @return Can the plan be applied?
+   */
+  bool isValid() const {return root >= 0;}
+
+  /**
+   * Converts binary data.
+   * @param source The data in the old format.
+   * @param sourceSize The number of bytes of the data in the old format.
+   * @param current The current values in the new format. They are used for
+   *                all parts that cannot be converted.
+   * @param currentSize The number of bytes of the current values.
+   * @param target The stream the converted data is written to.
+   * @return Was the data complete? If not, the output is incomplete.
+   */
+  bool apply(const void* source, std::size_t sourceSize, const void* current, std::size_t currentSize, Out& target) const;
+
+private:
+  /** The primitive types that can be converted. */
+  enum Primitive : unsigned char
+  {
+    boolType,
+    charType,
+    signedCharType,
+    unsignedCharType,
+    shortType,
+    unsignedShortType,
+    intType,
+    unsignedType,
+    floatType,
+    doubleType,
+    stringType,
+    enumType,
+    numOfPrimitives
+  };
+
+  /** How the size of a value in the binary format is determined. */
+  struct Layout
+  {
+    enum Kind : unsigned char {fixed, string, staticArray, dynamicArray, structure};
+
+    Kind kind; /**< The kind of the value. */
+    bool isFixed; /**< Is the size of the value always the same? */
+    std::size_t size; /**< The size in bytes if it is fixed. */
+    std::size_t count; /**< The number of elements of a static array. */
+    std::vector<int> children; /**< The element layout of arrays or the attribute layouts of a structure. */
+  };
+
+  /** A step of the plan. */
+  struct Step
+  {
+    enum Kind : unsigned char
+    {
+      copy, /**< Copy the old value and skip the current one. */
+      keep, /**< Skip the old value and copy the current one. */
+      number, /**< Convert a number. */
+      enumeration, /**< Map an enumeration constant. */
+      staticArray, /**< Convert the elements of a static array. */
+      dynamicArray, /**< Convert the size and the elements of a dynamic array. */
+      structure /**< Convert the attributes of a structure. */
+    };
+
+    Kind kind; /**< The kind of the step. */
+    int sourceLayout; /**< The layout of the old value. */
+    int targetLayout; /**< The layout of the current value. */
+    Primitive from = numOfPrimitives; /**< The old type of a number. */
+    Primitive to = numOfPrimitives; /**< The new type of a number. */
+    double factor = 1.0; /**< The factor a number is multiplied with if its type changes. */
+    int element = -1; /**< The step that converts the elements of an array. */
+    std::vector<int> constants; /**< The new values of old enumeration constants (-1: unknown). */
+    std::vector<std::pair<int, int>> attributes; /**< The old attribute index (-1: none) and the step for each attribute in current order. */
+    bool inOrder = true; /**< Are the old attributes used in their original order? */
+    std::vector<char> zero; /**< An element of a dynamic array in the new format that only contains zeros. */
+  };
+
+  /** A position in binary data that checks for its end. */
+  struct Reader
+  {
+    const char* data; /**< The next byte to read. */
+    const char* end; /**< The end of the data. */
+
+    /**
+     * Advances the position.
+     * @param size The number of bytes to skip.
+     * @return Were there enough bytes?
+     */
+    bool skip(std::size_t size)
+    {
+      if(static_cast<std::size_t>(end - data) < size)
+        return false;
+      data += size;
+      return true;
+    }
+
+    /**
+     * Reads a value.
+     * @param value The value read.
+     * @return Were there enough bytes?
+     */
+    template<typename T> bool read(T& value);
+  };
+
+  std::vector<Layout> layouts; /**< All layouts of old and current values. */
+  std::vector<Step> steps; /**< All steps of the plan. */
+  int root = -1; /**< The step that converts the whole type (-1: invalid). */
+  std::unordered_map<std::string, int> sourceLayouts; /**< The layouts of the old types (only while compiling). */
+  std::unordered_map<std::string, int> targetLayouts; /**< The layouts of the current types (only while compiling). */
+
+  /**
+   * Determines the primitive type for a type name.
+   * @param typeInfo The type information that contains the type.
+   * @param type The name of the type.
+   * @return The primitive type, \c enumType for enumerations, or \c numOfPrimitives otherwise.
+   */
+  static Primitive getPrimitive(const TypeInfo& typeInfo, const std::string& type);
+
+  /**
+   * Creates the layout of a type.
+   * @param typeInfo The type information that contains the type.
+   * @param type The name of the type.
+   * @param cache The layouts already created for this type information.
+   * @return The index of the layout or -1 if the type is unknown.
+   */
+  int createLayout(const TypeInfo& typeInfo, const std::string& type, std::unordered_map<std::string, int>& cache);
+
+  /**
+   * Compiles the step that converts a value.
+   * @param source The type information the data was streamed with.
+   * @param target The type information the data is converted to.
+   * @param sourceType The name of the old type.
+   * @param targetType The name of the new type.
+   * @param factor The factor for numbers.
+   * @param scalings Numbers that are scaled when converted.
+   * @return The index of the step or -1 if a type is unknown.
+   */
+  int compile(const TypeInfo& source, const TypeInfo& target, const std::string& sourceType, const std::string& targetType,
+              double factor, const std::vector<Scaling>& scalings);
+
+  /**
+   * Appends a value that only contains zeros.
+   * @param layout The layout of the value.
+   * @param zero The bytes the value is appended to.
+   */
+  void appendZero(int layout, std::vector<char>& zero) const;
+
+  /**
+   * Skips a value.
+   * @param layout The layout of the value.
+   * @param reader The position of the value, which is advanced to its end.
+   * @return Was the value complete?
+   */
+  bool skip(int layout, Reader& reader) const;
+
+  /**
+   * Copies a value.
+   * @param layout The layout of the value.
+   * @param reader The position of the value, which is advanced to its end.
+   * @param target The stream the value is written to.
+   * @return Was the value complete?
+   */
+  bool copy(int layout, Reader& reader, Out& target) const;
+
+  /**
+   * Applies a step.
+   * @param step The index of the step.
+   * @param source The position of the old value, which is advanced to its end.
+   * @param current The position of the current value, which is advanced to its end.
+   * @param target The stream the converted value is written to.
+   * @return Were the values complete?
+   */
+  bool apply(int step, Reader& source, Reader& current, Out& target) const;
+};
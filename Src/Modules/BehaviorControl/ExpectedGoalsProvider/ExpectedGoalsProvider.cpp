@@ -111,8 +111,7 @@ Angle ExpectedGoalsProvider::getOpeningAngle(const Vector2f& pointOnField, const
   ASSERT(std::abs(angleToRightPost) <= pi_2);
 
   // Construct a sector wheel relative to the position and add the goal sector between the two goal posts
-  SectorWheel wheel;
-  std::list<SectorWheel::Sector> sectors;
+  FlatSectorWheel wheel;
   Angle openingAngle = 0_deg;
   wheel.begin(pointOnField);
   wheel.addSector(Rangea(angleToRightPost, angleToLeftPost), std::numeric_limits<float>::max(), SectorWheel::Sector::goal);
@@ -140,9 +139,8 @@ Angle ExpectedGoalsProvider::getOpeningAngle(const Vector2f& pointOnField, const
     wheel.addSector(Rangea(Angle::normalize(direction - radius), Angle::normalize(direction + radius)), distance, SectorWheel::Sector::obstacle);
   }
 
-  sectors = wheel.finish();
   // Find the maximum opening angle i.e. the free sector with the largest size
-  for(const SectorWheel::Sector& sector : sectors)
+  for(const SectorWheel::Sector& sector : wheel.finish())
     if(sector.type == SectorWheel::Sector::goal &&
        sector.angleRange.getSize() >= openingAngle)
       openingAngle = sector.angleRange.getSize();
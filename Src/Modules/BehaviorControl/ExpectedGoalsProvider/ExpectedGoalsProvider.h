@@ -14,7 +14,7 @@
 #include "Representations/Configuration/BallSpecification.h"
 #include "Representations/Configuration/FieldDimensions.h"
 #include "Representations/Modeling/GlobalOpponentsModel.h"
-#include "Tools/BehaviorControl/SectorWheel.h"
+#include "Tools/BehaviorControl/FlatSectorWheel.h"
 
 MODULE(ExpectedGoalsProvider,
 {,
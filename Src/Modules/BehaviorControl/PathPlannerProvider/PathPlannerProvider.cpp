@@ -11,9 +11,11 @@
 
 #include "PathPlannerProvider.h"
 #include "Platform/SystemCall.h"
+#include "Platform/Time.h"
 #include "Debugging/DebugDrawings.h"
 #include "Debugging/DebugDrawings3D.h"
 #include "Debugging/Annotation.h"
+#include "Debugging/Plot.h"
 #include "Tools/BehaviorControl/Strategy/ActiveRole.h"
 #include <algorithm>
 
@@ -83,6 +85,12 @@ void PathPlannerProvider::update(PathPlanner& pathPlanner)
   DECLARE_DEBUG_DRAWING3D("module:PathPlannerProvider:expanded", "field");
   DECLARE_DEBUG_DRAWING3D("module:PathPlannerProvider:path", "field");
 
+  DECLARE_PLOT("module:PathPlannerProvider:expandedNodes");
+  DECLARE_PLOT("module:PathPlannerProvider:expansions");
+  DECLARE_PLOT("module:PathPlannerProvider:planningTime");
+  DECLARE_PLOT("module:PathPlannerProvider:reused");
+  DECLARE_PLOT("module:PathPlannerProvider:reuseRate");
+
   pathPlanner.plan = [this](const Pose2f& target, const Pose2f& speed) -> MotionRequest::ObstacleAvoidance
   {
     const bool excludeOwnPenaltyArea = theIllegalAreas.illegal & bit(IllegalAreas::ownPenaltyArea);
@@ -90,30 +98,29 @@ void PathPlannerProvider::update(PathPlanner& pathPlanner)
     pathPlannerWasActive = true;
     createBarriers(target, excludeOwnPenaltyArea, excludeOpponentPenaltyArea);
     createNodes(target, excludeOwnPenaltyArea, excludeOpponentPenaltyArea);
-    plan(nodes[0], nodes[1], speed.translation.x() / speed.rotation);
 
-    bool foundPath = false;
+    const float speedRatio = speed.translation.x() / speed.rotation;
+    const bool reused = canReuseLastSearch(speedRatio);
+    if(!reused)
+      search(speedRatio);
+    reuses.push_front(reused ? 1.f : 0.f);
+    PLOT("module:PathPlannerProvider:reused", reused ? 1 : 0);
+    PLOT("module:PathPlannerProvider:reuseRate", reuses.average());
+
     MotionRequest::ObstacleAvoidance obstacleAvoidance;
-    FOREACH_ENUM(Rotation, rotation)
-      if(nodes[1].fromEdge[rotation])
+    if(lastSearch.foundPath)
+    {
+      // The path is constructed from the current nodes, which might have moved slightly since the search.
+      for(const PathElement& element : lastSearch.path)
       {
-        Edge* edge;
-        for(edge = nodes[1].fromEdge[rotation]; edge->fromNode != &nodes[0]; edge = edge->fromNode->fromEdge[edge->fromRotation])
-        {
-          obstacleAvoidance.path.emplace_back();
-          obstacleAvoidance.path.back().obstacle = Geometry::Circle(theRobotPose.inverse() * edge->fromNode->center, edge->fromNode->radius + radiusControlOffset);
-          obstacleAvoidance.path.back().clockwise = edge->fromRotation == cw;
-        }
-        lastDir = edge->toRotation;
-
-        std::reverse(obstacleAvoidance.path.begin(), obstacleAvoidance.path.end());
-        obstacleAvoidance.avoidance = calcAvoidanceVector(edge->toNode);
-
-        foundPath = true;
-        break;
+        obstacleAvoidance.path.emplace_back();
+        obstacleAvoidance.path.back().obstacle = Geometry::Circle(theRobotPose.inverse() * nodes[element.id].center, nodes[element.id].radius + radiusControlOffset);
+        obstacleAvoidance.path.back().clockwise = element.clockwise;
       }
-
-    if(!foundPath)
+      lastDir = lastSearch.lastDir;
+      obstacleAvoidance.avoidance = calcAvoidanceVector(&nodes[lastSearch.nextNode]);
+    }
+    else
     {
       // Walk straight to target (but still avoid close obstacles)
       obstacleAvoidance.avoidance = calcAvoidanceVector(&nodes[1]);
@@ -136,6 +143,80 @@ void PathPlannerProvider::update(PathPlanner& pathPlanner)
     pathPlannerWasActive = false;
 }
 
+bool PathPlannerProvider::canReuseLastSearch(float speedRatio) const
+{
+  if(replanTolerance <= 0.f || lastDir != lastSearch.lastDir || speedRatio != lastSearch.speedRatio
+     || theFrameInfo.getTimeSince(lastSearch.time) >= maxReuseTime
+     || std::abs(Angle::normalize(theRobotPose.rotation - lastSearch.robotRotation)) > replanRotationTolerance
+     || nodes.size() != lastSearch.nodes.size() || barriers.size() != lastSearch.barriers.size())
+    return false;
+
+  // The robot itself moves with every step, so the start node has its own tolerance.
+  if((nodes[0].center - lastSearch.nodes[0].center).squaredNorm() > sqr(replanStartTolerance))
+    return false;
+
+  // The path still surrounds the first node, even if the robot already walked past it.
+  if(!lastSearch.path.empty() && hasPassedTangentPoint(lastSearch.nodes[0].center, lastSearch.tangentPoint, nodes[0].center))
+    return false;
+
+  const float squaredTolerance = sqr(replanTolerance);
+  for(std::size_t i = 1; i < nodes.size(); ++i)
+    if((nodes[i].center - lastSearch.nodes[i].center).squaredNorm() > squaredTolerance
+       || std::abs(nodes[i].radius - lastSearch.nodes[i].radius) > replanTolerance)
+      return false;
+
+  for(std::size_t i = 0; i < barriers.size(); ++i)
+    if((barriers[i].from - lastSearch.barriers[i].from).squaredNorm() > squaredTolerance
+       || (barriers[i].to - lastSearch.barriers[i].to).squaredNorm() > squaredTolerance
+       || barriers[i].costs != lastSearch.barriers[i].costs)
+      return false;
+
+  return true;
+}
+
+bool PathPlannerProvider::hasPassedTangentPoint(const Vector2f& start, const Vector2f& tangentPoint, const Vector2f& position)
+{
+  // If the robot started on the node, there is no direction to compare with.
+  return (position - tangentPoint).dot(tangentPoint - start) > 0.f;
+}
+
+void PathPlannerProvider::search(float speedRatio)
+{
+  lastSearch.nodes.clear();
+  for(const Node& node : nodes)
+    lastSearch.nodes.emplace_back(node.center, node.radius);
+  lastSearch.barriers = barriers;
+  lastSearch.robotRotation = theRobotPose.rotation;
+  lastSearch.speedRatio = speedRatio;
+  lastSearch.time = theFrameInfo.time;
+
+  numOfExpandedNodes = 0;
+  numOfExpansions = 0;
+  const unsigned long long startTime = Time::getCurrentThreadTime();
+  plan(nodes[0], nodes[1], speedRatio);
+  PLOT("module:PathPlannerProvider:planningTime", static_cast<float>(Time::getCurrentThreadTime() - startTime) / 1000.f);
+  PLOT("module:PathPlannerProvider:expandedNodes", numOfExpandedNodes);
+  PLOT("module:PathPlannerProvider:expansions", numOfExpansions);
+
+  lastSearch.foundPath = false;
+  lastSearch.path.clear();
+  FOREACH_ENUM(Rotation, rotation)
+    if(nodes[1].fromEdge[rotation])
+    {
+      Edge* edge;
+      for(edge = nodes[1].fromEdge[rotation]; edge->fromNode != &nodes[0]; edge = edge->fromNode->fromEdge[edge->fromRotation])
+        lastSearch.path.push_back({edge->fromNode->id, edge->fromRotation == cw});
+      lastDir = edge->toRotation;
+
+      std::reverse(lastSearch.path.begin(), lastSearch.path.end());
+      lastSearch.nextNode = edge->toNode->id;
+      lastSearch.tangentPoint = edge->toPoint;
+      lastSearch.foundPath = true;
+      break;
+    }
+  lastSearch.lastDir = lastDir;
+}
+
 void PathPlannerProvider::createBarriers(const Pose2f& target, bool excludeOwnPenaltyArea, bool excludeOpponentPenaltyArea)
 {
   barriers.clear();
@@ -278,6 +359,10 @@ void PathPlannerProvider::createNodes(const Pose2f& target, bool excludeOwnPenal
   if(centerCircleRadius != 0.f && theGameState.state == GameState::setupOpponentKickOff)
     addObstacle(Vector2f::Zero(), centerCircleRadius);
 
+  // Clones will keep the index of the node they were created from.
+  for(std::size_t i = 0; i < nodes.size(); ++i)
+    nodes[i].id = i;
+
   // If other nodes surround start or target, shrink them.
   for(auto node = nodes.begin(); node != nodes.begin() + 2; ++node)
     for(auto other = nodes.begin() + 2; other != nodes.end(); ++other)
@@ -397,7 +482,9 @@ void PathPlannerProvider::expand(Node& node, const Node& to, Rotation rotation,
   {
     findNeighbors(node);
     node.expanded = true;
+    ++numOfExpandedNodes;
   }
+  ++numOfExpansions;
 
   for(auto& edge : node.edges[rotation])
   {
@@ -462,7 +549,8 @@ void PathPlannerProvider::expand(Node& node, const Node& to, Rotation rotation,
 
 void PathPlannerProvider::findNeighbors(Node& node)
 {
-  Tangents tangents;
+  for(std::vector<Tangent>& t : tangents)
+    t.clear();
   createTangents(node, tangents);
   addNeighborsFromTangents(node, tangents);
 }
@@ -641,8 +729,8 @@ void PathPlannerProvider::addNeighborsFromTangents(Node& node, Tangents& tangent
     // Create index for tangents sorted by angle.
     // Since indices are used to reference between tangents,
     // the original vector of tangents must stay unchanged.
-    std::vector<Tangent*> index;
-    index.reserve(t.size());
+    std::vector<Tangent*>& index = sortedTangents;
+    index.clear();
     for(auto& tangent : t)
       index.push_back(&tangent);
     std::sort(index.begin(), index.end(), [](const Tangent* t1, const Tangent* t2) -> bool
@@ -651,8 +739,7 @@ void PathPlannerProvider::addNeighborsFromTangents(Node& node, Tangents& tangent
     });
 
     // Sweep through all tangents, managing a set of current nodes sorted by their distance.
-    std::vector<Tangent*> sweepLine;
-    sweepLine.reserve(t.size());
+    sweepLine.clear();
     const auto byDistance = [](const Tangent* t1, const Tangent* t2) -> bool
     {
       return t1->circleDistance > t2->circleDistance;
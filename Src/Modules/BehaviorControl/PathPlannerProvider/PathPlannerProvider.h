@@ -19,6 +19,7 @@
 #include "Representations/Modeling/ObstacleModel.h"
 #include "Representations/Modeling/RobotPose.h"
 #include "Framework/Module.h"
+#include "MathBase/RingBufferWithSum.h"
 #include <limits>
 
 MODULE(PathPlannerProvider,
@@ -49,6 +50,10 @@ MODULE(PathPlannerProvider,
     (float) radiusAvoidanceTolerance, /**< Radius range in which robot is partially pushed away (in mm). */
     (float) rotationPenalty, /**< Penalty factor for rotating towards first intermediate target in mm/radian. Stabilizes path selection. */
     (float) switchPenalty, /**< Penalty for selecting a different turn direction around first obstacle in mm. */
+    (float) replanTolerance, /**< The previous path is reused if no node moved or grew further than this since the last search (in mm). 0 = always search. */
+    (float) replanStartTolerance, /**< The previous path is only reused if the robot did not move further than this since the last search (in mm). */
+    (Angle) replanRotationTolerance, /**< The previous path is only reused if the robot did not turn further than this since the last search. */
+    (int) maxReuseTime, /**< A new search is forced if the last one is older than this (in ms). */
   }),
 });
 
@@ -108,6 +113,7 @@ class PathPlannerProvider : public PathPlannerProviderBase
     bool expanded = false; /**< Were the outgoing edges of this node already expanded? */
     int allowedClones = 0; /**< The number of times this node can be cloned. */
     float originalRadius; /**< The original radius of this node before it was reduced (in mm). */
+    std::size_t id = 0; /**< The index of this node (or the node it was cloned from) in the vector "nodes". */
 
     /**
      * Constructor.
@@ -135,6 +141,7 @@ class PathPlannerProvider : public PathPlannerProviderBase
       blockedSectors = other.blockedSectors;
       expanded = other.expanded;
       originalRadius = other.originalRadius;
+      id = other.id;
     }
   };
 
@@ -220,6 +227,32 @@ class PathPlannerProvider : public PathPlannerProviderBase
 
   using Tangents = std::array<std::vector<Tangent>, numOfRotations>;
 
+  /** An element of the path found by the last search. */
+  struct PathElement
+  {
+    std::size_t id; /**< The index of the node that is surrounded. */
+    bool clockwise; /**< Is it surrounded clockwise? */
+  };
+
+  /**
+   * The result of the last search and the inputs it was based on. Since obstacles
+   * usually move little between frames, this result is reused as long as none of
+   * the nodes changed significantly.
+   */
+  struct LastSearch
+  {
+    std::vector<Geometry::Circle> nodes; /**< The nodes before the search (start, target, obstacles). */
+    std::vector<Barrier> barriers; /**< The barriers used. */
+    Angle robotRotation; /**< The rotation of the robot (used for the rotation penalty). */
+    float speedRatio = 0.f; /**< The ratio between forward speed and turn speed used. */
+    Rotation lastDir = numOfRotations; /**< The direction around the first obstacle after the search. */
+    unsigned time = 0; /**< When did the search take place? */
+    bool foundPath = false; /**< Was a path found? */
+    std::vector<PathElement> path; /**< The nodes to surround (excluding start and target). */
+    std::size_t nextNode = 1; /**< The index of the first node after the start. */
+    Vector2f tangentPoint = Vector2f::Zero(); /**< The point at which the path from the start touches the first node. */
+  };
+
   std::vector<Node> nodes; /**< All nodes of the visibility graph, i.e. all obstacles, and starting point (1st entry) and target (2nd entry). */
   std::vector<Candidate> candidates; /**< All open edges during the A* search. */
   std::vector<Barrier> barriers; /**< Barrier lines that cannot be crossed during planning. */
@@ -227,6 +260,13 @@ class PathPlannerProvider : public PathPlannerProviderBase
   Rotation lastDir = cw; /**< Last direction selected when walking around first obstacle. */
   unsigned timeWhenLastPlayedSound = 0; /**< Used to limit frequency of sound playback. */
   bool pathPlannerWasActive = false; /**< Was the path planner active in previous frame? */
+  LastSearch lastSearch; /**< The last search that can be reused if nothing changed much. */
+  Tangents tangents; /**< Buffer for the tangents created for a node (kept to avoid reallocations). */
+  std::vector<Tangent*> sortedTangents; /**< Buffer for the tangents sorted by angle. */
+  std::vector<Tangent*> sweepLine; /**< Buffer for the sweep line. */
+  unsigned numOfExpandedNodes = 0; /**< The number of nodes whose neighbors were determined during the current search. */
+  unsigned numOfExpansions = 0; /**< The number of times nodes were expanded during the current search. */
+  RingBufferWithSum<float, 30> reuses; /**< Whether the last searches were reused (1) or not (0). */
 
   /**
    * Provide a representation that is able to plan a path using this module.
@@ -273,6 +313,20 @@ class PathPlannerProvider : public PathPlannerProviderBase
    */
   void addObstacle(const Vector2f& center, float radius);
 
+  /**
+   * Checks whether the last search can be reused, i.e. whether the nodes, barriers,
+   * and other inputs of the search did not change significantly since then.
+   * @param speedRatio The ratio between forward speed and turn speed.
+   * @return Can the path found in the last search be reused?
+   */
+  bool canReuseLastSearch(float speedRatio) const;
+
+  /**
+   * Runs a new search and stores its result and inputs in "lastSearch".
+   * @param speedRatio The ratio between forward speed and turn speed.
+   */
+  void search(float speedRatio);
+
   /**
    * Plan a shortest path. The result can be tracked backwards from the target node.
    * @param from The starting node. It is implicitly assumed that this is also the first entry in the vector "nodes".
@@ -334,4 +388,14 @@ class PathPlannerProvider : public PathPlannerProviderBase
 public:
   /** The default constructor constructs the borders from the field dimensions. */
   PathPlannerProvider();
+
+  /**
+   * Checks whether the robot has passed the point at which a path touches its
+   * first node. Beyond that point, the path would lead the robot back.
+   * @param start The position of the robot when the path was planned.
+   * @param tangentPoint The point at which the path from the start touches the first node.
+   * @param position The current position of the robot.
+   * @return Is the robot beyond the line through the tangent point that is perpendicular to the path?
+   */
+  static bool hasPassedTangentPoint(const Vector2f& start, const Vector2f& tangentPoint, const Vector2f& position);
 };
@@ -20,6 +20,7 @@
 #include "SetPlayActions.h"
 #include "Representations/Modeling/ObstacleModel.h"
 #include "Tools/BehaviorControl/KickSelection.h"
+#include "Tools/BehaviorControl/Strategy/VoronoiRegionTable.h"
 #include "Tools/Modeling/BallPhysics.h"
 #include "Framework/Settings.h"
 #include "Math/Random.h"
@@ -201,12 +202,9 @@ Behavior::Behavior(const BallDropInModel& theBallDropInModel, const BallSpecific
 #endif
     setPlays[OpponentFreeKick::toSetPlay(opponentFreeKick)] = &opponentFreeKicks[opponentFreeKick];
   }
-  for(SetPlay* setPlay : setPlays)
-  {
-    if(!setPlay)
-      continue;
-    setPlay->compileVoronoiRegions(tactics);
-  }
+
+  // Fill in the Voronoi regions of all tactics and set plays (from the cache if it is up to date).
+  VoronoiRegionTable::compile(tactics, setPlays);
 }
 
 Behavior::~Behavior()
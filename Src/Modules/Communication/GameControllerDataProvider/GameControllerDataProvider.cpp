@@ -28,30 +28,34 @@ GameControllerDataProvider::GameControllerDataProvider()
   // Initialize socket
   VERIFY(socket.setBlocking(false));
   VERIFY(socket.bind("0.0.0.0", GAMECONTROLLER_DATA_PORT));
+  socket.reserveBatch(maxPacketsPerRead, sizeof(RoboCup::RoboCupGameControlData) + 1);
 }
 
 void GameControllerDataProvider::update(GameControllerData& theGameControllerData)
 {
-  int size;
-  RoboCup::RoboCupGameControlData buffer;
-  unsigned from;
-  while((size = socket.read(reinterpret_cast<char*>(&buffer), sizeof(buffer), from)) > 0)
-  {
-    if(size == sizeof(buffer) &&
-       !std::memcmp(&buffer, GAMECONTROLLER_STRUCT_HEADER, 4) &&
-       buffer.version == GAMECONTROLLER_STRUCT_VERSION &&
-       (buffer.teams[0].teamNumber == Global::getSettings().teamNumber ||
-        buffer.teams[1].teamNumber == Global::getSettings().teamNumber))
+  int packetsRead;
+  while((packetsRead = socket.readBatch()) > 0)
+    for(int i = 0; i < packetsRead; ++i)
     {
-      unsigned ip = htonl(from);
-      char addressBuffer[INET_ADDRSTRLEN];
-      VERIFY(inet_ntop(AF_INET, &ip, addressBuffer, INET_ADDRSTRLEN) == addressBuffer);
-      socket.setTarget(addressBuffer, GAMECONTROLLER_RETURN_PORT);
-      static_cast<RoboCup::RoboCupGameControlData&>(theGameControllerData) = buffer;
-      theGameControllerData.timeLastPacketReceived = socket.getLastReadTimestamp();
-      theGameControllerData.isTrueData = false;
+      const UdpComm::Packet& packet = socket.getPacket(i);
+      RoboCup::RoboCupGameControlData buffer;
+      if(packet.size != sizeof(buffer))
+        continue;
+      std::memcpy(&buffer, packet.data, sizeof(buffer));
+      if(!std::memcmp(&buffer, GAMECONTROLLER_STRUCT_HEADER, 4) &&
+         buffer.version == GAMECONTROLLER_STRUCT_VERSION &&
+         (buffer.teams[0].teamNumber == Global::getSettings().teamNumber ||
+          buffer.teams[1].teamNumber == Global::getSettings().teamNumber))
+      {
+        unsigned ip = htonl(packet.ip);
+        char addressBuffer[INET_ADDRSTRLEN];
+        VERIFY(inet_ntop(AF_INET, &ip, addressBuffer, INET_ADDRSTRLEN) == addressBuffer);
+        socket.setTarget(addressBuffer, GAMECONTROLLER_RETURN_PORT);
+        static_cast<RoboCup::RoboCupGameControlData&>(theGameControllerData) = buffer;
+        theGameControllerData.timeLastPacketReceived = packet.timestamp;
+        theGameControllerData.isTrueData = false;
+      }
     }
-  }
 
   if(theFrameInfo.getTimeSince(theGameControllerData.timeLastPacketReceived) < gameControllerTimeout &&
      theFrameInfo.getTimeSince(whenPacketWasSent) >= aliveDelay &&
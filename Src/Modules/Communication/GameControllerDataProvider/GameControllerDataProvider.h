@@ -37,6 +37,8 @@ MODULE(GameControllerDataProvider,
 
 class GameControllerDataProvider : public GameControllerDataProviderBase
 {
+  static constexpr unsigned maxPacketsPerRead = 8; /**< The maximum number of packets read from the socket at once. */
+
   UdpComm socket; /**< The socket to communicate with the GameController. */
   unsigned whenPacketWasSent = 0; /**< When the last return packet was sent to the GameController. */
 
@@ -10,6 +10,7 @@
 #include "AutomaticCameraCalibrator.h"
 #include "Platform/SystemCall.h"
 #include "Debugging/Annotation.h"
+#include "ImageProcessing/SIMD.h"
 #include "Tools/Math/Transformation.h"
 #include <algorithm>
 #include <cmath>
@@ -69,6 +70,7 @@ void AutomaticCameraCalibrator::update(CameraCalibration& cameraCalibration)
   // Calibration start requested.
   if(state == CameraCalibrationStatus::State::idle && theCalibrationRequest.targetState == CameraCalibrationStatus::State::recordSamples)
   {
+    cancelStep();
     optimizer = nullptr;
     successiveConvergences = 0;
     optimizationSteps = 0;
@@ -83,6 +85,7 @@ void AutomaticCameraCalibrator::update(CameraCalibration& cameraCalibration)
   // Abort requested.
   if(theCalibrationRequest.targetState == CameraCalibrationStatus::State::idle && state != CameraCalibrationStatus::State::idle)
   {
+    cancelStep();
     samples.clear();
     currentSampleConfiguration = nullptr;
     state = CameraCalibrationStatus::State::idle;
@@ -204,6 +207,9 @@ void AutomaticCameraCalibrator::update(CameraCalibrationStatus& cameraCalibratio
 
   cameraCalibrationStatus.state = state;
   cameraCalibrationStatus.inStateSince = inStateSince;
+  cameraCalibrationStatus.optimizationSteps = optimizationSteps;
+  cameraCalibrationStatus.successiveConvergences = successiveConvergences;
+  cameraCalibrationStatus.optimizationDelta = lastDelta;
 
   cameraCalibrationStatus.sampleConfigurationStatus = SampleConfigurationStatus::none;
   if(theCalibrationRequest.sampleConfigurationRequest)
@@ -272,22 +278,45 @@ float AutomaticCameraCalibrator::determineSobelThresh(const Sobel::SobelImage& s
 
 void AutomaticCameraCalibrator::calcHoughSpace(const Sobel::SobelImage& sobelImage, const int minIndex, const int maxIndex, const int dMax, std::vector<std::vector<int> >& houghSpace)
 {
+  // Collect the edge pixels first, so that the distances of four of them can be computed at once per angle.
   const float thresh = determineSobelThresh(sobelImage);
+  std::vector<float> edgeX, edgeY;
   for(unsigned int y = 1; y < sobelImage.height - 1; ++y)
     for(unsigned int x = 1; x < sobelImage.width - 1; ++x)
     {
       const Sobel::SobelPixel& pixel = sobelImage[y][x];
       if(pixel.x * pixel.x + pixel.y * pixel.y >= thresh)
       {
-        for(int index = minIndex; index != maxIndex; ++index)
-        {
-          int d = static_cast<int>(std::ceil(x * cosAngles[index] + y * sinAngles[index]));
-          ++houghSpace[index][d + dMax];
-          if(minIndex > maxIndex && index == numOfAngles - 1)
-            index = -1;
-        }
+        edgeX.push_back(static_cast<float>(x));
+        edgeY.push_back(static_cast<float>(y));
       }
     }
+
+  const size_t numOfEdgePixels = edgeX.size();
+  alignas(16) int distances[4];
+  for(int index = minIndex; index != maxIndex; ++index)
+  {
+    int* const votes = houghSpace[index].data() + dMax;
+    const __m128 cosAngle = _mm_set1_ps(cosAngles[index]);
+    const __m128 sinAngle = _mm_set1_ps(sinAngles[index]);
+    size_t i = 0;
+    for(; i + 4 <= numOfEdgePixels; i += 4)
+    {
+      const __m128 d = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(edgeX.data() + i), cosAngle), _mm_mul_ps(_mm_loadu_ps(edgeY.data() + i), sinAngle));
+
+      // Rounds up without SSE4.1: Truncate and add one where this rounded down.
+      const __m128i truncated = _mm_cvttps_epi32(d);
+      _mm_store_si128(reinterpret_cast<__m128i*>(distances), _mm_sub_epi32(truncated, _mm_castps_si128(_mm_cmplt_ps(_mm_cvtepi32_ps(truncated), d))));
+      ++votes[distances[0]];
+      ++votes[distances[1]];
+      ++votes[distances[2]];
+      ++votes[distances[3]];
+    }
+    for(; i < numOfEdgePixels; ++i)
+      ++votes[static_cast<int>(std::ceil(edgeX[i] * cosAngles[index] + edgeY[i] * sinAngles[index]))];
+    if(minIndex > maxIndex && index == numOfAngles - 1)
+      index = -1;
+  }
 }
 
 void AutomaticCameraCalibrator::determineLocalMaxima(const std::vector<std::vector<int> >& houghSpace, const int minIndex, const int maxIndex, std::vector<Maximum>& localMaxima)
@@ -524,61 +553,98 @@ void AutomaticCameraCalibrator::optimize()
     optimizer = std::make_unique<GaussNewtonOptimizer<numOfParameterTranslations>>(functor);
     optimizationParameters = pack(theCameraCalibration);
     successiveConvergences = 0;
+    return;
   }
-  else
+
+  if(!optimizeInBackground)
   {
-    const float delta = optimizer->iterate(optimizationParameters, Parameters::Constant(0.0001f));
-    if(!std::isfinite(delta))
-    {
-      resetOptimization(false);
+    functor.baseCalibration = nextCameraCalibration;
+    processStep(executeStep(optimizationParameters));
+    return;
+  }
+
+  if(!optimizationWorker)
+    optimizationWorker = std::make_unique<InferenceWorker>();
+  else if(optimizationWorker->isBusy())
+  {
+    if(!optimizationWorker->poll())
       return;
-    }
+    processStep(backgroundStep);
 
-    for(size_t i = 0; i < functor.getNumOfMeasurements(); ++i)
-    {
-      if(functor(optimizationParameters, i) >= notValidError)
-      {
-        resetOptimization(false);
-        return;
-      }
-    }
+    // The optimization was restarted or has finished.
+    if(!optimizer)
+      return;
+  }
 
-    OUTPUT_TEXT("AutomaticCameraCalibrator: delta = " << delta << "\n");
-    if(std::abs(delta) < lowestDelta)
-    {
-      lowestDelta = std::abs(delta);
-      lowestDeltaParameters = optimizationParameters;
-    }
-    ++optimizationSteps;
-    if(std::abs(delta) < (terminationCriterion * std::max(1u, optimizationSteps / 500 * 50)))
-      ++successiveConvergences;
-    else
-      successiveConvergences = 0;
-    if(successiveConvergences > 0)
-    {
-      float error = 0;
-      for(size_t i = 0; i < samples.size(); i++)
-        error += functor(optimizationParameters, i);
-      error /= static_cast<float>(samples.size());
-      if(successiveConvergences == 1 || error < lowestError)
-      {
-        lowestError = error;
-        lowestErrorParameters = optimizationParameters;
-      }
-    }
-    if(successiveConvergences >= minSuccessiveConvergences)
-    {
-      OUTPUT_TEXT("AutomaticCameraCalibrator: converged!");
-      unpack(lowestErrorParameters, nextCameraCalibration);
-      resetOptimization(true);
-    }
-    else
-      unpack(optimizationParameters, nextCameraCalibration);
+  // The functor and the samples are not changed until the step has finished or was canceled.
+  functor.baseCalibration = nextCameraCalibration;
+  const Parameters parameters = optimizationParameters;
+  optimizationWorker->submit([this, parameters] {backgroundStep = executeStep(parameters);});
+}
+
+AutomaticCameraCalibrator::Step AutomaticCameraCalibrator::executeStep(const Parameters& parameters) const
+{
+  Step step;
+  step.parameters = parameters;
+  step.delta = optimizer->iterate(step.parameters, Parameters::Constant(0.0001f));
+  step.valid = std::isfinite(step.delta);
+  step.error = 0.f;
+  for(size_t i = 0; step.valid && i < functor.getNumOfMeasurements(); ++i)
+  {
+    const float error = functor(step.parameters, i);
+    step.valid = error < notValidError;
+    step.error += error;
   }
+  if(step.valid)
+    step.error /= static_cast<float>(samples.size());
+  return step;
+}
+
+void AutomaticCameraCalibrator::processStep(const Step& step)
+{
+  if(!step.valid)
+  {
+    resetOptimization(false);
+    return;
+  }
+
+  optimizationParameters = step.parameters;
+  lastDelta = step.delta;
+  OUTPUT_TEXT("AutomaticCameraCalibrator: delta = " << step.delta << "\n");
+  if(std::abs(step.delta) < lowestDelta)
+  {
+    lowestDelta = std::abs(step.delta);
+    lowestDeltaParameters = optimizationParameters;
+  }
+  ++optimizationSteps;
+  if(std::abs(step.delta) < (terminationCriterion * std::max(1u, optimizationSteps / 500 * 50)))
+    ++successiveConvergences;
+  else
+    successiveConvergences = 0;
+  if(successiveConvergences > 0 && (successiveConvergences == 1 || step.error < lowestError))
+  {
+    lowestError = step.error;
+    lowestErrorParameters = optimizationParameters;
+  }
+  if(successiveConvergences >= minSuccessiveConvergences)
+  {
+    OUTPUT_TEXT("AutomaticCameraCalibrator: converged!");
+    unpack(lowestErrorParameters, nextCameraCalibration);
+    resetOptimization(true);
+  }
+  else
+    unpack(optimizationParameters, nextCameraCalibration);
+}
+
+void AutomaticCameraCalibrator::cancelStep()
+{
+  if(optimizationWorker)
+    optimizationWorker->wait();
 }
 
 void AutomaticCameraCalibrator::resetOptimization(const bool finished)
 {
+  cancelStep();
   if(finished)
     state = CameraCalibrationStatus::State::idle;
   else
@@ -597,6 +663,7 @@ void AutomaticCameraCalibrator::resetOptimization(const bool finished)
   lowestDelta = std::numeric_limits<float>::max();
   lowestDeltaParameters = Parameters();
   optimizationSteps = 0;
+  lastDelta = 0.f;
 }
 
 AutomaticCameraCalibrator::Parameters AutomaticCameraCalibrator::pack(const CameraCalibration& cameraCalibration) const
@@ -650,21 +717,15 @@ void AutomaticCameraCalibrator::updateSampleConfiguration()
   lastSampleConfigurationIndex = static_cast<int>(theCalibrationRequest.sampleConfigurationRequest->index);
 }
 
-#define CHECK_PROJECTION_2_LINES(SampleName, line1, line2) \
+#define CHECK_PROJECTION_2_LINES(line1, line2) \
   if(!CHECK_LINE_PROJECTION(line1, coordSys, cameraMatrix, cameraInfo) || \
      !CHECK_LINE_PROJECTION(line2, coordSys, cameraMatrix, cameraInfo)) \
-  { \
-    OUTPUT_TEXT(SampleName << " projection error!"); \
-    return calibrator.notValidError; \
-  }
+    return calibrator.notValidError;
 
-#define CHECK_PROJECTION_LINE_PENALTY(SampleName, line, p, p2) \
+#define CHECK_PROJECTION_LINE_PENALTY(line, p, p2) \
   if(!CHECK_LINE_PROJECTION(line, coordSys, cameraMatrix, cameraInfo) || \
      !Transformation::imageToRobot(coordSys.toCorrected(p), cameraMatrix, cameraInfo, p2)) \
-  { \
-    OUTPUT_TEXT(SampleName << " projection error!"); \
-    return calibrator.notValidError; \
-  }
+    return calibrator.notValidError;
 
 float AutomaticCameraCalibrator::Sample::computeError(const CameraCalibration& cameraCalibration) const
 {
@@ -675,27 +736,25 @@ float AutomaticCameraCalibrator::Sample::computeError(const CameraCalibration& c
 
 float AutomaticCameraCalibrator::CornerAngleSample::computeError(const CameraMatrix& cameraMatrix) const
 {
-  CHECK_PROJECTION_2_LINES("CornerAngleSample", cLine1, cLine2)
+  CHECK_PROJECTION_2_LINES(cLine1, cLine2)
 
   const float cornerAngle = calculateAngle(cLine1.aOnField, cLine1.bOnField, cLine2.aOnField, cLine2.bOnField);
   const float cornerAngleError = std::abs(90_deg - cornerAngle);
-  OUTPUT_TEXT("Angle 90: " << cornerAngle << ", error: " << cornerAngleError);
   return cornerAngleError / calibrator.angleErrorDivisor;
 }
 
 float AutomaticCameraCalibrator::ParallelAngleSample::computeError(const CameraMatrix& cameraMatrix) const
 {
-  CHECK_PROJECTION_2_LINES("ParallelAngleSample", cLine1, cLine2)
+  CHECK_PROJECTION_2_LINES(cLine1, cLine2)
 
   const float parallelAngle = calculateAngle(cLine1.aOnField, cLine1.bOnField, cLine2.aOnField, cLine2.bOnField);
   const float parallelAngleError = std::min(parallelAngle, 180_deg - parallelAngle);
-  OUTPUT_TEXT("Angle 180: " << parallelAngle << ", error: " << parallelAngleError);
   return parallelAngleError / calibrator.angleErrorDivisor;
 }
 
 float AutomaticCameraCalibrator::ParallelLinesDistanceSample::computeError(const CameraMatrix& cameraMatrix) const
 {
-  CHECK_PROJECTION_2_LINES("ParallelLinesDistanceSample", cLine1, cLine2)
+  CHECK_PROJECTION_2_LINES(cLine1, cLine2)
 
   const Geometry::Line line1(cLine1.aOnField, (cLine1.bOnField - cLine1.aOnField).normalized());
   const Geometry::Line line2(cLine2.aOnField, (cLine2.bOnField - cLine2.aOnField).normalized());
@@ -720,39 +779,36 @@ float AutomaticCameraCalibrator::ParallelLinesDistanceSample::computeError(const
   distanceErrorList.push_back(std::max(0.f, (std::abs(std::abs(distance3) - optimalDistance) - distance3ErrorRange)));
   distanceErrorList.push_back(std::max(0.f, (std::abs(std::abs(distance4) - optimalDistance) - distance4ErrorRange)));
   const float lineDistanceError = *std::max_element(distanceErrorList.cbegin(), distanceErrorList.cend());
-  OUTPUT_TEXT("LineDistanceError: " << lineDistanceError);
   return lineDistanceError / calibrator.distanceErrorDivisor;
 }
 
 float AutomaticCameraCalibrator::GoalAreaDistanceSample::computeError(const CameraMatrix& cameraMatrix) const
 {
   Vector2f penaltyMarkOnField;
-  CHECK_PROJECTION_LINE_PENALTY("GoalAreaDistanceSample", cLine, penaltyMarkInImage, penaltyMarkOnField)
+  CHECK_PROJECTION_LINE_PENALTY(cLine, penaltyMarkInImage, penaltyMarkOnField)
 
   const Geometry::Line line(cLine.aOnField, (cLine.bOnField - cLine.aOnField).normalized());
   const float goalAreaDistance = Geometry::getDistanceToLine(line, penaltyMarkOnField);
   const float goalAreaDistanceError = std::abs(goalAreaDistance - (calibrator.theFieldDimensions.xPosOpponentGoalArea -
                                                calibrator.theFieldDimensions.xPosOpponentPenaltyMark + cLine.offset));
-  OUTPUT_TEXT("PenaltyDistanceError: " << goalAreaDistanceError);
   return goalAreaDistanceError / calibrator.distanceErrorDivisor;
 }
 
 float AutomaticCameraCalibrator::GoalLineDistanceSample::computeError(const CameraMatrix& cameraMatrix) const
 {
   Vector2f penaltyMarkOnField;
-  CHECK_PROJECTION_LINE_PENALTY("GoalLineDistanceSample", cLine, penaltyMarkInImage, penaltyMarkOnField)
+  CHECK_PROJECTION_LINE_PENALTY(cLine, penaltyMarkInImage, penaltyMarkOnField)
 
   const Geometry::Line line(cLine.aOnField, (cLine.bOnField - cLine.aOnField).normalized());
   const float goalLineDistance = Geometry::getDistanceToLine(line, penaltyMarkOnField);
   const float goalLineDistanceError = std::abs(goalLineDistance - (calibrator.theFieldDimensions.xPosOpponentGoalLine -
                                                calibrator.theFieldDimensions.xPosOpponentPenaltyMark + cLine.offset));
-  OUTPUT_TEXT("GoalLineDistanceError: " << goalLineDistanceError);
   return goalLineDistanceError / calibrator.distanceErrorDivisor;
 }
 
 float AutomaticCameraCalibrator::Functor::operator()(const Parameters& params, size_t measurement) const
 {
-  CameraCalibration cameraCalibration = calibrator.nextCameraCalibration;
+  CameraCalibration cameraCalibration = baseCalibration;
   calibrator.unpack(params, cameraCalibration);
   return calibrator.samples[measurement]->computeError(cameraCalibration);
 }
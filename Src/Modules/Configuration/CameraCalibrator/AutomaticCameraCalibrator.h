@@ -26,6 +26,7 @@
 #include "Representations/Perception/ImagePreprocessing/ImageCoordinateSystem.h"
 #include "Representations/Sensing/GroundContactState.h"
 #include "Representations/Sensing/TorsoMatrix.h"
+#include "Tools/Framework/InferenceWorker.h"
 #include "ImageProcessing/Sobel.h"
 #include "Framework/Module.h"
 #include "Math/GaussNewtonOptimizer.h"
@@ -66,6 +67,7 @@ MODULE(AutomaticCameraCalibrator,
     (float)(200.f) increase, /**< By how much the acceptance limit should be increased. */
     (Pose2f)(0, -750, 0) validationRobotPose, /**< The position on the field used to validate the calibration. */
     (float)(3.095f) pixelInaccuracyPerMeter, /**< Pixel inaccuracy in the image when projecting on the field (in mm). */
+    (bool)(true) optimizeInBackground, /**< Execute the optimization steps in a separate thread instead of one per frame in this one. */
   }),
 });
 
@@ -89,6 +91,8 @@ private:
     bodyTiltCorrection,
   });
 
+  using Parameters = GaussNewtonOptimizer<numOfParameterTranslations>::Vector;
+
   /** This struct represents a local maximum in the hough space. */
   struct Maximum
   {
@@ -97,6 +101,15 @@ private:
     int distanceIndex; /**< The distance index of the local maximum in the hough space. */
   };
 
+  /** The result of an optimization step. */
+  struct Step
+  {
+    Parameters parameters; /**< The parameters after the step. */
+    float delta; /**< The norm of the parameter update. */
+    bool valid; /**< Can all samples be projected with the parameters? */
+    float error; /**< The mean error of all samples with the parameters (only if valid). */
+  };
+
   /** This struct represents a corrected line with its offset. */
   struct CorrectedLine
   {
@@ -221,8 +234,6 @@ private:
     mutable CorrectedLine cLine; /**< The corrected goal line. */
   };
 
-  using Parameters = GaussNewtonOptimizer<numOfParameterTranslations>::Vector;
-
   /** This struct is used to evaluate the error by the optimizer. */
   struct Functor : public GaussNewtonOptimizer<numOfParameterTranslations>::Functor
   {
@@ -244,6 +255,7 @@ private:
     size_t getNumOfMeasurements() const override { return calibrator.samples.size(); }
 
     AutomaticCameraCalibrator& calibrator; /**< The owning module. */
+    CameraCalibration baseCalibration; /**< The calibration the parameters are unpacked into. It does not change while a step is running. */
   };
   friend struct Functor;
 
@@ -321,9 +333,29 @@ private:
   /** Records samples from the current image. */
   void recordSamples();
 
-  /** Executes one optimization step and checks for termination. */
+  /**
+   * Starts the next optimization step, or processes it and checks for termination
+   * if it has finished. The steps are executed in the background if configured.
+   */
   void optimize();
 
+  /**
+   * Executes an optimization step. It neither uses debugging macros nor members
+   * that are changed while the step is running, so it can run in another thread.
+   * @param parameters The parameters before the step.
+   * @return The result of the step.
+   */
+  Step executeStep(const Parameters& parameters) const;
+
+  /**
+   * Processes the result of an optimization step and checks for termination.
+   * @param step The result of the step.
+   */
+  void processStep(const Step& step);
+
+  /** Waits for an optimization step running in the background and drops its result. */
+  void cancelStep();
+
   /**
    * Resets the optimization state.
    * @param finished Whether the optimization is finished or just has to be restarted..
@@ -368,6 +400,8 @@ private:
   Functor functor; /**< The functor that calculates the error for the optimizer. */
   Parameters optimizationParameters; /**< The parameters on which the optimizer operates. */
   unsigned successiveConvergences = 0, optimizationSteps = 0; /**<  The successive number of times the termination criterion has been fulfilled (only valid during optimization). */
+  float lastDelta = 0.f; /**< The norm of the parameter update in the last optimization step. */
+  Step backgroundStep; /**< The result of the optimization step running in the background. */
 
   std::unique_ptr<SampleConfiguration> currentSampleConfiguration; /**< The sample configuration that is currently recording. */
   int lastSampleConfigurationIndex;
@@ -385,4 +419,6 @@ private:
   Parameters lowestDeltaParameters; /**< The parameters which should be set if the optimization is stopped manually through the converge debug response. */
   float lowestError = std::numeric_limits<float>::max(); /**< The lowest error that was calculated, after the first delta was below the threshold. */
   Parameters lowestErrorParameters; /**< The parameters which should be set after convergence. */
+
+  std::unique_ptr<InferenceWorker> optimizationWorker; /**< Executes the optimization steps in the background (created when needed, destroyed first). */
 };
@@ -257,6 +257,16 @@ bool CameraProvider::isFrameDataComplete()
     return true;
 }
 
+unsigned CameraProvider::getImageTimestamp()
+{
+#ifdef TARGET_ROBOT
+  if(theInstance && theInstance->camera && theInstance->camera->hasImage()
+     && static_cast<long long>(theInstance->camera->getTimestamp() / 1000) > static_cast<long long>(Time::getSystemTimeBase()))
+    return static_cast<unsigned>(theInstance->camera->getTimestamp() / 1000 - Time::getSystemTimeBase());
+#endif
+  return Time::getCurrentSystemTime();
+}
+
 void CameraProvider::takeImages()
 {
 #ifdef TARGET_ROBOT
@@ -105,6 +105,13 @@ public:
    */
   static bool isFrameDataComplete();
 
+  /**
+   * The method returns when the image that is available was taken.
+   * Outside of the robot, this is the current time.
+   * @return The timestamp of the image in ms.
+   */
+  static unsigned getImageTimestamp();
+
   /**
    * The method waits for a new image.
    */
@@ -7,7 +7,6 @@
 #include "LogDataProvider.h"
 #include "Platform/BHAssert.h"
 #include "Platform/Time.h"
-#include "Debugging/DebugDataStreamer.h"
 #include "Debugging/DebugDrawings3D.h"
 #include "Debugging/Debugging.h"
 #include "Debugging/DebugImages.h"
@@ -30,6 +29,7 @@ LogDataProvider::LogDataProvider() :
   theInstance = this;
   TypeInfo::initCurrent();
   states.fill(unknown);
+  targets.fill(nullptr);
   if(SystemCall::getMode() == SystemCall::logFileReplay)
     OUTPUT(idTypeInfoRequest, bin, '\0');
   ModuleContainer::addMessageHandler(handleMessage);
@@ -76,6 +76,24 @@ void LogDataProvider::update(GroundTruthOdometryData& groundTruthOdometryData)
   lastOdometryData = groundTruthOdometryData;
 }
 
+Streamable* LogDataProvider::getTarget(MessageID id)
+{
+  const Blackboard& blackboard = Blackboard::getInstance();
+  const ModuleGraphRunner& moduleGraphRunner = ModuleGraphRunner::getInstance();
+  if(blackboard.getVersion() != blackboardVersion || moduleGraphRunner.getVersion() != moduleGraphVersion)
+  {
+    blackboardVersion = blackboard.getVersion();
+    moduleGraphVersion = moduleGraphRunner.getVersion();
+    FOREACH_ENUM(MessageID, i, numOfDataMessageIDs)
+    {
+      const char* representation = TypeRegistry::getEnumName(i) + 2; // +2 to skip the id of the messageID enums.
+      targets[i] = blackboard.exists(representation) && moduleGraphRunner.getProvider(representation) == "LogDataProvider"
+                    ? &Blackboard::getInstance()[representation] : nullptr;
+    }
+  }
+  return id < numOfDataMessageIDs ? targets[id] : nullptr;
+}
+
 bool LogDataProvider::handle(MessageQueue::Message message)
 {
   if(message.id() == idTypeInfo)
@@ -87,8 +105,7 @@ bool LogDataProvider::handle(MessageQueue::Message message)
   }
   else if(SystemCall::getMode() == SystemCall::logFileReplay && !logTypeInfo)
     return false;
-  else if(Blackboard::getInstance().exists(TypeRegistry::getEnumName(message.id()) + 2) && // +2 to skip the id of the messageID enums.
-          ModuleGraphRunner::getInstance().getProvider(TypeRegistry::getEnumName(message.id()) + 2) == "LogDataProvider")
+  else if(Streamable* target = getTarget(message.id()))
   {
     if(logTypeInfo)
     {
@@ -98,10 +115,21 @@ bool LogDataProvider::handle(MessageQueue::Message message)
         const char* type = TypeRegistry::getEnumName(message.id()) + 2;
         states[message.id()] = TypeInfo::current->areTypesEqual(*logTypeInfo, type, type) ? accept : convert;
         if(states[message.id()] == convert)
-          OUTPUT_WARNING(std::string(type) + " has changed and is converted. Some fields will keep their previous values.");
+        {
+          // Audio samples were stored as shorts before they became floats in the range [-1, 1].
+          static const std::vector<TypeMigration::Scaling> scalings = {{"AudioData", "samples", 1.0 / std::numeric_limits<short>::max()}};
+          migrations[message.id()] = std::make_unique<TypeMigration>(*logTypeInfo, *TypeInfo::current, type, scalings);
+          if(migrations[message.id()]->isValid())
+            OUTPUT_WARNING(std::string(type) + " has changed and is converted. Some fields will keep their previous values.");
+          else
+          {
+            states[message.id()] = ignore;
+            OUTPUT_WARNING(std::string(type) + " has changed and cannot be converted. It is ignored.");
+          }
+        }
       }
     }
-    readMessage(message, Blackboard::getInstance()[TypeRegistry::getEnumName(message.id()) + 2]);
+    readMessage(message, *target);
     return true;
   }
   else
@@ -110,31 +138,20 @@ bool LogDataProvider::handle(MessageQueue::Message message)
 
 void LogDataProvider::readMessage(MessageQueue::Message message, Streamable& representation)
 {
-  if(states[message.id()] != convert)
-    message.bin() >> representation;
-  else
+  if(states[message.id()] == convert)
   {
-    ASSERT(logTypeInfo);
-    const char* type = TypeRegistry::getEnumName(message.id()) + 2;
-
-    // Stream into textual representation in memory using type specification of log file.
-    OutMapMemory outMap(true, 16384);
-    auto stream = message.bin();
-    DebugDataStreamer streamer(*logTypeInfo, stream, type);
-    outMap << streamer;
-
-    // Read from textual representation. Errors are suppressed.
-    InMapMemory inMap(outMap.data(), outMap.size(), 0);
-    inMap >> representation;
-
-    // HACK: This does not work if anything else than the sample format is changed in AudioData.
-    if(message.id() == idAudioData)
+    // Convert the binary data into the current format. Parts that cannot be converted keep their current values.
+    OutBinaryMemory current(message.size() + 1024);
+    current << representation;
+    OutBinaryMemory converted(current.size() + 1024);
+    if(migrations[message.id()]->apply(message.data(), message.size(), current.data(), current.size(), converted))
     {
-      AudioData& audioData = dynamic_cast<AudioData&>(representation);
-      for(AudioData::Sample& sample : audioData.samples)
-        sample /= std::numeric_limits<short>::max();
+      InBinaryMemory stream(converted.data(), converted.size());
+      stream >> representation;
     }
   }
+  else if(states[message.id()] != ignore)
+    message.bin() >> representation;
 }
 
 bool LogDataProvider::handleMessage(MessageQueue::Message message)
@@ -87,6 +87,8 @@
 #include "Framework/Module.h"
 #include "Framework/ModuleGraphRunner.h"
 #include "Streaming/TypeInfo.h"
+#include "Streaming/TypeMigration.h"
+#include <memory>
 #include <unordered_set>
 
 // No verify when replaying logfiles
@@ -193,9 +195,14 @@ private:
     unknown, // No specification available -> replay anyway.
     accept,  // Specification is compatible -> replay.
     convert, // Specification not compatible -> convert.
+    ignore,  // Specification not compatible and not convertible -> ignore.
   });
 
   std::array<State, numOfDataMessageIDs> states; /**< Should the corresponding message ids be replayed? */
+  std::array<std::unique_ptr<TypeMigration>, numOfDataMessageIDs> migrations; /**< The plans to convert messages with changed specifications. */
+  std::array<Streamable*, numOfDataMessageIDs> targets; /**< The blackboard entries messages are replayed to (nullptr: not provided by this module). */
+  int blackboardVersion = -1; /**< The version of the blackboard the targets were determined for. */
+  int moduleGraphVersion = -1; /**< The version of the module configuration the targets were determined for. */
   TypeInfo* logTypeInfo = nullptr; /**< The specifications of all the types from the log file. */
   bool frameDataComplete; /**< Were all messages of the current frame received? */
   OdometryData lastOdometryData; /**< The last odometry data that was provided. Used for computing offset. */
@@ -287,6 +294,16 @@ private:
   void update(CameraImage& cameraImage) override;
   void update(GroundTruthOdometryData&) override;
 
+  /**
+   * Returns the blackboard entry messages with a certain id are replayed to.
+   * The entries of all ids are only determined again if the blackboard or
+   * the module configuration changed since the last call.
+   * @param id The message id.
+   * @return The blackboard entry or nullptr if the representation is not
+   *         provided by this module.
+   */
+  Streamable* getTarget(MessageID id);
+
   /**
    * Handle message by writing the data contained into the corresponding blackboard entry.
    * @param message The message to be handled.
@@ -9,13 +9,14 @@
 #include "SelfLocator.h"
 #include "Debugging/Annotation.h"
 #include "Debugging/Plot.h"
+#include "Framework/ModuleGraphRunner.h"
 #include "Framework/Settings.h"
 #include "Math/Eigen.h"
 #include "Math/Probabilistics.h"
 #include "Platform/SystemCall.h"
 #include <algorithm>
 
-SelfLocator::SelfLocator() : lastTimeJumpSound(0),
+SelfLocator::SelfLocator() : numberOfActiveSamples(numberOfSamples), lastTimeJumpSound(0),
   timeOfLastReturnFromPenalty(0),
   nextSampleNumber(0), idOfLastBestSample(-1), averageWeighting(0.5f), lastAlternativePoseTimestamp(0),
   validitiesHaveBeenUpdated(false)
@@ -54,6 +55,10 @@ void SelfLocator::update(RobotPose& robotPose)
   // In any case, remember last ground truth robot pose
   lastGroundTruthRobotPose = theGroundTruthRobotPose;
 
+  /* Use fewer samples if there is not enough time left in this frame.
+   */
+  adaptNumberOfSamples();
+
   /* Move all samples according to the current odometry.
    */
   STOPWATCH("SelfLocator:motionUpdate")
@@ -74,7 +79,7 @@ void SelfLocator::update(RobotPose& robotPose)
   float minWeighting = 2.f;
   float maxWeighting = -1.f;
   float weightingSum = 0.f;
-  for(int i = 0; i < numberOfSamples; ++i)
+  for(int i = 0; i < numberOfActiveSamples; ++i)
   {
     samples->at(i).computeWeightingBasedOnValidity(baseValidityWeighting);
     const float w = samples->at(i).weighting;
@@ -84,7 +89,7 @@ void SelfLocator::update(RobotPose& robotPose)
     if(w < minWeighting)
       minWeighting = w;
   }
-  averageWeighting = weightingSum / numberOfSamples;
+  averageWeighting = weightingSum / numberOfActiveSamples;
   PLOT("module:SelfLocator:minWeighting", minWeighting);
   PLOT("module:SelfLocator:maxWeighting", maxWeighting);
   PLOT("module:SelfLocator:averageWeighting", averageWeighting);
@@ -134,7 +139,7 @@ void SelfLocator::update(RobotPose& robotPose)
   {
     if(theAlternativeRobotPoseHypothesis.isValid)
     {
-      for(int i = 0; i < numberOfSamples; ++i)
+      for(int i = 0; i < numberOfActiveSamples; ++i)
       {
         UKFRobotPoseHypothesis newSample;
         if(theSideInformation.robotMustBeInOwnHalf)
@@ -195,8 +200,8 @@ void SelfLocator::update(RobotPose& robotPose)
 
 void SelfLocator::update(SelfLocalizationHypotheses& selfLocalizationHypotheses)
 {
-  selfLocalizationHypotheses.hypotheses.resize(numberOfSamples);
-  for(int i = 0; i < numberOfSamples; ++i)
+  selfLocalizationHypotheses.hypotheses.resize(numberOfActiveSamples);
+  for(int i = 0; i < numberOfActiveSamples; ++i)
   {
     SelfLocalizationHypotheses::Hypothesis& h = selfLocalizationHypotheses.hypotheses[i];
     h.pose = samples->at(i).getPose();
@@ -257,7 +262,7 @@ bool SelfLocator::sampleSetIsUnimodal(const RobotPose& robotPose)
   const Angle maxRotationDeviation(84_deg);
   const Angle robotPoseRotation(robotPose.rotation);
   const float sqrMaxDistanceDeviation = maxDistanceDeviation * maxDistanceDeviation;
-  for(int i = 0; i < numberOfSamples; ++i)
+  for(int i = 0; i < numberOfActiveSamples; ++i)
   {
     const Pose2f& p = samples->at(i).getPose();
     if((robotPose.translation - p.translation).squaredNorm() > sqrMaxDistanceDeviation)
@@ -268,6 +273,25 @@ bool SelfLocator::sampleSetIsUnimodal(const RobotPose& robotPose)
   return true;
 }
 
+void SelfLocator::adaptNumberOfSamples()
+{
+  const int targetNumberOfSamples = ModuleGraphRunner::getRemainingBudget() < minRemainingBudget
+                                    ? std::clamp(numberOfSamplesWhenLate, 1, numberOfSamples) : numberOfSamples;
+  if(targetNumberOfSamples < numberOfActiveSamples)
+    samples->thinOut(numberOfActiveSamples, targetNumberOfSamples);
+  else
+  {
+    // Fill up with copies of random active samples. The motion update will spread them again.
+    for(int i = numberOfActiveSamples; i < targetNumberOfSamples; ++i)
+    {
+      samples->at(i) = samples->at(Random::uniformInt(numberOfActiveSamples - 1));
+      samples->at(i).id = nextSampleNumber++;
+    }
+  }
+  numberOfActiveSamples = targetNumberOfSamples;
+  PLOT("module:SelfLocator:numberOfActiveSamples", numberOfActiveSamples);
+}
+
 void SelfLocator::motionUpdate()
 {
   // This is a nasty workaround but should help us in cases of bad/slow assistant referees:
@@ -294,7 +318,7 @@ void SelfLocator::motionUpdate()
   const float transYError = std::max(std::abs(transY * majorDirTransWeight), std::abs(transX * minorDirTransWeight));
 
   // update samples
-  for(int i = 0; i < numberOfSamples; ++i)
+  for(int i = 0; i < numberOfActiveSamples; ++i)
   {
     const Vector2f transOffset((transX - transXError) + (2 * transXError) * Random::uniform(),
                                (transY - transYError) + (2 * transYError) * Random::uniform());
@@ -326,7 +350,7 @@ void SelfLocator::sensorUpdate()
   std::vector<RegisteredAbsolutePoseMeasurement> absolutePoseMeasurements;
   std::vector<RegisteredLandmark> landmarks;
   std::vector<RegisteredLine> lines;
-  for(int i = 0; i < numberOfSamples; ++i)
+  for(int i = 0; i < numberOfActiveSamples; ++i)
   {
     float numerator = 0.f;
     float denominator = 0.f;
@@ -381,7 +405,7 @@ void SelfLocator::sensorUpdate()
   // Apply side information:
   if(!theGameState.isPenaltyShootout())
   {
-    for(int i = 0; i < numberOfSamples; ++i)
+    for(int i = 0; i < numberOfActiveSamples; ++i)
     {
       if(samples->at(i).getPose().translation.x() > theSideInformation.largestXCoordinatePossible)
         samples->at(i).invalidate();
@@ -389,7 +413,7 @@ void SelfLocator::sensorUpdate()
   }
 
   // Check, if sample is still on the carpet
-  for(int i = 0; i < numberOfSamples; ++i)
+  for(int i = 0; i < numberOfActiveSamples; ++i)
   {
     const Vector2f& position = samples->at(i).getPose().translation;
     if(!theFieldDimensions.isInsideCarpet(position))
@@ -399,8 +423,8 @@ void SelfLocator::sensorUpdate()
   // Statistics
   sumOfPerceivedLines += thePerceptRegistration.totalNumberOfAvailableLines;
   sumOfPerceivedLandmarks += thePerceptRegistration.totalNumberOfAvailableLandmarks;
-  sumOfUsedLines += static_cast<float>(usedLines) / numberOfSamples;
-  sumOfUsedLandmarks += static_cast<float>(usedLandmarks) / numberOfSamples;
+  sumOfUsedLines += static_cast<float>(usedLines) / numberOfActiveSamples;
+  sumOfUsedLandmarks += static_cast<float>(usedLandmarks) / numberOfActiveSamples;
 }
 
 bool SelfLocator::currentMotionIsUnsafe()
@@ -450,7 +474,7 @@ bool SelfLocator::sensorResetting(const RobotPose& robotPose)
     float resettingValidity = std::max(0.5f, averageWeighting); // TODO: Recompute?
     int worstSampleIdx = 0;
     float worstSampleValidity = samples->at(0).validity;
-    for(int i = 1; i < numberOfSamples; ++i)
+    for(int i = 1; i < numberOfActiveSamples; ++i)
     {
       if(samples->at(i).validity < worstSampleValidity)
       {
@@ -508,11 +532,11 @@ void SelfLocator::resampling()
   // resample:
   int replacements(0);
   int j(0);
-  for(int i = 0; i < numberOfSamples; ++i)
+  for(int i = 0; i < numberOfActiveSamples; ++i)
   {
     currentSum += oldSet[i].weighting;
     int replicationCount(0);
-    while(currentSum > nextPos && j < numberOfSamples)
+    while(currentSum > nextPos && j < numberOfActiveSamples)
     {
       samples->at(j) = oldSet[i];
       if(replicationCount) // An old sample becomes copied multiple times: we need new identifier for the new instances
@@ -525,9 +549,9 @@ void SelfLocator::resampling()
       nextPos += weightingBetweenTwoDrawnSamples;
     }
   }
-  int missingSamples = numberOfSamples - j;
+  int missingSamples = numberOfActiveSamples - j;
   // fill up missing samples (could happen in rare cases due to numerical imprecision / rounding / whatever) with new poses:
-  for(; j < numberOfSamples; ++j)
+  for(; j < numberOfActiveSamples; ++j)
   {
     if(theAlternativeRobotPoseHypothesis.isValid) // Try to use the currently best available alternative
     {
@@ -580,13 +604,12 @@ void SelfLocator::handleGameStateChanges()
   else if(theExtendedGameState.returnFromGameControllerPenalty || theExtendedGameState.returnFromManualPenalty ||
           (theGameState.playerState == GameState::calibration && theGameState.playerState != theExtendedGameState.playerStateLastFrame))
   {
-    int startOfSecondHalfOfSampleSet = samples->size() / 2;
-    // The first half of the new sample set is left of the own goal ...
-    for(int i = 0; i < startOfSecondHalfOfSampleSet; ++i)
-      samples->at(i).init(getNewPoseReturnFromPenaltyPosition(true), returnFromPenaltyPoseDeviation, nextSampleNumber++, 0.5f);
-    // ... and the second half of new sample set is right of the own goal.
-    for(int i = startOfSecondHalfOfSampleSet; i < samples->size(); ++i)
-      samples->at(i).init(getNewPoseReturnFromPenaltyPosition(false), returnFromPenaltyPoseDeviation, nextSampleNumber++, 0.5f);
+    // Half of the samples in use is left of the own goal and the other half is right of it.
+    // This must also hold if fewer samples are used, because the frame runs late.
+    samples->initInTwoGroups(numberOfActiveSamples, [this](UKFRobotPoseHypothesis& sample, bool leftSideOfGoal)
+    {
+      sample.init(getNewPoseReturnFromPenaltyPosition(leftSideOfGoal), returnFromPenaltyPoseDeviation, nextSampleNumber++, 0.5f);
+    });
     sampleSetHasBeenReset = true;
     timeOfLastReturnFromPenalty = theFrameInfo.time;
   }
@@ -619,7 +642,7 @@ UKFRobotPoseHypothesis& SelfLocator::getMostValidSample()
   UKFRobotPoseHypothesis* lastBestSample = 0;
   if(idOfLastBestSample != -1)
   {
-    for(int i = 0; i < numberOfSamples; ++i)
+    for(int i = 0; i < numberOfActiveSamples; ++i)
     {
       if(samples->at(i).id == idOfLastBestSample)
       {
@@ -632,7 +655,7 @@ UKFRobotPoseHypothesis& SelfLocator::getMostValidSample()
   UKFRobotPoseHypothesis* returnSample = &(samples->at(0));
   float maxValidity = -1.f;
   float minVariance = 0.f; // Initial value does not matter
-  for(int i = 0; i < numberOfSamples; ++i)
+  for(int i = 0; i < numberOfActiveSamples; ++i)
   {
     const float val = samples->at(i).validity;
     if(val > maxValidity)
@@ -743,9 +766,9 @@ void SelfLocator::draw(const RobotPose& robotPose)
 
 bool SelfLocator::allSamplesIDsAreUnique()
 {
-  for(int i = 0; i < numberOfSamples - 1; ++i)
+  for(int i = 0; i < numberOfActiveSamples - 1; ++i)
   {
-    for(int j = i + 1; j < numberOfSamples; ++j)
+    for(int j = i + 1; j < numberOfActiveSamples; ++j)
     {
       if(samples->at(i).id == samples->at(j).id)
         return false;
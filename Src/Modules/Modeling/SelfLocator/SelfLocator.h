@@ -57,6 +57,8 @@ MODULE(SelfLocator,
   LOADS_PARAMETERS(
   {,
     (int)      numberOfSamples,                      /**< The number of samples used by the self-locator */
+    (int)      numberOfSamplesWhenLate,              /**< The number of samples used if the thread is running out of its frame budget */
+    (float)    minRemainingBudget,                   /**< Fewer samples are used if less of the frame budget than this is left (in ms) */
     (Pose2f)   defaultPoseDeviation,                 /**< Standard deviation used for creating new hypotheses */
     (Pose2f)   walkInPoseDeviation,                  /**< Standard deviation used for creating new hypotheses at walk in positions */
     (Pose2f)   returnFromPenaltyPoseDeviation,       /**< Standard deviation used for creating new hypotheses when returning from a penalty */
@@ -104,6 +106,7 @@ class SelfLocator : public SelfLocatorBase
 {
 private:
   SampleSet<UKFRobotPoseHypothesis>* samples;   /**< Container for all samples. */
+  int numberOfActiveSamples;                    /**< The number of samples currently used, i.e. the first ones in the sample set */
   unsigned lastTimeJumpSound;                   /**< When has the last sound been played? Avoid to flood the sound player in some situations */
   unsigned timeOfLastReturnFromPenalty;         /**< Point of time when the last penalty of this robot was over */
   bool sampleSetHasBeenReset;                   /**< Flag indicating that all samples have been replaced in the current frame */
@@ -133,6 +136,9 @@ private:
    */
   void update(SelfLocalizationHypotheses& selfLocalizationHypotheses) override;
 
+  /** Reduces the number of active samples if the thread is running late and restores it afterwards */
+  void adaptNumberOfSamples();
+
   /** Integrate odometry offset into hypotheses */
   void motionUpdate();
 
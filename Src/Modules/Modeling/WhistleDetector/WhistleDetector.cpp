@@ -14,6 +14,7 @@
 #include "WhistleDetector.h"
 #include "Debugging/Annotation.h"
 #include "Debugging/Plot.h"
+#include "Framework/StartupTrace.h"
 #include "Math/Constants.h"
 #include "Platform/File.h"
 #include "Platform/SystemCall.h"
@@ -30,6 +31,7 @@ WhistleDetector::WhistleDetector()
 {
   // Load the model.
   model = std::make_unique<NeuralNetworkONNX::Model>(std::string(File::getBHDir()) + "/" + whistleNetPath);
+  StartupTrace::Scope scope(StartupTrace::compilation, "WhistleDetector");
   detector.compile(*model);
 
   ASSERT(detector.numOfInputs() == 1);
@@ -39,29 +41,70 @@ WhistleDetector::WhistleDetector()
 
   // Setup buffers for pre- and post-processing.
   amplitudes.resize(detector.input(0).dims(0));
-  samples.reserve(amplitudes.size() * 2 - 2);
+  fftSize = amplitudes.size() * 2 - 2;
   thresholdBuffer.reserve(useAdaptiveThreshold ? adaptiveWindowSize : 1);
   nnConfidenceBuffer.reserve(useAdaptiveThreshold ? adaptiveWindowSize / 2 : 1);
   pmConfidenceBuffer.reserve(useAdaptiveThreshold ? adaptiveWindowSize / 2 : 1);
 
-  // Init FFT.
-  in = fftw_alloc_real(samples.capacity());
-  std::memset(in, 0, sizeof(double) * samples.capacity());
-  out = fftw_alloc_complex(amplitudes.size());
-  {
-    SYNC;
-    fft = fftw_plan_dft_r2c_1d(static_cast<int>(samples.capacity()), in, out, FFTW_MEASURE);
-  }
-
   chroma.setResolution(500, static_cast<unsigned>(amplitudes.size()));
 }
 
 WhistleDetector::~WhistleDetector()
 {
+  freeChannels();
+}
+
+void WhistleDetector::setupChannels(std::size_t channels)
+{
+  if(samples.size() == channels)
+    return;
+
+  freeChannels();
+  samples.assign(channels, RingBuffer<float>(fftSize));
+  channelAmplitudes.resize(channels * amplitudes.size());
+  deafCounts.assign(channels, 0);
+
+  // All channels are transformed by a single plan. The input and output blocks of the channels follow each other.
+  in = fftwf_alloc_real(channels * fftSize);
+  std::memset(in, 0, sizeof(float) * channels * fftSize);
+  out = fftwf_alloc_complex(channels * amplitudes.size());
+  const int n = static_cast<int>(fftSize);
+  SYNC;
+  fft = fftwf_plan_many_dft_r2c(1, &n, static_cast<int>(channels),
+                                in, nullptr, 1, static_cast<int>(fftSize),
+                                out, nullptr, 1, static_cast<int>(amplitudes.size()), FFTW_MEASURE);
+}
+
+void WhistleDetector::freeChannels()
+{
+  if(!fft)
+    return;
+
   SYNC;
-  fftw_destroy_plan(fft);
-  fftw_free(out);
-  fftw_free(in);
+  fftwf_destroy_plan(fft);
+  fftwf_free(out);
+  fftwf_free(in);
+  fft = nullptr;
+  in = nullptr;
+  out = nullptr;
+}
+
+void WhistleDetector::updateWindow()
+{
+  if(windowComputed == windowing)
+    return;
+
+  window.resize(fftSize);
+  for(size_t i = 0; i < fftSize; ++i)
+  {
+    const float phase = static_cast<float>(pi * i / fftSize);
+    window[i] = windowing == hann ? sqr(std::sin(phase))
+                : windowing == nuttall ? 0.355768f - 0.487396f * std::sin(phase)
+                                        + 0.144232f * std::sin(2.f * phase)
+                                        - 0.012604f * std::sin(3.f * phase)
+                : 0.54f - 0.46f * std::cos(2.f * phase);
+  }
+  windowComputed = windowing;
 }
 
 void WhistleDetector::update(Whistle& theWhistle)
@@ -83,25 +126,27 @@ void WhistleDetector::update(Whistle& theWhistle)
   {
     // We are currently not recording -> start from scratch once we record again
     detectionCount = 0;
-    samples.clear();
+    for(RingBuffer<float>& channelSamples : samples)
+      channelSamples.clear();
     thresholdBuffer.clear();
   }
   else
   {
-    size_t sampleIndex = channel;
-    while(sampleIndex < theAudioData.samples.size())
+    setupChannels(theAudioData.channels);
+    for(size_t sampleIndex = 0; !samples.empty() && sampleIndex + samples.size() <= theAudioData.samples.size();)
     {
-      samples.push_front(theAudioData.samples[sampleIndex]);
-      sampleIndex += theAudioData.channels;
+      for(RingBuffer<float>& channelSamples : samples)
+        channelSamples.push_front(theAudioData.samples[sampleIndex++]);
 
-      if(samples.full())
+      if(samples.front().full())
       {
         // Run whistle detection.
         detect(theWhistle);
 
         // Drop the older half of the samples.
-        while(samples.size() > samples.capacity() / 2)
-          samples.pop_back();
+        for(RingBuffer<float>& channelSamples : samples)
+          while(channelSamples.size() > fftSize / 2)
+            channelSamples.pop_back();
       }
     }
   }
@@ -135,20 +180,18 @@ void WhistleDetector::detect(Whistle& theWhistle)
   // Copy to input for FFT.
   STOPWATCH("module:WhistleDetector:samples")
   {
-    for(size_t i = 0; i < samples.size(); ++i)
+    updateWindow();
+    float* channelIn = in;
+    for(const RingBuffer<float>& channelSamples : samples)
     {
-      const float phase = static_cast<float>(pi * i / samples.capacity());
-      in[i] = samples[samples.size() - 1 - i]
-              * (windowing == hann ? sqr(std::sin(phase))
-                 : windowing == nuttall ? 0.355768f - 0.487396f * std::sin(phase)
-                                         + 0.144232f * std::sin(2.f * phase)
-                                         - 0.012604f * std::sin(3.f * phase)
-                 : 0.54f - 0.46f * std::cos(2.f * phase));
+      for(size_t i = 0; i < fftSize; ++i)
+        channelIn[i] = channelSamples[fftSize - 1 - i] * window[i];
+      channelIn += fftSize;
     }
   }
 
   // Run FFT.
-  STOPWATCH("module:WhistleDetector:FFT") fftw_execute(fft);
+  STOPWATCH("module:WhistleDetector:FFT") fftwf_execute(fft);
 
   // These variables are set inside the STOPWATCH, but are also needed outside.
   float relLimitCount;
@@ -159,11 +202,51 @@ void WhistleDetector::detect(Whistle& theWhistle)
 
   STOPWATCH("module:WhistleDetector:amplitutes")
   {
+    // Check which mics are probably broken. If all are, use them anyway.
+    unsigned workingChannels = 0;
+    for(size_t channel = 0; channel < samples.size(); ++channel)
+    {
+      const fftwf_complex* channelOut = out + channel * amplitudes.size();
+      float* channelAmps = channelAmplitudes.data() + channel * amplitudes.size();
+      float channelAmpSum = 0.f;
+      for(size_t i = 0; i < amplitudes.size(); ++i)
+        channelAmpSum += channelAmps[i] = std::sqrt(sqr(channelOut[i][0]) + sqr(channelOut[i][1]));
+      if(channelAmpSum / amplitudes.size() >= channelMinAmplitude)
+        deafCounts[channel] = 0;
+      else if(deafCounts[channel] < channelMinDeafCount)
+        ++deafCounts[channel];
+      if(deafCounts[channel] < channelMinDeafCount)
+        ++workingChannels;
+    }
+
+    if(workingChannels)
+      theWhistle.channelsUsedForWhistleDetection = numOfChannelsReported;
+    else
+    {
+      theWhistle.channelsUsedForWhistleDetection = 0;
+      if(!allDeafAlert)
+      {
+        SystemCall::say("All microphones are probably broken.", true);
+        allDeafAlert = true;
+      }
+    }
+
+    // Average the amplitudes of the working channels.
+    std::fill(amplitudes.begin(), amplitudes.end(), 0.f);
+    for(size_t channel = 0; channel < samples.size(); ++channel)
+      if(!workingChannels || deafCounts[channel] < channelMinDeafCount)
+      {
+        const float* channelAmps = channelAmplitudes.data() + channel * amplitudes.size();
+        for(size_t i = 0; i < amplitudes.size(); ++i)
+          amplitudes[i] += channelAmps[i];
+      }
+
+    const float channelWeight = 1.f / static_cast<float>(workingChannels ? workingChannels : samples.size());
     float ampSum = 0;
     float limitCount = 0;
     for(size_t i = 0; i < amplitudes.size(); ++i)
     {
-      const float amp = static_cast<float>(std::sqrt(sqr(out[i][0]) + sqr(out[i][1])));
+      const float amp = amplitudes[i] * channelWeight;
       detector.input(0)[i] = 20.f * std::log10(amp);
       amplitudes[i] = amp;
       currentMaxAmp = std::max(currentMaxAmp, amp);
@@ -176,37 +259,13 @@ void WhistleDetector::detect(Whistle& theWhistle)
     PLOT("module:WhistleDetector:amp:max", currentMaxAmp);
     currentMeanAmp = ampSum / amplitudes.size();
     PLOT("module:WhistleDetector:amp:mean", currentMeanAmp);
-
-    //switch to another mic if the current mic is probably broken
-    if(currentMeanAmp >= channelMinAmplitude)
-    {
-      deafCount = 0;
-      theWhistle.channelsUsedForWhistleDetection = numOfChannelsReported;
-    }
-    else if(++deafCount >= channelMinDeafCount)
-    {
-      if(channel < static_cast<unsigned int>(theAudioData.channels - 1))
-      {
-        ++channel;
-        deafCount = 0;
-      }
-      else
-      {
-        theWhistle.channelsUsedForWhistleDetection = 0;
-        if(!allDeafAlert)
-        {
-          SystemCall::say("All microphones are probably broken.", true);
-          allDeafAlert = true;
-        }
-      }
-    }
   }
 
   STOPWATCH("module:WhistleDetector:detect")
   {
     //do WhistleDetection PM
-    const Range<unsigned> pos(static_cast<unsigned>(currentFreq.min * samples.capacity() / theAudioData.sampleRate),
-                              static_cast<unsigned>(currentFreq.max * samples.capacity() / theAudioData.sampleRate));
+    const Range<unsigned> pos(static_cast<unsigned>(currentFreq.min * fftSize / theAudioData.sampleRate),
+                              static_cast<unsigned>(currentFreq.max * fftSize / theAudioData.sampleRate));
 
     // find whistle peak between min. freq. position and  max. freq. position
     peak = std::max_element(amplitudes.begin() + pos.min + 1, amplitudes.begin() + pos.max);
@@ -249,7 +308,7 @@ void WhistleDetector::detect(Whistle& theWhistle)
      && pmConfidenceBuffer.back() > averageThreshold * thresholdRatio)  // whistle detected this frame, min of #attack detections needed
   {
     lastTimeCandidateDetected = theFrameInfo.time;
-    const unsigned detectedWhistleFrequency = static_cast<unsigned>((peak - amplitudes.begin()) * theAudioData.sampleRate / samples.capacity());
+    const unsigned detectedWhistleFrequency = static_cast<unsigned>((peak - amplitudes.begin()) * theAudioData.sampleRate / fftSize);
     if(++detectionCount >= minDetections && confidence / averageThreshold > bestConfidence)
     {
       bestConfidence = confidence / averageThreshold;
@@ -297,8 +356,8 @@ void WhistleDetector::draw()
     };
 
     // transform sample rate to fft size to debug image size
-    const Range<unsigned> xRange(static_cast<unsigned>(currentFreq.min * samples.capacity() / theAudioData.sampleRate * fft.width / amplitudes.size()),
-                                 static_cast<unsigned>(currentFreq.max * samples.capacity() / theAudioData.sampleRate * fft.width / amplitudes.size()));
+    const Range<unsigned> xRange(static_cast<unsigned>(currentFreq.min * fftSize / theAudioData.sampleRate * fft.width / amplitudes.size()),
+                                 static_cast<unsigned>(currentFreq.max * fftSize / theAudioData.sampleRate * fft.width / amplitudes.size()));
 
     // draw main detection rect
     for(unsigned x = xRange.min; x <= xRange.max; ++x)
@@ -317,7 +376,7 @@ void WhistleDetector::draw()
       const unsigned yTemp = std::min(fft.height - 1, static_cast<unsigned>(amplitudes[xTemp]));
 
       // draw vertical grid
-      if(xTemp * theAudioData.sampleRate / samples.capacity() >= grid)
+      if(xTemp * theAudioData.sampleRate / fftSize >= grid)
       {
         drawLine(x, 0, x, fft.height - 1, 0x505050);
         grid += 1000;
@@ -39,7 +39,7 @@ MODULE(WhistleDetector,
     }),
     (std::string) whistleNetPath, /** The path to the network to load, relative to the B-Human directory. */
     (float) channelMinAmplitude, /** The minimum mean amplitude for a working microphone. */
-    (unsigned) channelMinDeafCount, /**< How often must the mean amplitude be too low to switch channel? */
+    (unsigned) channelMinDeafCount, /**< How often must the mean amplitude be too low to ignore a channel? */
     (Windowing) windowing, /**< The windowing method applied to the input of the FFT. */
     (Range<unsigned>) freq, /**< The frequency range searched for the largest amplitude. */
     (bool) freqCalibration, /**< Is the frequency range adapted to the current whistle? */
@@ -62,16 +62,19 @@ MODULE(WhistleDetector,
 
 class WhistleDetector : public WhistleDetectorBase
 {
-  unsigned channel = 0; /**< The channel, i.e. the microphone, that is used for whistle detection. */
-  RingBuffer<float> samples; /**< The audio samples of that channel to process. */
+  std::size_t fftSize; /**< The number of samples per channel that are transformed together. */
+  std::vector<RingBuffer<float>> samples; /**< The audio samples to process per channel, i.e. per microphone. */
+  std::vector<float> window; /**< The windowing function for all samples of a channel. */
+  Windowing windowComputed = numOfWindowings; /**< The windowing method \c window was computed for. */
 
-  fftw_plan fft; /**< The plan to compute the FFT. */
-  double* in = nullptr; /**< The input of the FFT. */
-  fftw_complex* out = nullptr; /**< The output of the FFT. */
+  fftwf_plan fft = nullptr; /**< The plan to compute the FFTs of all channels at once. */
+  float* in = nullptr; /**< The inputs of the FFTs (one block per channel). */
+  fftwf_complex* out = nullptr; /**< The outputs of the FFTs (one block per channel). */
 
-  std::vector<float> amplitudes; /**< The amplitudes of the different frequencies. */
+  std::vector<float> channelAmplitudes; /**< The amplitudes of the different frequencies per channel (one block per channel). */
+  std::vector<float> amplitudes; /**< The amplitudes of the different frequencies averaged over all working channels. */
   RingBufferWithSum<float, 200> maxAmpHist; /**< The maximum amplitudes of the last 200 FFTs. */
-  unsigned deafCount = 0; /**< How often was the mean amplitude too low consecutively on this channel? */
+  std::vector<unsigned> deafCounts; /**< How often was the mean amplitude too low consecutively per channel? */
   bool allDeafAlert = false; /**< Already informed that all microphones are broken? */
 
   Range<unsigned> currentFreq; /**< The frequency window in which it is searched for the whistle. */
@@ -97,10 +100,25 @@ class WhistleDetector : public WhistleDetectorBase
    */
   void update(Whistle& theWhistle);
 
+  /**
+   * Allocates the buffers and plans the FFT for a number of channels.
+   * Does nothing if they already exist for that number.
+   * @param channels The number of channels.
+   */
+  void setupChannels(std::size_t channels);
+
+  /** Frees the FFT buffers and the plan. */
+  void freeChannels();
+
+  /** Computes the table of the windowing function if the method was changed. */
+  void updateWindow();
+
   /**
    * This method performs the actual whistle detection, after enough samples were collected.
-   * @param theWhistle Sets the number of channels used to 0 if sound is too quiet or back to 1
-   *                   if a whistle was detected.
+   * The spectra of all channels are computed at once and the amplitudes of the working ones
+   * are averaged, so that the neural network runs only once for all channels.
+   * @param theWhistle Sets the number of channels used to 0 if all channels are too quiet
+   *                   or back to the number reported if at least one channel works.
    */
   void detect(Whistle& theWhistle);
 
@@ -12,17 +12,21 @@
 
 MAKE_MODULE(IntersectionsClassifier);
 
-IntersectionsClassifier::IntersectionsClassifier() : network(&Global::getAsmjitRuntime())
-{
-  // Initialize model for the neural net
-  model = std::make_unique<NeuralNetwork::Model>(std::string(File::getBHDir()) + "/Config/NeuralNets/IntersectionsClassifier/distanceUpdatedModel.h5");
-  network.compile(*model);
-}
+IntersectionsClassifier::IntersectionsClassifier() :
+  network(&Global::getAsmjitRuntime()),
+  initialization("IntersectionsClassifier", [this]
+  {
+    // Initialize model for the neural net
+    model = std::make_unique<NeuralNetwork::Model>(std::string(File::getBHDir()) + "/Config/NeuralNets/IntersectionsClassifier/distanceUpdatedModel.h5");
+    StartupTrace::Scope scope(StartupTrace::compilation, "IntersectionsClassifier");
+    network.compile(*model);
+  })
+{}
 
 void IntersectionsClassifier::update(IntersectionsPercept& theIntersectionsPercept)
 {
-  // check whether network has been successfully compiled
-  if(!network.valid())
+  // check whether network has already been successfully compiled
+  if(!initialization.isReady() || !network.valid())
     return;
 
   DECLARE_DEBUG_DRAWING("module:IntersectionsClassifier:field", "drawingOnField");
@@ -10,6 +10,7 @@
 #pragma once
 
 #include "Framework/Module.h"
+#include "Framework/StartupTrace.h"
 #include "ImageProcessing/PatchUtilities.h"
 #include "Representations/Configuration/FieldDimensions.h"
 #include "Representations/Modeling/RobotPose.h"
@@ -61,4 +62,5 @@ private:
 
   NeuralNetwork::CompiledNN network;
   std::unique_ptr<NeuralNetwork::Model> model;
+  StartupTrace::Deferred initialization; /**< Loads and compiles the network in the background. */
 };
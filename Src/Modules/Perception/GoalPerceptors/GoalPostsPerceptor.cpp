@@ -9,6 +9,7 @@
 #include "Debugging/Annotation.h"
 #include "Debugging/DebugDrawings.h"
 #include "GoalPostsPerceptor.h"
+#include "Framework/StartupTrace.h"
 #include "ImageProcessing/PatchUtilities.h"
 #include "Libs/ImageProcessing/PixelTypes.h"
 #include "Libs/ImageProcessing/Image.h"
@@ -25,11 +26,17 @@ GoalPostsPerceptor::GoalPostsPerceptor() :
   // Initialize models for the neural net
   classifier_model = std::make_unique<NeuralNetwork::Model>(std::string(File::getBHDir())
                                                             + "/Config/NeuralNets/GoalPostsPerceptor/classifier_model.h5");
-  classifier.compile(*classifier_model);
+  {
+    StartupTrace::Scope scope(StartupTrace::compilation, "GoalPostsPerceptor classifier");
+    classifier.compile(*classifier_model);
+  }
 
   detector_model = std::make_unique<NeuralNetwork::Model>(std::string(File::getBHDir())
                                                           + "/Config/NeuralNets/GoalPostsPerceptor/detector_model.h5");
-  detector.compile(*detector_model);
+  {
+    StartupTrace::Scope scope(StartupTrace::compilation, "GoalPostsPerceptor detector");
+    detector.compile(*detector_model);
+  }
 
   ASSERT(classifier.numOfInputs() == 1);
   ASSERT(detector.numOfInputs() == 1);
@@ -11,6 +11,7 @@
  */
 
 #include "FieldBoundaryProvider.h"
+#include "Framework/StartupTrace.h"
 #include "Platform/BHAssert.h"
 #include "Platform/File.h"
 #include "Debugging/DebugDrawings.h"
@@ -26,6 +27,7 @@ FieldBoundaryProvider::FieldBoundaryProvider() :
   model = std::make_unique<NeuralNetwork::Model>(std::string(File::getBHDir()) + ((theCameraInfo.camera == CameraInfo::upper) ? "/Config/NeuralNets/FieldBoundary/net.h5" : "/Config/NeuralNets/FieldBoundary/net-uncertainty.h5"));
   model->setInputUInt8(0);
 
+  StartupTrace::Scope scope(StartupTrace::compilation, "FieldBoundaryProvider");
   network.compile(*model);
 
   ASSERT(network.valid());
@@ -50,9 +52,13 @@ void FieldBoundaryProvider::update(FieldBoundary& fieldBoundary)
 
   fieldBoundary.boundaryInImage.clear();
   fieldBoundary.boundaryOnField.clear();
+  bool predicted = false;
   if((fieldBoundary.isValid = network.valid() && theCameraMatrix.isValid))
   {
-    if(!fieldBoundary.isValid)
+    if((predicted = detectionSchedule.maxSkippedFrames && lastBoundary.isValid
+                    && !detectionScheduler.shouldDetect(detectionSchedule, theCameraMatrix, theOdometryData, theCameraImage)))
+      predictLast(fieldBoundary);
+    else if(!fieldBoundary.isValid)
     {
       std::vector<Spot> spots;
       predictSpots(spots);
@@ -86,6 +92,12 @@ void FieldBoundaryProvider::update(FieldBoundary& fieldBoundary)
     fieldBoundary.boundaryInImage.clear();
     fieldBoundary.boundaryOnField.clear();
   }
+
+  if(detectionSchedule.maxSkippedFrames && !predicted)
+  {
+    lastBoundary = fieldBoundary;
+    detectionScheduler.detected(theCameraMatrix, theImageCoordinateSystem, theOdometryData, theCameraImage);
+  }
 }
 
 void FieldBoundaryProvider::validatePrediction(FieldBoundary& fieldBoundary, std::vector<Spot>& spots)
@@ -142,6 +154,22 @@ void FieldBoundaryProvider::projectPrevious(FieldBoundary& fieldBoundary)
   fieldBoundary.extrapolated = true;
 }
 
+void FieldBoundaryProvider::predictLast(FieldBoundary& fieldBoundary)
+{
+  for(const Vector2f& lastSpotOnField : lastBoundary.boundaryOnField)
+  {
+    Vector2f spotInImage;
+    const Vector2f spotOnField = detectionScheduler.predict(lastSpotOnField, theOdometryData);
+    if(Transformation::robotToImage(spotOnField, theCameraMatrix, theCameraInfo, spotInImage))
+    {
+      fieldBoundary.boundaryInImage.emplace_back(theImageCoordinateSystem.fromCorrected(spotInImage).cast<int>());
+      fieldBoundary.boundaryOnField.emplace_back(spotOnField);
+    }
+  }
+  fieldBoundary.extrapolated = lastBoundary.extrapolated;
+  fieldBoundary.odd = lastBoundary.odd;
+}
+
 void FieldBoundaryProvider::predictSpots(std::vector<Spot>& spots)
 {
   unsigned char* input = reinterpret_cast<std::uint8_t*>(network.input(0).data());
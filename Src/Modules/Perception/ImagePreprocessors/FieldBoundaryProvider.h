@@ -15,6 +15,7 @@
 #include "Representations/Perception/ImagePreprocessing/CameraMatrix.h"
 #include "Representations/Perception/ImagePreprocessing/FieldBoundary.h"
 #include "Representations/Perception/ImagePreprocessing/ImageCoordinateSystem.h"
+#include "Tools/Perception/DetectionScheduler.h"
 #include "Math/Geometry.h"
 #include "Math/LeastSquares.h"
 #include "Framework/Module.h"
@@ -53,6 +54,7 @@ MODULE(FieldBoundaryProvider,
     (int)(4) top, /**< to which pixel points are considered as at the top*/
     (float)(6) uncertaintyLimit, /**< maximum average uncertainty of the non top spots to be not considered as odd */
     (int)(2) maxPointsUnderBorder, /**< how much the points are allowed to be below the lower end on average*/
+    (DetectionScheduler::Parameters) detectionSchedule, /**< When the network can be skipped and the previous boundary is predicted instead. */
   }),
 });
 
@@ -115,6 +117,12 @@ private:
    */
   void projectPrevious(FieldBoundary& fieldBoundary);
 
+  /**
+   * Predict where the field boundary of the last detection will be in the current image.
+   * @param fieldBoundary The field boundary that is updated.
+   */
+  void predictLast(FieldBoundary& fieldBoundary);
+
   void predictSpots(std::vector<Spot>& spots);
 
   /**
@@ -149,4 +157,6 @@ private:
   std::unique_ptr<NeuralNetwork::Model> model; /**< The model of the neural network. */
   NeuralNetwork::CompiledNN network; /**< The compiled neural network. */
   Vector2i patchSize;  /**< The width and height of the neural network input image. */
+  DetectionScheduler detectionScheduler; /**< Decides when the network must be applied again. */
+  FieldBoundary lastBoundary; /**< The field boundary of the last detection. */
 };
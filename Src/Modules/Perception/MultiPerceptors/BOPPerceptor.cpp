@@ -8,6 +8,7 @@
  */
 
 #include "BOPPerceptor.h"
+#include "Framework/StartupTrace.h"
 #include "Platform/BHAssert.h"
 #include "Platform/File.h"
 #include "Debugging/DebugImages.h"
@@ -30,6 +31,7 @@ BOPPerceptor::BOPPerceptor() :
 #if defined MACOS && defined __arm64__
   settings.useCoreML = true;
 #endif
+  StartupTrace::Scope scope(StartupTrace::compilation, "BOPPerceptor");
   network.compile(*model, settings);
 
   ASSERT(network.valid());
@@ -62,6 +64,10 @@ bool BOPPerceptor::apply()
   if(theCameraInfo.width != inputSize.x() || theCameraInfo.height != inputSize.y())
     return false;
 
+  lastPrediction = theCameraImage.timestamp;
+  if((skipped = !detectionScheduler.shouldDetect(detectionSchedule, theCameraMatrix, theOdometryData, theCameraImage)))
+    return true;
+
   static_assert(std::is_same<CameraImage::PixelType, PixelTypes::YUYVPixel>::value);
   // TODO: CompiledNN should be able to take an external buffer as input (but this is more complicated than one could think).
   // In the meantime, one could directly convert to float in this copy operation using SSE.
@@ -69,7 +75,8 @@ bool BOPPerceptor::apply()
   STOPWATCH("module:BOPPerceptor:apply")
     network.apply();
 
-  lastPrediction = theCameraImage.timestamp;
+  if(detectionSchedule.maxSkippedFrames)
+    detectionScheduler.detected(theCameraMatrix, theImageCoordinateSystem, theOdometryData, theCameraImage);
 
   COMPLEX_IMAGE("ball")
   {
@@ -104,6 +111,20 @@ bool BOPPerceptor::apply()
   return true;
 }
 
+bool BOPPerceptor::outputToImage(const Vector2i& positionInOutput, Vector2i& positionInImage) const
+{
+  positionInImage = Vector2i(positionInOutput.x() * scale.x() + scale.x() / 2, positionInOutput.y() * scale.y() + scale.y() / 2);
+  if(!skipped)
+    return true;
+
+  Vector2f predictedInImage;
+  if(!detectionScheduler.predict(positionInImage.cast<float>(), theCameraInfo, theCameraMatrix, theImageCoordinateSystem, theOdometryData, predictedInImage))
+    return false;
+  positionInImage = predictedInImage.cast<int>();
+  return positionInImage.x() >= 0 && positionInImage.x() < theCameraInfo.width
+         && positionInImage.y() >= 0 && positionInImage.y() < theCameraInfo.height;
+}
+
 void BOPPerceptor::update(BallSpots& ballSpots)
 {
   ballSpots.ballSpots.clear();
@@ -128,8 +149,9 @@ void BOPPerceptor::update(BallSpots& ballSpots)
       }
       data += numOfChannels;
     }
-  if(max > ballThreshold)
-    ballSpots.addBallSpot(maxPos.x() * scale.x() + scale.x() / 2, maxPos.y() * scale.y() + scale.y() / 2);
+  Vector2i spot;
+  if(max > ballThreshold && outputToImage(maxPos, spot))
+    ballSpots.addBallSpot(spot.x(), spot.y());
 }
 
 void BOPPerceptor::update(PenaltyMarkRegions& penaltyMarkRegions)
@@ -155,9 +177,9 @@ void BOPPerceptor::update(PenaltyMarkRegions& penaltyMarkRegions)
       }
       data += numOfChannels;
     }
-  if(max > penaltyMarkThreshold)
+  Vector2i center;
+  if(max > penaltyMarkThreshold && outputToImage(maxPos, center))
   {
-    const Vector2i center(maxPos.x() * scale.x() + scale.x() / 2, maxPos.y() * scale.y() + scale.y() / 2);
     float expectedWidth;
     float expectedHeight;
     static constexpr float sizeToleranceRatio = 0.5f;
@@ -209,6 +231,20 @@ void BOPPerceptor::update(ObstacleScan& obstacleScan)
       if(f > obstaclesThreshold)
       {
         obstacleScan.yLowerInImage[x] = y * yStep + yStep / 2;
+        if(skipped)
+        {
+          // The column is kept, because the camera did not move much since the network was applied.
+          Vector2f predictedInImage;
+          if(detectionScheduler.predict(Vector2f(obstacleScan.xOffsetInImage + x * obstacleScan.xStepInImage, obstacleScan.yLowerInImage[x]),
+                                        theCameraInfo, theCameraMatrix, theImageCoordinateSystem, theOdometryData, predictedInImage)
+             && predictedInImage.y() >= 0.f && predictedInImage.y() < static_cast<float>(theCameraInfo.height))
+            obstacleScan.yLowerInImage[x] = static_cast<int>(predictedInImage.y());
+          else
+          {
+            obstacleScan.yLowerInImage[x] = -1;
+            break;
+          }
+        }
         if(!Transformation::imageToRobot(theImageCoordinateSystem.toCorrected(Vector2f(obstacleScan.xOffsetInImage + x * obstacleScan.xStepInImage, obstacleScan.yLowerInImage[x])), theCameraMatrix, theCameraInfo, obstacleScan.pointsOnField[x]))
           obstacleScan.yLowerInImage[x] = -1;
         break;
@@ -12,12 +12,14 @@
 #include "Representations/Configuration/FieldDimensions.h"
 #include "Representations/Infrastructure/CameraImage.h"
 #include "Representations/Infrastructure/CameraInfo.h"
+#include "Representations/MotionControl/OdometryData.h"
 #include "Representations/Perception/BallPercepts/BallSpots.h"
 #include "Representations/Perception/ImagePreprocessing/CameraMatrix.h"
 #include "Representations/Perception/ImagePreprocessing/ImageCoordinateSystem.h"
 #include "Representations/Perception/ImagePreprocessing/ImageRegions.h"
 #include "Representations/Perception/ImagePreprocessing/SegmentedObstacleImage.h"
 #include "Representations/Perception/ObstaclesPercepts/ObstacleScan.h"
+#include "Tools/Perception/DetectionScheduler.h"
 #include "Math/Boundary.h"
 #include "Math/Eigen.h"
 #include "Framework/Module.h"
@@ -32,6 +34,7 @@ MODULE(BOPPerceptor,
   REQUIRES(CameraMatrix),
   REQUIRES(FieldDimensions),
   REQUIRES(ImageCoordinateSystem),
+  REQUIRES(OdometryData),
   PROVIDES(BallSpots),
   PROVIDES(PenaltyMarkRegions),
   PROVIDES(ObstacleScan),
@@ -41,6 +44,7 @@ MODULE(BOPPerceptor,
     (float)(0.1f) ballThreshold, /**< Threshold from which a ball spot is created. */
     (float)(0.5f) penaltyMarkThreshold, /**< Threshold from which a penalty mark region is created. */
     (float)(0.8f) obstaclesThreshold, /**< Threshold from which an obstacle is created. */
+    (DetectionScheduler::Parameters) detectionSchedule, /**< When the network can be skipped and its previous output is predicted instead. */
   }),
 });
 
@@ -53,10 +57,20 @@ public:
 private:
   /**
    * Runs the neural network on the current camera image if it hasn't been done this frame.
+   * The network is skipped if the detection scheduler allows it. In that case, the output
+   * of a previous image is used and the positions derived from it are predicted.
    * @return Whether there is a valid prediction for the current image.
    */
   bool apply();
 
+  /**
+   * Converts a position in the network output into the current image.
+   * @param positionInOutput The position in the network output.
+   * @param positionInImage The position in the current image.
+   * @return Is the position valid? It might not be predictable into the current image.
+   */
+  bool outputToImage(const Vector2i& positionInOutput, Vector2i& positionInImage) const;
+
   void update(BallSpots& ballSpots) override;
 
   void update(PenaltyMarkRegions& penaltyMarkRegions) override;
@@ -76,5 +90,7 @@ private:
   Vector2i outputSize; /**< Output size of the neural network. */
   Vector2i scale; /**< Scale of the neural network (input size / output size). */
 
-  unsigned lastPrediction = 0; /**< Timestamp of the last image on which the network has been run. */
+  unsigned lastPrediction = 0; /**< Timestamp of the last image for which a prediction exists. */
+  bool skipped = false; /**< Is the network output from an image before the current one? */
+  DetectionScheduler detectionScheduler; /**< Decides when the network must be applied again. */
 };
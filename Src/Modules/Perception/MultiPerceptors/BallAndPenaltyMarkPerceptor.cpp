@@ -11,10 +11,12 @@
  */
 
 #include "BallAndPenaltyMarkPerceptor.h"
+#include "Framework/StartupTrace.h"
 #include "Platform/File.h"
 #include "Platform/SystemCall.h"
 #include "Debugging/DebugDrawings.h"
 #include "Debugging/Stopwatch.h"
+#include "Framework/ModuleGraphRunner.h"
 #include "Streaming/Global.h"
 #include "Tools/Math/Projection.h"
 #include "Tools/Math/Transformation.h"
@@ -128,6 +130,10 @@ void BallAndPenaltyMarkPerceptor::updateBallAndPenaltyMarkPerceptor()
   if(ballSpots.empty())
     return;
 
+  // If the thread is running late, the ball spots are preferred over the penalty mark regions appended last.
+  if(ballSpots.size() > maxNumberOfSpotsWhenLate && ModuleGraphRunner::getRemainingBudget() < minRemainingBudget)
+    ballSpots.resize(maxNumberOfSpotsWhenLate);
+
   float probBall, probPenalty;
   Vector2f ballPosition, penaltyPosition;
 
@@ -258,6 +264,7 @@ void BallAndPenaltyMarkPerceptor::compile()
     multiheadModel->setInputUInt8(0);
   }
 
+  StartupTrace::Scope scope(StartupTrace::compilation, "BallAndPenaltyMarkPerceptor");
   multihead.compile(*multiheadModel);
 
   ASSERT(multihead.numOfInputs() == 1);
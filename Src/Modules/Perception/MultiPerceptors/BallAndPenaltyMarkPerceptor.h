@@ -71,6 +71,8 @@ MODULE(BallAndPenaltyMarkPerceptor,
     (bool) useFloat,
     (PatchUtilities::ExtractionMode) extractionMode,
     (float) penaltyThreshold, /**< Limit from which a penalty mark is accepted. */
+    (unsigned) maxNumberOfSpotsWhenLate, /**< The maximum number of spots classified if the thread is running out of its frame budget. */
+    (float) minRemainingBudget, /**< Fewer spots are classified if less of the frame budget than this is left (in ms). */
   }),
 });
 
@@ -12,7 +12,9 @@
 
 #include "CompiledNN/Model.h"
 #include "Debugging/DebugDrawings.h"
+#include "Debugging/Plot.h"
 #include "Debugging/Stopwatch.h"
+#include "Framework/StartupTrace.h"
 #include "ImageProcessing/PatchUtilities.h"
 #include "ImageProcessing/Resize.h"
 #include "Math/BHMath.h"
@@ -65,6 +67,7 @@ template<typename Model, typename ConvModel, typename CompilationSettings>
 void RobotDetector::initializeModel(const std::unique_ptr<Model>& model, ConvModel& convModel, const CompilationSettings& settings)
 {
   model->setInputUInt8(0); // This converts the uint8 image to floats for the model
+  StartupTrace::Scope scope(StartupTrace::compilation, "RobotDetector");
   convModel.compile(*model, settings);
   ASSERT(convModel.numOfInputs() == 1);
   ASSERT(convModel.input(0).rank() == 3);
@@ -124,23 +127,75 @@ void RobotDetector::update(ObstaclesPerceptorData& theObstaclesPerceptorData)
 
 void RobotDetector::extractImageObstaclesFromNetwork(std::vector<ObstaclesImagePercept::Obstacle>& obstacles)
 {
+  DECLARE_PLOT("module:RobotDetector:inferenceDuration");
+  DECLARE_PLOT("module:RobotDetector:waitDuration");
+  DECLARE_PLOT("module:RobotDetector:savedDuration");
+  DECLARE_PLOT("module:RobotDetector:skippedFrames");
+
   if(useOnnx ? !onnxConvModel.valid() : !cnnConvModel.valid())
     return;
 
+  if(inferenceMode == InferenceWorker::synchronous)
+    inferenceWorker.reset();
+  else if(!inferenceWorker)
+    inferenceWorker = std::make_unique<InferenceWorker>();
+
   LabelImage labelImage;
 
-  if(networkParameters.inputChannels == 1)
-    applyGrayscaleNetwork();
-  else
-    applyColorNetwork();
+  // Decodes the network output into labelImage after the network was applied.
+  const auto decode = [&](bool fromPreviousFrame)
+  {
+    if(inferenceWorker)
+    {
+      PLOT("module:RobotDetector:inferenceDuration", inferenceWorker->getJobDuration());
+      PLOT("module:RobotDetector:waitDuration", inferenceWorker->getWaitDuration());
+      PLOT("module:RobotDetector:savedDuration", inferenceWorker->getSavedDuration());
+    }
 
-  if(useOnnx)
-    STOPWATCH("module:RobotDetector:boundingBoxes") boundingBoxes(labelImage, onnxConvModel);
-  else
-    STOPWATCH("module:RobotDetector:boundingBoxes") boundingBoxes(labelImage, cnnConvModel);
+    labelImage.annotations.clear();
+    if(useOnnx)
+      STOPWATCH("module:RobotDetector:boundingBoxes") boundingBoxes(labelImage, onnxConvModel, fromPreviousFrame);
+    else
+      STOPWATCH("module:RobotDetector:boundingBoxes") boundingBoxes(labelImage, cnnConvModel, fromPreviousFrame);
 
-  STOPWATCH("module:RobotDetector:nonMaximumSuppression") labelImage.nonMaximumSuppression(nonMaximumSuppressionIoUThreshold);
-  STOPWATCH("module:RobotDetector:bigBoxSuppression") labelImage.bigBoxSuppression();
+    STOPWATCH("module:RobotDetector:nonMaximumSuppression") labelImage.nonMaximumSuppression(nonMaximumSuppressionIoUThreshold);
+    STOPWATCH("module:RobotDetector:bigBoxSuppression") labelImage.bigBoxSuppression();
+
+    if(detectionSchedule.maxSkippedFrames)
+      trackBoundingBoxes(labelImage);
+  };
+
+  // The output of the previous frame must be decoded before the network is applied again.
+  const bool hasResult = inferenceWorker && inferenceWorker->isBusy();
+  if(hasResult)
+  {
+    inferenceWorker->wait();
+    decode(true);
+  }
+
+  // Without a new result, the robots detected before are predicted into this image while that is good enough.
+  if(detectionScheduler.shouldDetect(detectionSchedule, theCameraMatrix, theOdometryData, theECImage.grayscaled)
+     || (!hasResult && !predictTrackedBoundingBoxes(labelImage)))
+  {
+    if(networkParameters.inputChannels == 1)
+      fillGrayscaleInput();
+    else
+      fillColorInput();
+
+    if(inferenceMode == InferenceWorker::synchronous)
+    {
+      STOPWATCH("module:RobotDetector:apply") applyNetwork();
+      decode(false);
+    }
+    else
+    {
+      submittedCameraMatrix = theCameraMatrix;
+      submittedImageCoordinateSystem = theImageCoordinateSystem;
+      submittedOdometry = theOdometryData;
+      inferenceWorker->submit([this] {applyNetwork();});
+    }
+  }
+  PLOT("module:RobotDetector:skippedFrames", detectionScheduler.getSkippedFrames());
 
   for(const LabelImage::Annotation& box : labelImage.annotations)
   {
@@ -189,7 +244,7 @@ void RobotDetector::fillChromaThumbnails()
   SEND_DEBUG_IMAGE("BlueChromaThumbnail", blueChromaThumbnail);
 }
 
-void RobotDetector::applyGrayscaleNetwork()
+void RobotDetector::fillGrayscaleInput()
 {
   ASSERT(networkParameters.inputChannels == 1);
   fillGrayscaleThumbnail();
@@ -201,7 +256,6 @@ void RobotDetector::applyGrayscaleNetwork()
 
     STOPWATCH("module:RobotDetector:normalizeContrast") PatchUtilities::normalizeContrast<unsigned char>(
           reinterpret_cast<unsigned char*>(onnxConvModel.input(0).data()), inputImageSize, 0.02f);
-    STOPWATCH("module:RobotDetector:apply") onnxConvModel.apply();
   }
   else
   {
@@ -210,11 +264,10 @@ void RobotDetector::applyGrayscaleNetwork()
 
     STOPWATCH("module:RobotDetector:normalizeContrast") PatchUtilities::normalizeContrast<unsigned char>(
           reinterpret_cast<unsigned char*>(cnnConvModel.input(0).data()), inputImageSize, 0.02f);
-    STOPWATCH("module:RobotDetector:apply") cnnConvModel.apply();
   }
 }
 
-void RobotDetector::applyColorNetwork()
+void RobotDetector::fillColorInput()
 {
   ASSERT(networkParameters.inputChannels == 3);
   fillGrayscaleThumbnail();
@@ -238,15 +291,18 @@ void RobotDetector::applyColorNetwork()
       inputPos[2] = vPos[0];
     }
   }
+}
 
+void RobotDetector::applyNetwork()
+{
   if(useOnnx)
-    STOPWATCH("module:RobotDetector:apply") onnxConvModel.apply();
+    onnxConvModel.apply();
   else
-    STOPWATCH("module:RobotDetector:apply") cnnConvModel.apply();
+    cnnConvModel.apply();
 }
 
 template<typename ConvModel>
-void RobotDetector::boundingBoxes(LabelImage& labelImage, ConvModel& convModel)
+void RobotDetector::boundingBoxes(LabelImage& labelImage, ConvModel& convModel, bool fromPreviousFrame)
 {
   const float objectThreshold = logit(objectThres);
   for(unsigned y = 0; y < networkParameters.outputHeight; ++y)
@@ -262,6 +318,8 @@ void RobotDetector::boundingBoxes(LabelImage& labelImage, ConvModel& convModel)
         {
           Eigen::Map<Eigen::Vector<float, 5>> pred(convModel.output(0).data() + offset);
           LabelImage::Annotation box = predictionToBoundingBox(pred, y, x, b);
+          if(fromPreviousFrame)
+            compensateBoundingBox(box);
           if(static_cast<float>(theFieldBoundary.getBoundaryY(static_cast<int>((box.lowerRight.x() + box.upperLeft.x()) / 2.f))) > box.lowerRight.y())
             continue;
           labelImage.annotations.emplace_back(box);
@@ -312,6 +370,89 @@ LabelImage::Annotation RobotDetector::predictionToBoundingBox(Eigen::Map<Eigen::
   return box;
 }
 
+void RobotDetector::compensateBoundingBox(LabelImage::Annotation& box) const
+{
+  const Vector2f footInImage((box.upperLeft.x() + box.lowerRight.x()) / 2.f, box.lowerRight.y());
+  Vector2f footOnField;
+  if(!Transformation::imageToRobot(submittedImageCoordinateSystem.toCorrected(footInImage), submittedCameraMatrix, theCameraInfo, footOnField))
+    return;
+
+  const Vector2f currentFootOnField = (theOdometryData.inverse() * submittedOdometry) * footOnField;
+  Vector2f currentFootInImage;
+  if(!Transformation::robotToImage(currentFootOnField, theCameraMatrix, theCameraInfo, currentFootInImage))
+    return;
+  currentFootInImage = theImageCoordinateSystem.fromCorrected(currentFootInImage);
+
+  const float scale = footOnField.norm() / std::max(currentFootOnField.norm(), 1.f);
+  const Vector2f size = (box.lowerRight - box.upperLeft) * scale;
+  box.upperLeft = Vector2f(currentFootInImage.x() - size.x() / 2.f, currentFootInImage.y() - size.y());
+  box.lowerRight = Vector2f(currentFootInImage.x() + size.x() / 2.f, currentFootInImage.y());
+}
+
+void RobotDetector::trackBoundingBoxes(const LabelImage& labelImage)
+{
+  trackedBoxes = labelImage.annotations;
+  trackedBrightnesses.clear();
+  for(const LabelImage::Annotation& box : trackedBoxes)
+    trackedBrightnesses.push_back(getMeanBrightness(box));
+  detectionScheduler.detected(theCameraMatrix, theImageCoordinateSystem, theOdometryData, theECImage.grayscaled);
+}
+
+bool RobotDetector::predictTrackedBoundingBoxes(LabelImage& labelImage) const
+{
+  bool confirmed = true;
+  for(std::size_t i = 0; i < trackedBoxes.size(); ++i)
+  {
+    LabelImage::Annotation box = trackedBoxes[i];
+    const Vector2f footInImage((box.upperLeft.x() + box.lowerRight.x()) / 2.f, box.lowerRight.y());
+    Vector2f predictedFootInImage;
+    float scale;
+    if(!detectionScheduler.predict(footInImage, theCameraInfo, theCameraMatrix, theImageCoordinateSystem, theOdometryData, predictedFootInImage, &scale))
+    {
+      confirmed = false;
+      continue;
+    }
+
+    const Vector2f size = (box.lowerRight - box.upperLeft) * scale;
+    box.upperLeft = Vector2f(predictedFootInImage.x() - size.x() / 2.f, predictedFootInImage.y() - size.y());
+    box.lowerRight = Vector2f(predictedFootInImage.x() + size.x() / 2.f, predictedFootInImage.y());
+
+    const float brightness = getMeanBrightness(box);
+    if(brightness < 0.f || trackedBrightnesses[i] < 0.f)
+      continue;
+    if(std::abs(brightness - trackedBrightnesses[i]) > maxBoxBrightnessChange)
+    {
+      confirmed = false;
+      continue;
+    }
+    if(static_cast<float>(theFieldBoundary.getBoundaryY(static_cast<int>((box.lowerRight.x() + box.upperLeft.x()) / 2.f))) > box.lowerRight.y())
+      continue;
+    labelImage.annotations.emplace_back(box);
+  }
+  return confirmed;
+}
+
+float RobotDetector::getMeanBrightness(const LabelImage::Annotation& box) const
+{
+  static constexpr int step = 4;
+  const int minX = std::max(static_cast<int>(box.upperLeft.x()), 0);
+  const int minY = std::max(static_cast<int>(box.upperLeft.y()), 0);
+  const int maxX = std::min(static_cast<int>(box.lowerRight.x()), static_cast<int>(theECImage.grayscaled.width));
+  const int maxY = std::min(static_cast<int>(box.lowerRight.y()), static_cast<int>(theECImage.grayscaled.height));
+  if(minX >= maxX || minY >= maxY)
+    return -1.f;
+
+  unsigned sum = 0;
+  unsigned count = 0;
+  for(int y = minY; y < maxY; y += step)
+    for(int x = minX; x < maxX; x += step)
+    {
+      sum += theECImage.grayscaled[y][x];
+      ++count;
+    }
+  return static_cast<float>(sum) / static_cast<float>(count);
+}
+
 void RobotDetector::mergeObstacles(ObstaclesFieldPercept& theObstaclesFieldPercept, std::vector<ObstaclesImagePercept::Obstacle>& obstacles)
 {
   bool mergeObstacles = false;
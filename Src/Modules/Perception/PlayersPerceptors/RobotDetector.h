@@ -30,6 +30,8 @@
 #include "Framework/Module.h"
 #include "ImageProcessing/LabelImage.h"
 #include "Math/Eigen.h"
+#include "Tools/Framework/InferenceWorker.h"
+#include "Tools/Perception/DetectionScheduler.h"
 #include "CompiledNN/CompiledNN.h"
 #include "CompiledNN2ONNX/CompiledNN.h"
 
@@ -105,6 +107,9 @@ MODULE(RobotDetector,
     (bool)(true) mergeLowerObstacles, /**< Whether overlapping obstacles should be merged (only for the lower camera). */
     (Vector2f)(0.02f, 0.04f) pRobotRotationDeviationInStand, /**< Deviation of the rotation of the robot's torso while standing. */
     (Vector2f)(0.04f, 0.04f) pRobotRotationDeviation,        /**< Deviation of the rotation of the robot's torso. */
+    (InferenceWorker::Mode)(InferenceWorker::synchronous) inferenceMode, /**< Where the network is applied and when its result is used (upper camera only). */
+    (DetectionScheduler::Parameters) detectionSchedule, /**< When the network can be skipped and the previous robots are predicted instead (upper camera only). */
+    (float)(20.f) maxBoxBrightnessChange, /**< A predicted robot is not confirmed if the mean brightness of its box changed more (0..255). */
   }),
 });
 
@@ -128,6 +133,15 @@ private:
   Image<PixelTypes::GrayscaledPixel> blueChromaThumbnail;
   std::vector<ObstaclesImagePercept::Obstacle> obstaclesUpper, obstaclesLower;
 
+  std::unique_ptr<InferenceWorker> inferenceWorker; /**< Applies the network if the inference mode is not synchronous. */
+  CameraMatrix submittedCameraMatrix; /**< The camera matrix of the image the network is applied to by the worker. */
+  ImageCoordinateSystem submittedImageCoordinateSystem; /**< The image coordinate system of the image the network is applied to by the worker. */
+  Pose2f submittedOdometry; /**< The odometry when the image the worker applies the network to was taken. */
+
+  DetectionScheduler detectionScheduler; /**< Decides when the network must be applied again. */
+  std::vector<LabelImage::Annotation> trackedBoxes; /**< The boxes of the last detection that are predicted while the network is skipped. */
+  std::vector<float> trackedBrightnesses; /**< The mean brightnesses of the tracked boxes when they were detected. */
+
   // todo: move model_path into the config or extract config_path from model_path
   const std::string model_path = "/Config/NeuralNets/RobotDetector/4_anchor_boxes_model_no_activation_20230629-220730.hdf5";
   const std::string model_config_path = "NeuralNets/RobotDetector/4_anchor_boxes_20230629-220730.cfg";
@@ -211,23 +225,62 @@ private:
    void fillChromaThumbnails();
 
   /**
-   * Applies the cnnConvModel on the downscaled grayscale image.
+   * Copies the downscaled grayscale image into the input of the network.
+   */
+  void fillGrayscaleInput();
+
+  /**
+   * Copies a downscaled YUV image into the input of the network.
    */
-  void applyGrayscaleNetwork();
+  void fillColorInput();
 
   /**
-   * Applies the cnnConvModel on a downscaled YUV image.
+   * Applies the network on its input. Can be executed by the inference worker.
    */
-  void applyColorNetwork();
+  void applyNetwork();
 
   /**
    * This method gets the bounding boxes from the network output.
    * @tparam ConvModel Type of the network. Either NeuralNetwork::CompiledNN or NeuralNetworkONNX::CompiledNN
    * @param the bounding boxes
    * @param convModel network model
+   * @param fromPreviousFrame Was the network applied to the image of the previous frame?
+   *                          In that case, the boxes are moved to where the robots should be in the current image.
    */
   template<typename ConvModel>
-  void boundingBoxes(LabelImage& labelImage, ConvModel& convModel);
+  void boundingBoxes(LabelImage& labelImage, ConvModel& convModel, bool fromPreviousFrame);
+
+  /**
+   * Moves a bounding box detected in the image submitted to the inference worker to where it
+   * should appear in the current image. The foot point is projected to the field, moved by the
+   * odometry offset between both images and projected back. The size is scaled with the
+   * change of the distance. If a projection fails, the box is not changed.
+   * @param box The bounding box that is updated.
+   */
+  void compensateBoundingBox(LabelImage::Annotation& box) const;
+
+  /**
+   * Remembers the boxes detected in the current image, so that they can be
+   * predicted into the following images while the network is skipped.
+   * @param labelImage The boxes detected.
+   */
+  void trackBoundingBoxes(const LabelImage& labelImage);
+
+  /**
+   * Predicts the boxes of the last detection into the current image and confirms
+   * them by comparing their mean brightnesses. Boxes that left the image or are
+   * above the field boundary are dropped.
+   * @param labelImage The label image to which the confirmed boxes are added.
+   * @return Were all boxes still in the image confirmed?
+   */
+  bool predictTrackedBoundingBoxes(LabelImage& labelImage) const;
+
+  /**
+   * Computes the mean brightness inside a box in the current image by sampling it.
+   * @param box The box.
+   * @return The mean brightness or -1 if the box is outside of the image.
+   */
+  float getMeanBrightness(const LabelImage::Annotation& box) const;
 
   /**
    * Computes the bounding box position and size, given a prediction form the network.
@@ -11,6 +11,7 @@
 #include "KeypointsProvider.h"
 #include "Debugging/DebugDrawings.h"
 #include "Debugging/DebugImages.h"
+#include "Framework/StartupTrace.h"
 #include "ImageProcessing/ColorModelConversions.h"
 #include "Platform/File.h"
 #include "Streaming/Global.h"
@@ -149,6 +150,7 @@ void KeypointsProvider::compileNetwork()
   NeuralNetworkONNX::CompilationSettings settings;
   settings.useCoreML = true;
   settings.numOfThreads = 2;
+  StartupTrace::Scope scope(StartupTrace::compilation, "KeypointsProvider");
   detector.compile(NeuralNetworkONNX::Model(std::string(File::getBHDir()) + "/" + filename),
                    settings);
 }
@@ -8,6 +8,7 @@
 
 #include "JointAnglePredictor.h"
 #include "Debugging/Annotation.h"
+#include "Framework/StartupTrace.h"
 #include "Platform/SystemCall.h"
 
 #include <filesystem>
@@ -87,6 +88,7 @@ void JointAnglePredictor::compile(bool output)
   else
     ASSERT(std::filesystem::exists(modelPath + modelName));
 
+  StartupTrace::Scope scope(StartupTrace::compilation, "JointAnglePredictor");
   network.compile(Model(modelPath + modelName));
   ASSERT(network.valid());
 
@@ -28,11 +28,14 @@ STREAMABLE(CameraCalibrationStatus,
   {,
     idle, /**< Nothing special is done. */
     recordSamples, /**< Samples are constructed from observations. */
-    optimize, /**< The optimization is running (one iteration per frame). */
+    optimize, /**< The optimization is running (in the background). */
   }),
 
   (CameraCalibrationStatus::State)(CameraCalibrationStatus::State::idle) state,
   (int)(0) inStateSince,
   (SampleConfigurationStatus)(SampleConfigurationStatus::none) sampleConfigurationStatus,
   (unsigned)(0) sampleIndex, /**< Index of the current sample configuration. */
+  (unsigned)(0) optimizationSteps, /**< The number of optimization steps finished since the optimization was (re)started. */
+  (unsigned)(0) successiveConvergences, /**< The number of successive steps that fulfilled the termination criterion. */
+  (float)(0.f) optimizationDelta, /**< The norm of the parameter update in the last optimization step. */
 });
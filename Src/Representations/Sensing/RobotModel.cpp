@@ -8,6 +8,7 @@
 #include "Debugging/DebugDrawings3D.h"
 #include "Debugging/Plot.h"
 #include "Tools/Motion/ForwardKinematic.h"
+#include "Tools/Motion/KinematicsCache.h"
 
 RobotModel::RobotModel(const JointAngles& jointAngles, const RobotDimensions& robotDimensions, const MassCalibration& massCalibration)
 {
@@ -16,14 +17,45 @@ RobotModel::RobotModel(const JointAngles& jointAngles, const RobotDimensions& ro
 
 void RobotModel::setJointData(const JointAngles& jointAngles, const RobotDimensions& robotDimensions, const MassCalibration& massCalibration)
 {
-  ForwardKinematic::calculateHeadChain(jointAngles, robotDimensions, limbs);
-  ForwardKinematic::calculateArmChain(Arms::left, jointAngles, robotDimensions, limbs);
-  ForwardKinematic::calculateArmChain(Arms::right, jointAngles, robotDimensions, limbs);
-  ForwardKinematic::calculateLegChain(Legs::left, jointAngles, robotDimensions, limbs);
-  ForwardKinematic::calculateLegChain(Legs::right, jointAngles, robotDimensions, limbs);
-
-  soleLeft = limbs[Limbs::footLeft] + Vector3f(0.f, 0.f, -robotDimensions.footHeight);
-  soleRight = limbs[Limbs::footRight] + Vector3f(0.f, 0.f, -robotDimensions.footHeight);
+  KinematicsCache::getRobotModel(jointAngles, robotDimensions, massCalibration, *this);
+}
+
+/**
+ * Checks whether the joints of a chain have the same angles and variances.
+ * @param a The first joint data.
+ * @param b The second joint data.
+ * @param first The first joint of the chain.
+ * @param end The joint behind the chain.
+ * @return Are they the same?
+ */
+static bool sameChain(const JointAngles& a, const JointAngles& b, int first, int end)
+{
+  for(int i = first; i < end; ++i)
+    if(a.angles[i] != b.angles[i] || a.variance[i] != b.variance[i])
+      return false;
+  return true;
+}
+
+void RobotModel::calculate(const JointAngles& jointAngles, const RobotDimensions& robotDimensions, const MassCalibration& massCalibration,
+                           const JointAngles* previousJointAngles)
+{
+  const JointAngles* p = previousJointAngles;
+  if(!p || !sameChain(jointAngles, *p, Joints::headYaw, Joints::firstArmJoint))
+    ForwardKinematic::calculateHeadChain(jointAngles, robotDimensions, limbs);
+  if(!p || !sameChain(jointAngles, *p, Joints::lShoulderPitch, Joints::lHand))
+    ForwardKinematic::calculateArmChain(Arms::left, jointAngles, robotDimensions, limbs);
+  if(!p || !sameChain(jointAngles, *p, Joints::rShoulderPitch, Joints::rHand))
+    ForwardKinematic::calculateArmChain(Arms::right, jointAngles, robotDimensions, limbs);
+  if(!p || !sameChain(jointAngles, *p, Joints::lHipYawPitch, Joints::firstRightLegJoint))
+  {
+    ForwardKinematic::calculateLegChain(Legs::left, jointAngles, robotDimensions, limbs);
+    soleLeft = limbs[Limbs::footLeft] + Vector3f(0.f, 0.f, -robotDimensions.footHeight);
+  }
+  if(!p || !sameChain(jointAngles, *p, Joints::rHipYawPitch, Joints::numOfJoints))
+  {
+    ForwardKinematic::calculateLegChain(Legs::right, jointAngles, robotDimensions, limbs);
+    soleRight = limbs[Limbs::footRight] + Vector3f(0.f, 0.f, -robotDimensions.footHeight);
+  }
 
   updateCenterOfMass(massCalibration);
 }
@@ -34,13 +34,28 @@ STREAMABLE(RobotModel,
   RobotModel(const JointAngles& jointAngles, const RobotDimensions& robotDimensions, const MassCalibration& massCalibration);
 
   /**
-   * Recalculates the RobotModel from given joint data.
+   * Recalculates the RobotModel from given joint data. In the Motion thread,
+   * models are reused from the KinematicsCache.
    * @param joints The joint data.
    * @param robotDimensions The dimensions of the robot.
    * @param massCalibration The mass calibration of the robot.
    */
   void setJointData(const JointAngles& jointAngles, const RobotDimensions& robotDimensions, const MassCalibration& massCalibration);
 
+  /**
+   * Calculates the RobotModel from given joint data without using the
+   * KinematicsCache. If the joint data this model was calculated from is
+   * given, only the chains are recalculated whose joints differ.
+   * @param joints The joint data.
+   * @param robotDimensions The dimensions of the robot.
+   * @param massCalibration The mass calibration of the robot.
+   * @param previousJointAngles The joint data this model was calculated from
+   *                            with the same dimensions and mass calibration
+   *                            or \c nullptr to calculate all chains.
+   */
+  void calculate(const JointAngles& jointAngles, const RobotDimensions& robotDimensions, const MassCalibration& massCalibration,
+                 const JointAngles* previousJointAngles = nullptr);
+
   /**
    * Re-calculate the center of mass in this model.
    * @param massCalibration The mass calibration of the robot.
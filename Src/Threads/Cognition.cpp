@@ -10,6 +10,7 @@
 #include "Modules/Infrastructure/InterThreadProviders/PerceptionProviders.h"
 #include "Modules/Infrastructure/LogDataProvider/LogDataProvider.h"
 #include "Representations/Communication/BHumanMessageOutputGenerator.h"
+#include "Framework/ModuleGraphRunner.h"
 #include "Platform/SystemCall.h"
 #include "Platform/Thread.h"
 
@@ -53,6 +54,12 @@ bool Cognition::beforeFrame()
 
   const bool upperIsLate = static_cast<int>(lowerFrameTime - upperFrameTime) >= 100;
   const bool lowerIsLate = static_cast<int>(upperFrameTime - lowerFrameTime) >= 100;
+
+  // A camera thread that skips images to keep its target rate announces when its next image will be
+  // taken at the earliest. There is no need to wait for it if the other camera's image is older.
+  const ModuleGraphRunner& moduleGraphRunner = ModuleGraphRunner::getInstance();
+  const bool upperIsSkipping = !replay && static_cast<int>(moduleGraphRunner.getNextFrameTime("Upper") - lowerFrameTime) > 0;
+  const bool lowerIsSkipping = !replay && static_cast<int>(moduleGraphRunner.getNextFrameTime("Lower") - upperFrameTime) > 0;
   upperIsNew |= upperFrameTime != lastUpperFrameTime && upperFrameTime >= lastAcceptedTime;
   lowerIsNew |= lowerFrameTime != lastLowerFrameTime && lowerFrameTime >= lastAcceptedTime;
   lastUpperFrameTime = upperFrameTime;
@@ -60,7 +67,8 @@ bool Cognition::beforeFrame()
 
   // Begin a new frame if either there is data for a new one left over from
   // the previous frame or we have two from which we can choose.
-  if(acceptNext || (upperIsNew && lowerIsNew) || (upperIsNew && lowerIsLate) || (lowerIsNew && upperIsLate))
+  if(acceptNext || (upperIsNew && lowerIsNew) || (upperIsNew && (lowerIsLate || lowerIsSkipping))
+     || (lowerIsNew && (upperIsLate || upperIsSkipping)))
   {
     // The frame will be processed, so no delay and no data waiting anymore
     delayedLogCounter = 0;
@@ -69,10 +77,10 @@ bool Cognition::beforeFrame()
     if(replay)
       LogDataProvider::isFrameDataComplete();
 
-    // We switch between upper and lower except if one of them is really late
-    if(upperIsLate)
+    // We switch between upper and lower except if one of them is really late or skipped
+    if(upperIsLate || (lowerIsNew && !upperIsNew))
       isUpper = false;
-    else if(lowerIsLate)
+    else if(lowerIsLate || (upperIsNew && !lowerIsNew))
       isUpper = true;
     else
       isUpper ^= true;
@@ -9,21 +9,29 @@
 #include "Modules/Infrastructure/NaoProvider/NaoProvider.h" // include must be the first, because of Visual Studio
 #include "Motion.h"
 #include "Modules/Infrastructure/LogDataProvider/LogDataProvider.h"
+#include "Debugging/Plot.h"
 #include "Platform/Thread.h"
 #include "Platform/Time.h"
 #include "Math/Constants.h"
 #include "Framework/ModulePacket.h"
+#include "Tools/Motion/KinematicsCache.h"
 
 REGISTER_EXECUTION_UNIT(Motion)
 
 bool Motion::beforeFrame()
 {
+  KinematicsCache::beginFrame();
   return LogDataProvider::isFrameDataComplete();
 }
 
 void Motion::afterModules()
 {
   NaoProvider::finishFrame();
+
+  const KinematicsCache::Statistics statistics = KinematicsCache::takeStatistics();
+  PLOT("motion:kinematicsCache:hits", statistics.hits);
+  PLOT("motion:kinematicsCache:partialHits", statistics.partialHits);
+  PLOT("motion:kinematicsCache:misses", statistics.misses);
 }
 
 bool Motion::afterFrame()
@@ -9,12 +9,34 @@
 #include "Perception.h"
 #include "Modules/Infrastructure/CameraProvider/CameraProvider.h"
 #include "Modules/Infrastructure/LogDataProvider/LogDataProvider.h"
+#include "Representations/Infrastructure/FrameInfo.h"
+#include "Representations/Modeling/WorldModelPrediction.h"
+#include "Representations/Perception/BallPercepts/BallPercept.h"
+#include "Debugging/Plot.h"
+#include "Framework/ModuleGraphRunner.h"
+#include "Platform/Time.h"
 
 REGISTER_EXECUTION_UNIT(Perception)
 
 bool Perception::beforeFrame()
 {
-  return (LogDataProvider::isFrameDataComplete() && CameraProvider::isFrameDataComplete());
+  if(!LogDataProvider::isFrameDataComplete() || !CameraProvider::isFrameDataComplete())
+    return false;
+
+  // Images replayed from logs are never skipped.
+  imageTimestamp = CameraProvider::getImageTimestamp();
+  ModuleGraphRunner& moduleGraphRunner = ModuleGraphRunner::getInstance();
+  if(moduleGraphRunner.getProvider("CameraImage") != "CameraProvider")
+  {
+    moduleGraphRunner.setNextFrameTime(0);
+    return true;
+  }
+  else if(!isImageDue(moduleGraphRunner.getFrameSchedule(), imageTimestamp))
+    return false;
+
+  // Tell Cognition which images will be skipped to keep the rate, so it does not wait for them.
+  moduleGraphRunner.setNextFrameTime(getFrameRate(moduleGraphRunner.getFrameSchedule()) > 0.f ? nextImageDue - dueTolerance : 0);
+  return true;
 }
 
 void Perception::beforeModules()
@@ -27,6 +49,18 @@ void Perception::beforeModules()
   }
 }
 
+void Perception::afterModules()
+{
+  updateBallDistance();
+
+  processedImages.push_front(imageTimestamp);
+  const unsigned duration = processedImages.front() - processedImages.back();
+  PLOT("perception:frameRate", duration ? static_cast<float>(processedImages.size() - 1) * 1000.f / static_cast<float>(duration) : 0.f);
+  PLOT("perception:latency", Time::getTimeSince(imageTimestamp));
+  PLOT("perception:staleImages", staleImages);
+  PLOT("perception:rateLimitedImages", rateLimitedImages);
+}
+
 bool Perception::afterFrame()
 {
   if(Blackboard::getInstance().exists("CameraImage"))
@@ -44,3 +78,63 @@ bool Perception::afterFrame()
 
   return BHExecutionUnit::afterFrame();
 }
+
+bool Perception::isImageDue(const Configuration::FrameSchedule& schedule, unsigned timestamp)
+{
+  if(schedule.deadline && Time::getTimeSince(timestamp) > static_cast<int>(schedule.deadline))
+  {
+    ++staleImages;
+    return false;
+  }
+
+  const float rate = getFrameRate(schedule);
+  if(rate > 0.f)
+  {
+    const int late = static_cast<int>(timestamp - nextImageDue);
+    if(late < -dueTolerance)
+    {
+      ++rateLimitedImages;
+      return false;
+    }
+
+    // Keep the phase, but do not catch up after pauses or when the rate was raised.
+    const unsigned period = static_cast<unsigned>(1000.f / rate);
+    nextImageDue = late < static_cast<int>(period) ? nextImageDue + period : timestamp + period;
+  }
+  return true;
+}
+
+float Perception::getFrameRate(const Configuration::FrameSchedule& schedule) const
+{
+  const bool ballKnown = timeWhenBallLastSeen && Time::getTimeSince(timeWhenBallLastSeen) < ballTimeout;
+  for(const Configuration::FrameRate& frameRate : schedule.rates)
+    if(frameRate.maxBallDistance <= 0.f || (ballKnown && ballDistance < frameRate.maxBallDistance))
+      return frameRate.rate;
+  return 0.f;
+}
+
+void Perception::updateBallDistance()
+{
+  const Blackboard& blackboard = Blackboard::getInstance();
+
+  // The prediction from Cognition is only received if a module of this thread requires it.
+  if(blackboard.exists("WorldModelPrediction"))
+  {
+    const WorldModelPrediction& worldModelPrediction = static_cast<const WorldModelPrediction&>(blackboard["WorldModelPrediction"]);
+    if(worldModelPrediction.timeWhenBallLastSeen > timeWhenBallLastSeen)
+    {
+      timeWhenBallLastSeen = worldModelPrediction.timeWhenBallLastSeen;
+      ballDistance = worldModelPrediction.ballPosition.norm();
+    }
+  }
+
+  if(blackboard.exists("BallPercept") && blackboard.exists("FrameInfo"))
+  {
+    const BallPercept& ballPercept = static_cast<const BallPercept&>(blackboard["BallPercept"]);
+    if(ballPercept.status == BallPercept::seen)
+    {
+      timeWhenBallLastSeen = static_cast<const FrameInfo&>(blackboard["FrameInfo"]).time;
+      ballDistance = ballPercept.positionOnField.norm();
+    }
+  }
+}
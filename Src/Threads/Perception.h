@@ -9,16 +9,55 @@
 #pragma once
 
 #include "Tools/Framework/BHExecutionUnit.h"
+#include "Framework/Configuration.h"
+#include "Math/RingBuffer.h"
+#include <limits>
 
 /**
  * @class Perception
  *
- * The execution unit for a perception thread.
+ * The execution unit for a perception thread. It selects the images that are
+ * processed based on the frame schedule of the thread (see threads.cfg):
+ * Images that are already older than the deadline are skipped instead of
+ * being processed late, and the number of images processed per second can be
+ * limited depending on the distance to the ball. The effective frame rate and
+ * the latency of the percepts are plotted.
  */
 class Perception : public BHExecutionUnit
 {
 public:
   bool beforeFrame() override;
   void beforeModules() override;
+  void afterModules() override;
   bool afterFrame() override;
+
+private:
+  static constexpr int ballTimeout = 1000; /**< How long a ball distance is used to select a frame rate (in ms). */
+  static constexpr int dueTolerance = 5; /**< Images may be this early and are still considered as due (in ms). */
+
+  /**
+   * Decides whether an image from the camera is processed.
+   * @param schedule The frame schedule of this thread.
+   * @param timestamp The timestamp of the image.
+   * @return Should the image be processed?
+   */
+  bool isImageDue(const Configuration::FrameSchedule& schedule, unsigned timestamp);
+
+  /**
+   * Determines the current target frame rate.
+   * @param schedule The frame schedule of this thread.
+   * @return The number of images per second to process (0 = all).
+   */
+  float getFrameRate(const Configuration::FrameSchedule& schedule) const;
+
+  /** Remembers the distance to the ball from the representations of this thread. */
+  void updateBallDistance();
+
+  unsigned imageTimestamp = 0; /**< The timestamp of the image processed in this frame. */
+  unsigned nextImageDue = 0; /**< The timestamp from which on the next image is processed if the rate is limited. */
+  unsigned timeWhenBallLastSeen = 0; /**< When the ball was seen the last time. */
+  float ballDistance = std::numeric_limits<float>::max(); /**< The distance to the ball when it was seen the last time (in mm). */
+  unsigned staleImages = 0; /**< The number of images skipped because they were too old. */
+  unsigned rateLimitedImages = 0; /**< The number of images skipped to keep the target rate. */
+  RingBuffer<unsigned, 30> processedImages; /**< The timestamps of the images processed recently. */
 };
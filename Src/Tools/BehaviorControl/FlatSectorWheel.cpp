@@ -0,0 +1,190 @@
+/**
+ * @file FlatSectorWheel.cpp
+ *
+ * This file implements a variant of the SectorWheel that stores its sectors in a
+ * contiguous array.
+ */
+
+#include "FlatSectorWheel.h"
+#include "Platform/BHAssert.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+void FlatSectorWheel::begin(const Vector2f& positionOnField, float distance)
+{
+  this->positionOnField = positionOnField;
+
+  Sector& sector = buffer(current)[0];
+  sector.angleRange = Rangea(-pi, pi);
+  sector.distance = distance;
+  sector.type = Sector::free;
+  count = 1;
+}
+
+FlatSectorWheel::Sectors FlatSectorWheel::finish()
+{
+  Sector* sectors = buffer(current);
+  ASSERT(count > 0);
+  ASSERT(sectors[0].angleRange.min == -pi);
+  ASSERT(sectors[count - 1].angleRange.max == pi);
+  if(count > 1)
+  {
+    Sector& front = sectors[0];
+    Sector& back = sectors[count - 1];
+    if(front.distance == back.distance && front.type == back.type)
+    {
+      back.angleRange.max = front.angleRange.max;
+      std::move(sectors + 1, sectors + count, sectors);
+      --count;
+    }
+  }
+
+#ifndef NDEBUG
+  for(std::size_t i = 1; i < count; ++i)
+    ASSERT(sectors[i - 1].angleRange.max == sectors[i].angleRange.min);
+#endif
+
+  return Sectors(sectors, count);
+}
+
+FlatSectorWheel::Sectors FlatSectorWheel::finishWithoutCircleClosure()
+{
+  const Sector* sectors = buffer(current);
+  ASSERT(count > 0);
+  ASSERT(sectors[0].angleRange.min == -pi);
+  ASSERT(sectors[count - 1].angleRange.max == pi);
+
+#ifndef NDEBUG
+  for(std::size_t i = 1; i < count; ++i)
+    ASSERT(sectors[i - 1].angleRange.max == sectors[i].angleRange.min);
+#endif
+
+  return Sectors(sectors, count);
+}
+
+void FlatSectorWheel::addSector(const Vector2f& center, float width, Sector::Type type)
+{
+  return addSector(center, width, (center - positionOnField).norm(), type);
+}
+
+void FlatSectorWheel::addSector(const Vector2f& center, float width, float distance, Sector::Type type)
+{
+  const float radius = std::atan2(width / 2.f, distance);
+  const Angle direction = (center - positionOnField).angle();
+  const Angle left = direction + radius;
+  const Angle right = direction - radius;
+  addSector(Rangea(right, left), distance, type);
+}
+
+void FlatSectorWheel::addSector(const Rangea& angleRange, float distance, Sector::Type type)
+{
+  // The special cases are handled exactly as in SectorWheel::addSector.
+  if(angleRange.min == angleRange.max)
+    return;
+  if(angleRange.min > angleRange.max)
+  {
+    addSectorNormalized(Rangea(angleRange.min, pi), distance, type);
+    addSectorNormalized(Rangea(-pi, angleRange.max), distance, type);
+    return;
+  }
+  if(angleRange.max > pi)
+  {
+    ASSERT(angleRange.min < pi);
+    addSectorNormalized(Rangea(angleRange.min, pi), distance, type);
+    addSectorNormalized(Rangea(-pi, angleRange.max - pi2), distance, type);
+    return;
+  }
+  else if(angleRange.min < -pi)
+  {
+    addSectorNormalized(Rangea(-pi, angleRange.max), distance, type);
+    addSectorNormalized(Rangea(angleRange.min + pi2, pi), distance, type);
+    return;
+  }
+  addSectorNormalized(angleRange, distance, type);
+}
+
+void FlatSectorWheel::evaluate(const std::vector<Vector2f>& observers, const std::vector<Obstacle>& obstacles,
+                               const std::function<void(std::size_t, const Sectors&)>& handler, float distance)
+{
+  for(std::size_t i = 0; i < observers.size(); ++i)
+  {
+    begin(observers[i], distance);
+    for(const Obstacle& obstacle : obstacles)
+      addSector(obstacle.center, obstacle.width, obstacle.type);
+    handler(i, finish());
+  }
+}
+
+void FlatSectorWheel::addSectorNormalized(const Rangea& angleRange, float distance, Sector::Type type)
+{
+  if(angleRange.max == angleRange.min)
+    return;
+
+  // There should always be the [-pi, pi[ sector.
+  ASSERT(count > 0);
+  ASSERT(angleRange.max > angleRange.min);
+  ASSERT(angleRange.min >= -pi);
+  ASSERT(angleRange.max <= pi);
+
+  // Only the first and the last overlapped sector can be split, so the wheel grows by two sectors at most.
+  reserve(count + 2);
+  const Sector* source = buffer(current);
+  Sector* target = buffer(current ^ 1);
+  std::size_t targetCount = 0;
+
+  const auto append = [&](const Rangea& range, float distance, Sector::Type type)
+  {
+    Sector& sector = target[targetCount++];
+    sector.angleRange = range;
+    sector.distance = distance;
+    sector.type = type;
+  };
+
+  // Is the last sector in the target the new one, i.e. can it be extended?
+  bool contiguous = false;
+  for(const Sector* sector = source; sector != source + count; ++sector)
+  {
+    // The current sector does not overlap the new one or it is closer -> keep it.
+    if(sector->angleRange.max <= angleRange.min || sector->angleRange.min >= angleRange.max || distance > sector->distance)
+    {
+      target[targetCount++] = *sector;
+      contiguous = false;
+      continue;
+    }
+
+    // Keep the part of the current sector before the new one.
+    if(sector->angleRange.min < angleRange.min)
+      append(Rangea(sector->angleRange.min, angleRange.min), sector->distance, sector->type);
+
+    // Add the overlapping part of the new sector.
+    const Angle end = std::min(sector->angleRange.max, angleRange.max);
+    if(contiguous)
+      target[targetCount - 1].angleRange.max = end;
+    else
+      append(Rangea(std::max(angleRange.min, sector->angleRange.min), end), distance, type);
+
+    // Keep the part of the current sector after the new one.
+    if((contiguous = sector->angleRange.max <= angleRange.max))
+      continue;
+    append(Rangea(angleRange.max, sector->angleRange.max), sector->distance, sector->type);
+  }
+
+  current ^= 1;
+  count = targetCount;
+}
+
+void FlatSectorWheel::reserve(std::size_t capacity)
+{
+  if(onHeap ? capacity <= heapBuffers[0].size() : capacity <= inlineCapacity)
+    return;
+
+  const std::size_t newSize = std::max(capacity, 2 * (onHeap ? heapBuffers[0].size() : inlineCapacity));
+  heapBuffers[0].resize(newSize);
+  heapBuffers[1].resize(newSize);
+  if(!onHeap)
+  {
+    std::copy(inlineBuffers[current].begin(), inlineBuffers[current].begin() + count, heapBuffers[current].begin());
+    onHeap = true;
+  }
+}
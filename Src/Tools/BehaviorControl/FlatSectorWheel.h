@@ -0,0 +1,149 @@
+/**
+ * @file FlatSectorWheel.h
+ *
+ * This file declares a variant of the SectorWheel that stores its partition of
+ * [-pi, pi[ in a contiguous array instead of a linked list. The array lives inside
+ * the object as long as it does not exceed a small number of sectors, i.e. building
+ * a wheel does not allocate memory in the common case. In addition, a batched
+ * interface allows evaluating the same set of obstacles from many observer positions
+ * while reusing the storage.
+ */
+
+#pragma once
+
+#include "SectorWheel.h"
+#include <array>
+#include <functional>
+#include <vector>
+
+class FlatSectorWheel
+{
+public:
+  using Sector = SectorWheel::Sector;
+
+  /** The number of sectors that can be stored without allocating memory. */
+  static constexpr std::size_t inlineCapacity = 32;
+
+  /** A read-only view on the sectors of the wheel. It is invalidated by any modification of the wheel. */
+  class Sectors
+  {
+  public:
+    Sectors(const Sector* first, std::size_t count) : first(first), count(count) {}
+    const Sector* begin() const {return first;}
+    const Sector* end() const {return first + count;}
+    std::size_t size() const {return count;}
+    bool empty() const {return count == 0;}
+    const Sector& front() const {return first[0];}
+    const Sector& back() const {return first[count - 1];}
+    const Sector& operator[](std::size_t index) const {return first[index];}
+
+  private:
+    const Sector* first; /**< The first sector. */
+    std::size_t count; /**< The number of sectors. */
+  };
+
+  /** An object that is added to the wheel by the batched interface. */
+  struct Obstacle
+  {
+    Vector2f center; /**< The position of the object (in the same coordinate system as the observers). */
+    float width; /**< The width of the object. */
+    Sector::Type type; /**< The type of the sector the object creates. */
+  };
+
+  /**
+   * Calculates the wheel for a given center position (e.g. hypothetical ball position).
+   * @param positionOnField The center position.
+   * @param distance The distance from the wheel center at which this sector ends. Defaults to float::max.
+   */
+  void begin(const Vector2f& positionOnField, float distance = std::numeric_limits<float>::max());
+
+  /**
+   * Post-processes and returns the calculated wheel.
+   * @return The resulting wheel.
+   */
+  Sectors finish();
+
+  /**
+   * Post-processes and returns the calculated wheel.
+   * Does not reunite Sectors that go over -pi/pi border.
+   * @return The resulting wheel.
+   */
+  Sectors finishWithoutCircleClosure();
+
+  /**
+   * Adds a sector to the wheel.
+   *
+   * This is only a wrapper around the other addSector method.
+   * @param center The position of the object (in the same coordinate system as the wheel center).
+   * @param width The width of the object.
+   * @param type The type of the new sector.
+   */
+  void addSector(const Vector2f& center, float width, Sector::Type type);
+
+  /**
+   * Adds a sector to the wheel.
+   *
+   * This is only a wrapper around the other addSector method.
+   * @param center The position of the object (in the same coordinate system as the wheel center).
+   * @param width The width of the object.
+   * @param distance The distance of the new sector.
+   * @param type The type of the new sector.
+   */
+  void addSector(const Vector2f& center, float width, float distance, Sector::Type type);
+
+  /**
+   * Adds a sector to the wheel.
+   *
+   * This is only a wrapper around addSectorNormalized to handle the negative x axis and reverse ranges.
+   * @param angleRange The angular range of the new sector.
+   * @param distance The distance of the new sector.
+   * @param type The type of the new sector.
+   */
+  void addSector(const Rangea& angleRange, float distance, Sector::Type type);
+
+  /**
+   * Builds the wheel of the same obstacles for several observer positions.
+   * The storage is reused between the observers, so the whole batch does not
+   * allocate memory as long as no single wheel exceeds the inline capacity.
+   * @param observers The wheel centers.
+   * @param obstacles The objects that are added to each wheel.
+   * @param handler Called with the index of the observer and its finished wheel.
+   * @param distance The distance from the wheel centers at which the initial sector ends.
+   */
+  void evaluate(const std::vector<Vector2f>& observers, const std::vector<Obstacle>& obstacles,
+                const std::function<void(std::size_t, const Sectors&)>& handler,
+                float distance = std::numeric_limits<float>::max());
+
+private:
+  /**
+   * Adds a sector to the wheel.
+   *
+   * This methods does the real work. The current partition is merged with the
+   * new sector into the other buffer, which then becomes the current one.
+   * @param angleRange The angular range of the new sector.
+   * @param distance The distance of the new sector.
+   * @param type The type of the new sector.
+   */
+  void addSectorNormalized(const Rangea& angleRange, float distance, Sector::Type type);
+
+  /**
+   * Makes sure that both buffers can hold a certain number of sectors.
+   * If the inline buffers are too small, the sectors are moved to the heap.
+   * @param capacity The number of sectors required.
+   */
+  void reserve(std::size_t capacity);
+
+  /**
+   * Returns one of the two buffers.
+   * @param index The index of the buffer (0 or 1).
+   * @return The address of the first sector in the buffer.
+   */
+  Sector* buffer(std::size_t index) {return onHeap ? heapBuffers[index].data() : inlineBuffers[index].data();}
+
+  Vector2f positionOnField; /**< The current center of the wheel. */
+  std::array<std::array<Sector, inlineCapacity>, 2> inlineBuffers; /**< The two buffers used if the wheel is small. */
+  std::array<std::vector<Sector>, 2> heapBuffers; /**< The two buffers used if the wheel outgrew the inline buffers. */
+  bool onHeap = false; /**< Are the heap buffers used? */
+  std::size_t current = 0; /**< The index of the buffer that contains the wheel. */
+  std::size_t count = 0; /**< The number of sectors in the wheel (must form a sorted partition of [-pi,pi[). */
+};
@@ -97,7 +97,7 @@ void SetPlay::onRead()
   positionSubsetsPerNumOfAgents = Tactic::compilePriorityGroups(priorityGroups);
 }
 
-void SetPlay::compileVoronoiRegions(const std::array<Tactic, Tactic::numOfTypes>& tactics)
+std::vector<Tactic::Position> SetPlay::mergePositions(const std::array<Tactic, Tactic::numOfTypes>& tactics) const
 {
   std::vector<Tactic::Position> tacticPositions = tactics[tactic].positions;
   for(Tactic::Position& position : tacticPositions)
@@ -107,7 +107,7 @@ void SetPlay::compileVoronoiRegions(const std::array<Tactic, Tactic::numOfTypes>
         position.pose = positionOverride.pose;
         break;
       }
-  voronoiRegionSubsetsPerNumOfAgents = Tactic::generateVoronoiRegionSubsets(tacticPositions, positionSubsetsPerNumOfAgents);
+  return tacticPositions;
 }
 
 void SetPlay::verify([[maybe_unused]] Type setPlay, const std::array<Tactic, Tactic::numOfTypes>& tactics) const
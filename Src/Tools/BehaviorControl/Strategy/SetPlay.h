@@ -104,8 +104,12 @@ STREAMABLE(SetPlay,
   /** Compiles the priority groups. */
   void onRead();
 
-  /** Merges the positions of the tactic with the ones defined in this SetPlay and generates Voronoi region subsets */
-  void compileVoronoiRegions(const std::array<Tactic, Tactic::numOfTypes>& tactics);
+  /**
+   * Merges the positions of the tactic with the ones defined in this SetPlay.
+   * @param tactics The available tactics.
+   * @return The positions of the tactic with the poses overridden by this set play.
+   */
+  std::vector<Tactic::Position> mergePositions(const std::array<Tactic, Tactic::numOfTypes>& tactics) const;
 
   /**
    * Checks that the set play is valid.
@@ -52,7 +52,6 @@ Tactic::Position::Type Tactic::Position::mirrorIf(Type type, bool doIt)
 void Tactic::onRead()
 {
   positionSubsetsPerNumOfAgents = compilePriorityGroups(priorityGroups);
-  voronoiRegionSubsetsPerNumOfAgents = generateVoronoiRegionSubsets(positions, positionSubsetsPerNumOfAgents);
 }
 
 void Tactic::verify([[maybe_unused]] Type tactic) const
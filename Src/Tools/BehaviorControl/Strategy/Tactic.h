@@ -84,7 +84,10 @@ STREAMABLE(Tactic,
     (std::vector<unsigned int>) priorities, /**< The priorities in this priority group. */
   });
 
-  /** Compiles the priority groups and generates the Voronoi diagram. */
+  /**
+   * Compiles the priority groups. The Voronoi regions are filled in afterwards
+   * by VoronoiRegionTable::compile, because they may come from a cache file.
+   */
   void onRead();
 
   /**
@@ -123,7 +126,7 @@ STREAMABLE(Tactic,
   /**
    * A map from # of remaining field players - 1 (outermost vector) to a list (central vector) of sets (inner vector) of Voronoi regions which are legal for that specific # of remaining field players.
    * Voronoi regions for the positions are represented as points of a polygon.
-   * This member is precomputed using the priority group representation.
+   * This member is precomputed using the priority group representation (see VoronoiRegionTable).
    */
   std::vector<std::vector<std::vector<std::vector<Vector2f>>>> voronoiRegionSubsetsPerNumOfAgents,
 
@@ -0,0 +1,173 @@
+/**
+ * @file VoronoiRegionTable.cpp
+ *
+ * This file implements a class that fills in the Voronoi regions of all tactics
+ * and set plays, either from a cache file or by generating them.
+ */
+
+#include "VoronoiRegionTable.h"
+#include "Framework/Blackboard.h"
+#include "Platform/BHAssert.h"
+#include "Platform/File.h"
+#include "Platform/MemoryMappedFile.h"
+#include "Representations/Configuration/FieldDimensions.h"
+#include "Streaming/OutStreams.h"
+#include <MD5.h>
+#include <cstring>
+#include <filesystem>
+#include <functional>
+#include <string>
+#include <thread>
+
+void VoronoiRegionTable::compile(std::array<Tactic, Tactic::numOfTypes>& tactics, const std::vector<SetPlay*>& setPlays)
+{
+  std::vector<Entry> entries;
+  FOREACH_ENUM(Tactic::Type, tactic)
+    if(tactic != Tactic::none)
+      entries.push_back({tactics[tactic].positions, &tactics[tactic].positionSubsetsPerNumOfAgents, &tactics[tactic].voronoiRegionSubsetsPerNumOfAgents});
+  for(SetPlay* setPlay : setPlays)
+    if(setPlay)
+      entries.push_back({setPlay->mergePositions(tactics), &setPlay->positionSubsetsPerNumOfAgents, &setPlay->voronoiRegionSubsetsPerNumOfAgents});
+
+  const std::array<unsigned char, hashSize> inputHash = hash(entries);
+  if(load(entries, inputHash))
+    return;
+
+  for(Entry& entry : entries)
+    *entry.regions = Tactic::generateVoronoiRegionSubsets(entry.positions, *entry.positionSubsets);
+  save(entries, inputHash);
+}
+
+std::array<unsigned char, VoronoiRegionTable::hashSize> VoronoiRegionTable::hash(const std::vector<Entry>& entries)
+{
+  // The field size is the bounding box of the Voronoi diagrams.
+  ASSERT(Blackboard::getInstance().exists("FieldDimensions"));
+  const FieldDimensions& theFieldDimensions = static_cast<const FieldDimensions&>(Blackboard::getInstance()["FieldDimensions"]);
+
+  OutBinaryMemory stream(16384);
+  stream << version << theFieldDimensions.xPosOpponentGoalLine << theFieldDimensions.yPosLeftTouchline;
+  stream << static_cast<unsigned>(entries.size());
+  for(const Entry& entry : entries)
+  {
+    stream << static_cast<unsigned>(entry.positions.size());
+    for(const Tactic::Position& position : entry.positions)
+      stream << static_cast<unsigned>(position.type) << position.pose.translation.x() << position.pose.translation.y();
+    stream << static_cast<unsigned>(entry.positionSubsets->size());
+    for(const auto& subsets : *entry.positionSubsets)
+    {
+      stream << static_cast<unsigned>(subsets.size());
+      for(const auto& subset : subsets)
+      {
+        stream << static_cast<unsigned>(subset.size());
+        for(const Tactic::Position::Type type : subset)
+          stream << static_cast<unsigned>(type);
+      }
+    }
+  }
+
+  MD5 md5;
+  md5.digestMemory(reinterpret_cast<unsigned char*>(const_cast<char*>(stream.data())), static_cast<int>(stream.size()));
+  std::array<unsigned char, hashSize> result;
+  std::memcpy(result.data(), md5.digestRaw, hashSize);
+  return result;
+}
+
+bool VoronoiRegionTable::load(std::vector<Entry>& entries, const std::array<unsigned char, hashSize>& expectedHash)
+{
+  MemoryMappedFile file(fileName);
+  if(!file.exists())
+    return false;
+
+  const char* p = file.getData();
+  const char* const end = p + file.getSize();
+
+  // Reads a value from the mapped file. Returns false if the file is too short.
+  const auto read = [&p, end](auto& value)
+  {
+    if(end - p < static_cast<std::ptrdiff_t>(sizeof(value)))
+      return false;
+    std::memcpy(&value, p, sizeof(value));
+    p += sizeof(value);
+    return true;
+  };
+
+  unsigned fileMagic;
+  unsigned fileVersion;
+  std::array<unsigned char, hashSize> fileHash;
+  if(!read(fileMagic) || fileMagic != magic || !read(fileVersion) || fileVersion != version
+     || !read(fileHash) || fileHash != expectedHash)
+    return false;
+
+  // The hash guarantees that the structure matches the position subsets, but the file might still be truncated.
+  for(Entry& entry : entries)
+  {
+    Regions& regions = *entry.regions;
+    regions.resize(entry.positionSubsets->size());
+    for(std::size_t i = 0; i < regions.size(); ++i)
+    {
+      regions[i].resize((*entry.positionSubsets)[i].size());
+      for(std::vector<std::vector<Vector2f>>& subsetRegions : regions[i])
+      {
+        unsigned numOfRegions;
+        if(!read(numOfRegions))
+          return false;
+        subsetRegions.resize(numOfRegions);
+        for(std::vector<Vector2f>& region : subsetRegions)
+        {
+          unsigned numOfPoints;
+          if(!read(numOfPoints) || static_cast<std::size_t>(end - p) < numOfPoints * 2 * sizeof(float))
+            return false;
+          region.resize(numOfPoints);
+          for(Vector2f& point : region)
+          {
+            read(point.x());
+            read(point.y());
+          }
+        }
+      }
+    }
+  }
+  return p == end;
+}
+
+void VoronoiRegionTable::save(const std::vector<Entry>& entries, const std::array<unsigned char, hashSize>& hash)
+{
+  OutBinaryMemory stream(65536);
+  stream.write(&magic, sizeof(magic));
+  stream.write(&version, sizeof(version));
+  stream.write(hash.data(), hash.size());
+  for(const Entry& entry : entries)
+    for(const auto& subsets : *entry.regions)
+      for(const auto& subsetRegions : subsets)
+      {
+        const unsigned numOfRegions = static_cast<unsigned>(subsetRegions.size());
+        stream.write(&numOfRegions, sizeof(numOfRegions));
+        for(const std::vector<Vector2f>& region : subsetRegions)
+        {
+          const unsigned numOfPoints = static_cast<unsigned>(region.size());
+          stream.write(&numOfPoints, sizeof(numOfPoints));
+          for(const Vector2f& point : region)
+            stream.write(point.data(), 2 * sizeof(float));
+        }
+      }
+
+  // Other robots in the same process might have mapped the file at the moment. Truncating it would crash
+  // them, but replacing it keeps their mapping intact. Therefore, the file is written under a temporary name
+  // first, which is unique per thread, and then renamed. std::filesystem::rename is used, because in contrast to
+  // std::rename, it also replaces an existing file on Windows. Failing to write the cache is not an error. The
+  // regions will just be generated again next time.
+  const std::string suffix = "." + std::to_string(std::hash<std::thread::id>()(std::this_thread::get_id())) + ".tmp";
+  std::string tempName;
+  {
+    File file(fileName + suffix, "wb");
+    if(!file.exists())
+      return;
+    file.write(stream.data(), stream.size());
+    tempName = file.getFullName();
+  }
+  const std::string targetName = tempName.substr(0, tempName.size() - suffix.size());
+  std::error_code error;
+  std::filesystem::rename(tempName, targetName, error);
+  if(error)
+    std::filesystem::remove(tempName, error);
+}
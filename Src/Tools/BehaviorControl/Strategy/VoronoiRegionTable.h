@@ -0,0 +1,69 @@
+/**
+ * @file VoronoiRegionTable.h
+ *
+ * This file declares a class that fills in the Voronoi regions of all tactics
+ * and set plays. Since generating them for every position subset is expensive,
+ * the result is stored in a binary file next to the behavior configuration.
+ * The file is identified by a hash of everything the regions are computed from
+ * (field size, positions, position subsets), i.e. it is regenerated automatically
+ * whenever one of the tactics or set plays is changed. Otherwise, it is just
+ * memory mapped and copied into the tactics and set plays.
+ */
+
+#pragma once
+
+#include "SetPlay.h"
+#include "Tactic.h"
+#include <array>
+#include <string>
+#include <vector>
+
+class VoronoiRegionTable
+{
+public:
+  /**
+   * Fills in the Voronoi regions of all tactics and set plays.
+   * The position subsets must already be compiled (in onRead).
+   * @param tactics The tactics.
+   * @param setPlays The set plays (entries may be \c nullptr).
+   */
+  static void compile(std::array<Tactic, Tactic::numOfTypes>& tactics, const std::vector<SetPlay*>& setPlays);
+
+private:
+  using Regions = std::vector<std::vector<std::vector<std::vector<Vector2f>>>>; /**< The Voronoi regions per number of agents and subset. */
+
+  /** The inputs and the output of generating the Voronoi regions of a single tactic or set play. */
+  struct Entry
+  {
+    std::vector<Tactic::Position> positions; /**< The positions including their poses. */
+    const std::vector<std::vector<std::vector<Tactic::Position::Type>>>* positionSubsets; /**< The position subsets per number of agents. */
+    Regions* regions; /**< The Voronoi regions that are filled in. */
+  };
+
+  static constexpr const char* fileName = "Behavior/VoronoiRegions.bin"; /**< The name of the cache file. */
+  static constexpr unsigned magic = 0x52564842; /**< "BHVR" at the beginning of the cache file. */
+  static constexpr unsigned version = 1; /**< Must be increased if the format of the cache file is changed. */
+  static constexpr std::size_t hashSize = 16; /**< The size of an MD5 digest. */
+
+  /**
+   * Computes a hash over all inputs of the generation of Voronoi regions.
+   * @param entries The tactics and set plays.
+   * @return The MD5 digest.
+   */
+  static std::array<unsigned char, hashSize> hash(const std::vector<Entry>& entries);
+
+  /**
+   * Loads the Voronoi regions from the cache file.
+   * @param entries The tactics and set plays the regions of which are filled in.
+   * @param expectedHash The hash the cache file must contain.
+   * @return Were the regions loaded? Otherwise, the cache is either missing, outdated or damaged.
+   */
+  static bool load(std::vector<Entry>& entries, const std::array<unsigned char, hashSize>& expectedHash);
+
+  /**
+   * Writes the Voronoi regions to the cache file.
+   * @param entries The tactics and set plays the regions of which are written.
+   * @param hash The hash identifying the inputs of the regions.
+   */
+  static void save(const std::vector<Entry>& entries, const std::array<unsigned char, hashSize>& hash);
+};
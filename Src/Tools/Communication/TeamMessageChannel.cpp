@@ -10,6 +10,8 @@
 #include "TeamMessageChannel.h"
 #include "Platform/BHAssert.h"
 #include "Platform/SystemCall.h"
+#include <algorithm>
+#include <cstring>
 
 void TeamMessageChannel::startLocal(int port, unsigned localId)
 {
@@ -18,6 +20,7 @@ void TeamMessageChannel::startLocal(int port, unsigned localId)
   this->localId = localId;
 
   socket.setBlocking(false);
+  socket.reserveBatch(maxPacketsPerRead, sizeof(in.data) + 1);
   VERIFY(socket.setBroadcast(false));
   std::string group = SystemCall::getHostAddr();
   group = "239" + group.substr(group.find('.'));
@@ -35,6 +38,7 @@ void TeamMessageChannel::start(int port)
   this->port = port;
 
   socket.setBlocking(false);
+  socket.reserveBatch(maxPacketsPerRead, sizeof(in.data) + 1);
   VERIFY(socket.setBroadcast(true));
   VERIFY(socket.bind("0.0.0.0", port));
   socket.setLoopback(false);
@@ -54,17 +58,24 @@ bool TeamMessageChannel::receive()
   if(!port)
     return false; // not started yet
 
-  int size;
-  unsigned remoteIp = 0;
-
-  size = localId ? socket.readLocal(reinterpret_cast<char*>(in.data), sizeof(in.data) + 1)
-                 : socket.read(reinterpret_cast<char*>(in.data), sizeof(in.data) + 1, remoteIp);
-  if(size < 1 || static_cast<size_t>(size) > sizeof(in.data))
-    return false;
-  else
-    in.length = static_cast<uint8_t>(size);
+  while(true)
+  {
+    if(nextPacket == packetsRead)
+    {
+      nextPacket = 0;
+      packetsRead = std::max(0, socket.readBatch(localId != 0));
+      if(!packetsRead)
+        return false;
+    }
 
-  return true;
+    const UdpComm::Packet& packet = socket.getPacket(nextPacket++);
+    if(packet.size >= 1 && static_cast<size_t>(packet.size) <= sizeof(in.data))
+    {
+      std::memcpy(in.data, packet.data, packet.size);
+      in.length = static_cast<uint8_t>(packet.size);
+      return true;
+    }
+  }
 }
 
 void TeamMessageChannel::trySetWifiTarget()
@@ -49,7 +49,8 @@ public:
   void send();
 
   /**
-   * The method receives packets if available.
+   * The method receives packets if available. All pending packets are read
+   * at once and then returned one by one.
    * @return Whether there was a message
    */
   bool receive();
@@ -58,10 +59,14 @@ private:
   /** Sets the target of the socket to the WiFi broadcast address (if it exists). */
   void trySetWifiTarget();
 
+  static constexpr unsigned maxPacketsPerRead = 16; /**< The maximum number of packets read from the socket at once. */
+
   Container& in; /**< Incoming team message is stored here. */
   Container& out; /**< Outgoing team message is stored here. */
   int port = 0; /**< The UDP port this handler is listening to. */
   UdpComm socket; /**< The socket used to communicate. */
   unsigned localId = 0; /**< The id of a local team communication participant or 0 for normal udp communication. */
   bool targetSet = false; /**< Whether the target of the socket has been set. */
+  int packetsRead = 0; /**< The number of packets read from the socket by the last batch. */
+  int nextPacket = 0; /**< The index of the next packet of the last batch to return. */
 };
@@ -0,0 +1,45 @@
+/**
+ * @file InferenceWorker.cpp
+ *
+ * This file implements a class that executes expensive jobs in the background.
+ */
+
+#include "InferenceWorker.h"
+#include "Platform/BHAssert.h"
+#include <chrono>
+
+void InferenceWorker::submit(const std::function<void()>& job)
+{
+  ASSERT(!task);
+  task = taskPool->start([this, job]
+  {
+    // Waiting for the task orders the access to the duration.
+    const auto start = std::chrono::steady_clock::now();
+    job();
+    runningJobDuration = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+  });
+}
+
+void InferenceWorker::wait()
+{
+  if(!task)
+    return;
+
+  const auto start = std::chrono::steady_clock::now();
+  task->wait();
+  waitDuration = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+  jobDuration = runningJobDuration;
+  task.reset();
+}
+
+bool InferenceWorker::poll()
+{
+  if(task && task->isDone())
+  {
+    task->wait();
+    waitDuration = 0.f;
+    jobDuration = runningJobDuration;
+    task.reset();
+  }
+  return !task;
+}
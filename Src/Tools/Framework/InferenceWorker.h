@@ -0,0 +1,83 @@
+/**
+ * @file InferenceWorker.h
+ *
+ * This file declares a class that executes expensive jobs (mainly the
+ * inference of neural networks) in the background using the task pool, so
+ * that the thread of the module submitting them can continue with other
+ * work. The result is consumed in a later frame. The class measures how long
+ * the jobs took and how long the submitting thread still had to wait for
+ * them, i.e. how much time was removed from the critical path of the
+ * submitting thread.
+ */
+
+#pragma once
+
+#include "Framework/TaskPool.h"
+#include "Streaming/Enum.h"
+#include <functional>
+#include <memory>
+
+class InferenceWorker
+{
+public:
+  /** When is the result of a job consumed? */
+  ENUM(Mode,
+  {,
+    synchronous, /**< The job is executed by the submitting thread. No worker is used. */
+    nextFrame, /**< The job is executed in the background and its result is consumed in the next frame. */
+  });
+
+  /** Constructor. */
+  InferenceWorker() : taskPool(TaskPool::acquire()) {}
+
+  /**
+   * Submits a job. The worker must not be busy.
+   * The job must not use any debugging macros, because they are bound to the submitting thread.
+   * @param job The job.
+   */
+  void submit(const std::function<void()>& job);
+
+  /**
+   * Is a job submitted the result of which was not consumed yet?
+   * @return Was a job submitted, but not waited for?
+   */
+  bool isBusy() const {return task != nullptr;}
+
+  /**
+   * Waits until the job submitted has finished. Afterwards, its result can be used.
+   * Does nothing if the worker is not busy.
+   */
+  void wait();
+
+  /**
+   * Checks without blocking whether the job submitted has finished. If so,
+   * its result can be used as after wait().
+   * @return Is the worker not busy (anymore)?
+   */
+  bool poll();
+
+  /**
+   * Returns how long the last job consumed took.
+   * @return The duration in ms.
+   */
+  float getJobDuration() const {return jobDuration;}
+
+  /**
+   * Returns how long the submitting thread had to wait for the last job consumed.
+   * @return The duration in ms.
+   */
+  float getWaitDuration() const {return waitDuration;}
+
+  /**
+   * Returns how much time the last job consumed removed from the critical path of the submitting thread.
+   * @return The duration in ms.
+   */
+  float getSavedDuration() const {return jobDuration - waitDuration;}
+
+private:
+  std::shared_ptr<TaskPool> taskPool; /**< The pool that executes the jobs. */
+  float runningJobDuration = 0.f; /**< The duration of the current job, written when it has finished (in ms). */
+  float jobDuration = 0.f; /**< The duration of the last job consumed (in ms). */
+  float waitDuration = 0.f; /**< The time waited for the last job consumed (in ms). */
+  std::unique_ptr<TaskPool::Task> task; /**< The current job or \c nullptr. Destroyed first, which waits for it. */
+};
@@ -11,10 +11,35 @@
  */
 
 #include "BallPhysics.h"
+#include "ImageProcessing/SIMD.h"
 #include "Math/Eigen.h"
 #include "Platform/BHAssert.h"
+#include <algorithm>
 #include <limits>
 
+/**
+ * Selects the elements of a where the mask is set and those of b elsewhere.
+ * @param mask The result of an SSE comparison.
+ * @param a The elements selected where the mask is set.
+ * @param b The elements selected elsewhere.
+ * @return The combination.
+ */
+static ALWAYSINLINE __m128 select(__m128 mask, __m128 a, __m128 b)
+{
+  return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+}
+
+/**
+ * Computes the lengths of four vectors.
+ * @param x The x coordinates of the vectors.
+ * @param y The y coordinates of the vectors.
+ * @return The lengths.
+ */
+static ALWAYSINLINE __m128 norm(__m128 x, __m128 y)
+{
+  return _mm_sqrt_ps(_mm_add_ps(_mm_mul_ps(x, x), _mm_mul_ps(y, y)));
+}
+
 Vector2f BallPhysics::getEndPosition(const Vector2f& p, const Vector2f& v, float ballFriction)
 {
   ASSERT(ballFriction < 0.f);
@@ -119,3 +144,218 @@ float BallPhysics::computeTimeUntilBallStops(const Vector2f& v, float ballFricti
   const Vector2f velInMetersPerSecond = v / 1000.f;            // unit: meter / second
   return (velInMetersPerSecond.norm() * -1.f) / ballFriction;  // unit: seconds
 }
+
+float BallPhysics::computeInterceptionTime(const Vector2f& p, const Vector2f& v, float ballFriction,
+                                           const Vector2f& robot, float speed, Vector2f* position)
+{
+  ASSERT(ballFriction < 0.f);
+  ASSERT(speed > 0.f);
+  const float deceleration = -ballFriction * 1000.f;            // unit: millimeter / second^2
+  const float velocity = v.norm();                              // unit: millimeter / second
+  const float tStop = velocity / deceleration;                  // unit: seconds
+  const Vector2f end = p + v * (0.5f * tStop);                  // unit: millimeter
+  if(velocity > 0.f)
+  {
+    // Walk to the closest point of the trajectory and wait for the ball there.
+    const Vector2f direction = v / velocity;
+    const Vector2f offset = robot - p;
+    const float along = direction.dot(offset);                  // unit: millimeter
+    const float across = std::abs(direction.x() * offset.y() - direction.y() * offset.x()); // unit: millimeter
+    if(along >= 0.f && along <= 0.5f * velocity * tStop)
+    {
+      const float ballTime = (velocity - std::sqrt(std::max(0.f, velocity * velocity - 2.f * deceleration * along))) / deceleration;
+      if(across / speed <= ballTime)
+      {
+        if(position)
+          *position = p + direction * along;
+        return ballTime;
+      }
+    }
+  }
+
+  // Otherwise, go to where the ball stops.
+  if(position)
+    *position = end;
+  return std::max(tStop, (end - robot).norm() / speed);
+}
+
+void BallPhysics::propagateBallPositions(const Vectors& p, const Vectors& v, float t, float ballFriction, Vectors& result)
+{
+  ASSERT(ballFriction < 0.f);
+  ASSERT(p.size() == v.size());
+  result.resize(p.size());
+  const float deceleration = -ballFriction * 1000.f; // unit: millimeter / second^2
+  const __m128 halfDeceleration = _mm_set1_ps(0.5f * deceleration);
+  const __m128 invDeceleration = _mm_set1_ps(1.f / deceleration);
+  const __m128 time = _mm_set1_ps(t);
+  const __m128 zero = _mm_setzero_ps();
+
+  std::size_t i = 0;
+  for(; i + 4 <= p.size(); i += 4)
+  {
+    const __m128 vx = _mm_loadu_ps(v.x.data() + i);
+    const __m128 vy = _mm_loadu_ps(v.y.data() + i);
+    const __m128 velocity = norm(vx, vy);
+    const __m128 tClipped = _mm_min_ps(time, _mm_mul_ps(velocity, invDeceleration));
+
+    // p + v * t + a * 0.5 * t^2 with a = -v / |v| * deceleration, i.e. p + v * (t - 0.5 * deceleration * t^2 / |v|).
+    // Resting balls produce 0 / 0, which is masked out.
+    const __m128 factor = _mm_and_ps(_mm_cmpgt_ps(velocity, zero),
+                                     _mm_sub_ps(tClipped, _mm_div_ps(_mm_mul_ps(halfDeceleration, _mm_mul_ps(tClipped, tClipped)), velocity)));
+    _mm_storeu_ps(result.x.data() + i, _mm_add_ps(_mm_loadu_ps(p.x.data() + i), _mm_mul_ps(vx, factor)));
+    _mm_storeu_ps(result.y.data() + i, _mm_add_ps(_mm_loadu_ps(p.y.data() + i), _mm_mul_ps(vy, factor)));
+  }
+  for(; i < p.size(); ++i)
+    result.set(i, propagateBallPosition(p[i], v[i], t, ballFriction));
+}
+
+void BallPhysics::propagateBallPosition(const Vector2f& p, const Vector2f& v, const std::vector<float>& t, float ballFriction, Vectors& result)
+{
+  ASSERT(ballFriction < 0.f);
+  result.resize(t.size());
+  const float velocity = v.norm();
+  if(velocity == 0.f)
+  {
+    std::fill(result.x.begin(), result.x.end(), p.x());
+    std::fill(result.y.begin(), result.y.end(), p.y());
+    return;
+  }
+
+  const float deceleration = -ballFriction * 1000.f; // unit: millimeter / second^2
+  const __m128 scale = _mm_set1_ps(0.5f * deceleration / velocity);
+  const __m128 tStop = _mm_set1_ps(velocity / deceleration);
+  const __m128 px = _mm_set1_ps(p.x());
+  const __m128 py = _mm_set1_ps(p.y());
+  const __m128 vx = _mm_set1_ps(v.x());
+  const __m128 vy = _mm_set1_ps(v.y());
+
+  std::size_t i = 0;
+  for(; i + 4 <= t.size(); i += 4)
+  {
+    const __m128 tClipped = _mm_min_ps(_mm_loadu_ps(t.data() + i), tStop);
+    const __m128 factor = _mm_sub_ps(tClipped, _mm_mul_ps(scale, _mm_mul_ps(tClipped, tClipped)));
+    _mm_storeu_ps(result.x.data() + i, _mm_add_ps(px, _mm_mul_ps(vx, factor)));
+    _mm_storeu_ps(result.y.data() + i, _mm_add_ps(py, _mm_mul_ps(vy, factor)));
+  }
+  for(; i < t.size(); ++i)
+    result.set(i, propagateBallPosition(p, v, t[i], ballFriction));
+}
+
+void BallPhysics::getEndPositions(const Vectors& p, const Vectors& v, float ballFriction, Vectors& result)
+{
+  ASSERT(ballFriction < 0.f);
+  ASSERT(p.size() == v.size());
+  result.resize(p.size());
+
+  // The ball stops after |v| / deceleration seconds, i.e. at p + v * 0.5 * |v| / deceleration.
+  const __m128 scale = _mm_set1_ps(0.5f / (-ballFriction * 1000.f));
+
+  std::size_t i = 0;
+  for(; i + 4 <= p.size(); i += 4)
+  {
+    const __m128 vx = _mm_loadu_ps(v.x.data() + i);
+    const __m128 vy = _mm_loadu_ps(v.y.data() + i);
+    const __m128 factor = _mm_mul_ps(norm(vx, vy), scale);
+    _mm_storeu_ps(result.x.data() + i, _mm_add_ps(_mm_loadu_ps(p.x.data() + i), _mm_mul_ps(vx, factor)));
+    _mm_storeu_ps(result.y.data() + i, _mm_add_ps(_mm_loadu_ps(p.y.data() + i), _mm_mul_ps(vy, factor)));
+  }
+  for(; i < p.size(); ++i)
+    result.set(i, getEndPosition(p[i], v[i], ballFriction));
+}
+
+void BallPhysics::timesForDistances(const Vector2f& v, const std::vector<float>& distances, float ballFriction, std::vector<float>& result)
+{
+  ASSERT(ballFriction < 0.f);
+  result.resize(distances.size());
+  const float deceleration = -ballFriction * 1000.f; // unit: millimeter / second^2
+  const float velocity = v.norm();                   // unit: millimeter / second
+
+  // Solving s = |v| * t - 0.5 * deceleration * t^2 for t.
+  const __m128 velocity4 = _mm_set1_ps(velocity);
+  const __m128 sqrVelocity = _mm_set1_ps(velocity * velocity);
+  const __m128 twiceDeceleration = _mm_set1_ps(2.f * deceleration);
+  const __m128 invDeceleration = _mm_set1_ps(1.f / deceleration);
+  const __m128 maxDistance = _mm_set1_ps(0.5f * velocity * velocity / deceleration);
+  const __m128 never = _mm_set1_ps(std::numeric_limits<float>::max());
+  const __m128 zero = _mm_setzero_ps();
+
+  std::size_t i = 0;
+  for(; i + 4 <= distances.size(); i += 4)
+  {
+    const __m128 distance = _mm_loadu_ps(distances.data() + i);
+    const __m128 radicand = _mm_max_ps(zero, _mm_sub_ps(sqrVelocity, _mm_mul_ps(twiceDeceleration, distance)));
+    const __m128 time = _mm_mul_ps(_mm_sub_ps(velocity4, _mm_sqrt_ps(radicand)), invDeceleration);
+    _mm_storeu_ps(result.data() + i, select(_mm_cmpgt_ps(_mm_mul_ps(distance, distance), _mm_mul_ps(maxDistance, maxDistance)), never, time));
+  }
+  for(; i < distances.size(); ++i)
+    result[i] = timeForDistance(v, distances[i], ballFriction);
+}
+
+void BallPhysics::computeInterceptionTimes(const Vector2f& p, const Vector2f& v, float ballFriction,
+                                           const Vectors& robots, const std::vector<float>& speeds,
+                                           std::vector<float>& times, Vectors* positions)
+{
+  ASSERT(ballFriction < 0.f);
+  ASSERT(robots.size() == speeds.size());
+  times.resize(robots.size());
+  if(positions)
+    positions->resize(robots.size());
+
+  const float deceleration = -ballFriction * 1000.f;         // unit: millimeter / second^2
+  const float velocity = v.norm();                           // unit: millimeter / second
+  const float tStop = velocity / deceleration;               // unit: seconds
+  const Vector2f end = p + v * (0.5f * tStop);               // unit: millimeter
+  const Vector2f direction = velocity > 0.f ? Vector2f(v / velocity) : Vector2f::Zero();
+
+  const __m128 px = _mm_set1_ps(p.x());
+  const __m128 py = _mm_set1_ps(p.y());
+  const __m128 dx = _mm_set1_ps(direction.x());
+  const __m128 dy = _mm_set1_ps(direction.y());
+  const __m128 endX = _mm_set1_ps(end.x());
+  const __m128 endY = _mm_set1_ps(end.y());
+  const __m128 velocity4 = _mm_set1_ps(velocity);
+  const __m128 sqrVelocity = _mm_set1_ps(velocity * velocity);
+  const __m128 twiceDeceleration = _mm_set1_ps(2.f * deceleration);
+  const __m128 invDeceleration = _mm_set1_ps(1.f / deceleration);
+  const __m128 maxDistance = _mm_set1_ps(0.5f * velocity * tStop);
+  const __m128 tStop4 = _mm_set1_ps(tStop);
+  const __m128 absMask = _mm_castsi128_ps(_mm_set1_epi32(0x7fffffff));
+  const __m128 zero = _mm_setzero_ps();
+  // A resting ball has no trajectory to wait at.
+  const __m128 isRolling = velocity > 0.f ? _mm_castsi128_ps(_mm_set1_epi32(-1)) : zero;
+
+  std::size_t i = 0;
+  for(; i + 4 <= robots.size(); i += 4)
+  {
+    const __m128 rx = _mm_loadu_ps(robots.x.data() + i);
+    const __m128 ry = _mm_loadu_ps(robots.y.data() + i);
+    const __m128 invSpeed = _mm_div_ps(_mm_set1_ps(1.f), _mm_loadu_ps(speeds.data() + i));
+
+    // Closest point of the trajectory
+    const __m128 ox = _mm_sub_ps(rx, px);
+    const __m128 oy = _mm_sub_ps(ry, py);
+    const __m128 along = _mm_add_ps(_mm_mul_ps(dx, ox), _mm_mul_ps(dy, oy));
+    const __m128 across = _mm_and_ps(absMask, _mm_sub_ps(_mm_mul_ps(dx, oy), _mm_mul_ps(dy, ox)));
+    const __m128 radicand = _mm_max_ps(zero, _mm_sub_ps(sqrVelocity, _mm_mul_ps(twiceDeceleration, along)));
+    const __m128 ballTime = _mm_mul_ps(_mm_sub_ps(velocity4, _mm_sqrt_ps(radicand)), invDeceleration);
+    const __m128 waits = _mm_and_ps(_mm_and_ps(isRolling, _mm_cmpge_ps(along, zero)),
+                                    _mm_and_ps(_mm_cmple_ps(along, maxDistance), _mm_cmple_ps(_mm_mul_ps(across, invSpeed), ballTime)));
+
+    // End position
+    const __m128 endTime = _mm_max_ps(tStop4, _mm_mul_ps(norm(_mm_sub_ps(endX, rx), _mm_sub_ps(endY, ry)), invSpeed));
+
+    _mm_storeu_ps(times.data() + i, select(waits, ballTime, endTime));
+    if(positions)
+    {
+      _mm_storeu_ps(positions->x.data() + i, select(waits, _mm_add_ps(px, _mm_mul_ps(dx, along)), endX));
+      _mm_storeu_ps(positions->y.data() + i, select(waits, _mm_add_ps(py, _mm_mul_ps(dy, along)), endY));
+    }
+  }
+  for(; i < robots.size(); ++i)
+  {
+    Vector2f position;
+    times[i] = computeInterceptionTime(p, v, ballFriction, robots[i], speeds[i], &position);
+    if(positions)
+      positions->set(i, position);
+  }
+}
@@ -13,6 +13,7 @@
 #pragma once
 
 #include "Math/Eigen.h"
+#include <vector>
 
 /**
  * @class BallPhysics
@@ -21,6 +22,23 @@
  */
 struct BallPhysics
 {
+  /**
+   * Many positions or velocities in a structure-of-arrays layout. The batch
+   * functions below process four of them at once with SIMD instructions.
+   */
+  struct Vectors
+  {
+    std::vector<float> x; /**< The x coordinates. */
+    std::vector<float> y; /**< The y coordinates. */
+
+    std::size_t size() const {return x.size();}
+    void resize(std::size_t size) {x.resize(size); y.resize(size);}
+    void clear() {x.clear(); y.clear();}
+    void push_back(const Vector2f& v) {x.push_back(v.x()); y.push_back(v.y());}
+    Vector2f operator[](std::size_t i) const {return Vector2f(x[i], y[i]);}
+    void set(std::size_t i, const Vector2f& v) {x[i] = v.x(); y[i] = v.y();}
+  };
+
   /**
    * Computes the position where a rolling ball is expected to stop rolling.
    * @param p The ball position (in mm)
@@ -105,4 +123,75 @@ struct BallPhysics
    * @return The remaining rolling time (seconds)
    */
   static float computeTimeUntilBallStops(const Vector2f& v, float ballFriction);
+
+  /**
+   * Computes the time a robot needs to intercept a rolling ball and where this
+   * happens. The robot either walks straight to the point of the ball trajectory
+   * closest to it and waits there if it arrives before the ball, or it walks
+   * to the position where the ball stops. The earlier option is chosen. The
+   * result is a time the robot can actually achieve, but the true earliest
+   * interception (cutting the trajectory diagonally) can be slightly earlier.
+   * @param p The ball position (in mm)
+   * @param v The ball velocity (in mm/s)
+   * @param ballFriction The ball friction (negative force) (in m/s^2)
+   * @param robot The position of the robot (in mm)
+   * @param speed The walking speed of the robot (in mm/s, must be positive)
+   * @param position If not \c nullptr, the interception position is returned here (in mm)
+   * @return The interception time (in seconds)
+   */
+  static float computeInterceptionTime(const Vector2f& p, const Vector2f& v, float ballFriction,
+                                       const Vector2f& robot, float speed, Vector2f* position = nullptr);
+
+  /**
+   * Batch version of propagateBallPosition for many ball hypotheses.
+   * @param p The ball positions (in mm)
+   * @param v The ball velocities (in mm/s), as many as positions
+   * @param t Time in seconds
+   * @param ballFriction The ball friction (negative force) (in m/s^2)
+   * @param result The new positions (in mm)
+   */
+  static void propagateBallPositions(const Vectors& p, const Vectors& v, float t, float ballFriction, Vectors& result);
+
+  /**
+   * Batch version of propagateBallPosition for many points in time of a single ball.
+   * @param p The ball position (in mm)
+   * @param v The ball velocity (in mm/s)
+   * @param t The times in seconds
+   * @param ballFriction The ball friction (negative force) (in m/s^2)
+   * @param result The positions at these times (in mm)
+   */
+  static void propagateBallPosition(const Vector2f& p, const Vector2f& v, const std::vector<float>& t, float ballFriction, Vectors& result);
+
+  /**
+   * Batch version of getEndPosition for many ball hypotheses.
+   * @param p The ball positions (in mm)
+   * @param v The ball velocities (in mm/s), as many as positions
+   * @param ballFriction The ball friction (negative force) (in m/s^2)
+   * @param result The positions where the balls stop (in mm)
+   */
+  static void getEndPositions(const Vectors& p, const Vectors& v, float ballFriction, Vectors& result);
+
+  /**
+   * Batch version of timeForDistance for many distances of a single ball.
+   * @param v The ball velocity (in mm/s)
+   * @param distances The distances (in mm)
+   * @param ballFriction The ball friction (negative force) (in m/s^2)
+   * @param result The times in seconds, std::numeric_limits<float>::max() for distances the ball won't make
+   */
+  static void timesForDistances(const Vector2f& v, const std::vector<float>& distances, float ballFriction, std::vector<float>& result);
+
+  /**
+   * Batch version of computeInterceptionTime for many robots, e.g. all
+   * teammates and opponents.
+   * @param p The ball position (in mm)
+   * @param v The ball velocity (in mm/s)
+   * @param ballFriction The ball friction (negative force) (in m/s^2)
+   * @param robots The positions of the robots (in mm)
+   * @param speeds The walking speeds of the robots (in mm/s, must be positive), as many as robots
+   * @param times The interception times (in seconds)
+   * @param positions If not \c nullptr, the interception positions are returned here (in mm)
+   */
+  static void computeInterceptionTimes(const Vector2f& p, const Vector2f& v, float ballFriction,
+                                       const Vectors& robots, const std::vector<float>& speeds,
+                                       std::vector<float>& times, Vectors* positions = nullptr);
 };
@@ -57,6 +57,37 @@ public:
    */
   const T& at(int index) const {ASSERT(index < num); return current[index];}
 
+  /**
+   * The function initializes all samples as two groups, e.g. poses on two sides
+   * of the field. If only the first samples are in use, these and the remaining
+   * ones are each split into halves. Therefore, both groups are represented no
+   * matter how many samples are in use. They also survive thinOut.
+   * @param numberOfActiveSamples The number of samples currently in use.
+   * @param init A function (T& sample, bool firstGroup) that initializes a sample.
+   */
+  template<typename Init> void initInTwoGroups(int numberOfActiveSamples, Init init)
+  {
+    ASSERT(numberOfActiveSamples > 0 && numberOfActiveSamples <= num);
+    const int startOfSecondGroup = numberOfActiveSamples / 2;
+    const int startOfSecondInactiveGroup = numberOfActiveSamples + (num - numberOfActiveSamples) / 2;
+    for(int i = 0; i < num; ++i)
+      init(current[i], i < startOfSecondGroup || (i >= numberOfActiveSamples && i < startOfSecondInactiveGroup));
+  }
+
+  /**
+   * The function reduces the number of samples in use by keeping evenly spaced
+   * samples at the beginning of the set. As the source index is never smaller
+   * than the target index, this works in place.
+   * @param numberOfActiveSamples The number of samples currently in use.
+   * @param targetNumberOfSamples The number of samples in use afterwards.
+   */
+  void thinOut(int numberOfActiveSamples, int targetNumberOfSamples)
+  {
+    ASSERT(targetNumberOfSamples > 0 && targetNumberOfSamples <= numberOfActiveSamples && numberOfActiveSamples <= num);
+    for(int i = 0; i < targetNumberOfSamples; ++i)
+      current[i] = current[i * numberOfActiveSamples / targetNumberOfSamples];
+  }
+
   /**
    * The function swaps the primary and secondary sample set.
    * @return The address of the previous sample set;
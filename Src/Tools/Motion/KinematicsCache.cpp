@@ -0,0 +1,103 @@
+/**
+ * @file KinematicsCache.cpp
+ *
+ * This file implements a cache for the robot models that the modules of a
+ * thread compute during a frame.
+ */
+
+#include "KinematicsCache.h"
+#include <cstring>
+
+KinematicsCache& KinematicsCache::current()
+{
+  static thread_local KinematicsCache cache;
+  return cache;
+}
+
+void KinematicsCache::beginFrame()
+{
+  KinematicsCache& cache = current();
+  cache.active = true;
+  cache.entries.clear();
+}
+
+void KinematicsCache::disable()
+{
+  KinematicsCache& cache = current();
+  cache.active = false;
+  cache.entries.clear();
+}
+
+KinematicsCache::Statistics KinematicsCache::takeStatistics()
+{
+  KinematicsCache& cache = current();
+  const Statistics statistics = cache.statistics;
+  cache.statistics = Statistics();
+  return statistics;
+}
+
+std::size_t KinematicsCache::hash(const JointAngles& jointAngles)
+{
+  // FNV-1a over the bit patterns of all angles and variances.
+  std::size_t hash = 14695981039346656037ull;
+  for(const auto* array : {&jointAngles.angles, &jointAngles.variance})
+    for(const float value : *array)
+    {
+      unsigned bits;
+      std::memcpy(&bits, &value, sizeof(bits));
+      hash = (hash ^ bits) * 1099511628211ull;
+    }
+  return hash;
+}
+
+void KinematicsCache::getRobotModel(const JointAngles& jointAngles, const RobotDimensions& robotDimensions,
+                                    const MassCalibration& massCalibration, RobotModel& robotModel)
+{
+  KinematicsCache& cache = current();
+  if(!cache.active)
+  {
+    robotModel.calculate(jointAngles, robotDimensions, massCalibration);
+    return;
+  }
+
+  const std::size_t hash = KinematicsCache::hash(jointAngles);
+  const Entry* base = nullptr;
+  for(auto entry = cache.entries.begin(); entry != cache.entries.end(); ++entry)
+    if(entry->robotDimensions == &robotDimensions && entry->massCalibration == &massCalibration)
+    {
+      if(entry->hash == hash && entry->jointAngles.angles == jointAngles.angles
+         && entry->jointAngles.variance == jointAngles.variance)
+      {
+        robotModel = entry->robotModel;
+        cache.entries.splice(cache.entries.begin(), cache.entries, entry);
+        ++cache.statistics.hits;
+        return;
+      }
+      else if(!base)
+        base = &*entry;
+    }
+
+  if(base)
+  {
+    robotModel = base->robotModel;
+    robotModel.calculate(jointAngles, robotDimensions, massCalibration, &base->jointAngles);
+    ++cache.statistics.partialHits;
+  }
+  else
+  {
+    robotModel.calculate(jointAngles, robotDimensions, massCalibration);
+    ++cache.statistics.misses;
+  }
+
+  // Reuse the least recently used entry if the cache is full.
+  if(cache.entries.size() < capacity)
+    cache.entries.emplace_front();
+  else
+    cache.entries.splice(cache.entries.begin(), cache.entries, std::prev(cache.entries.end()));
+  Entry& entry = cache.entries.front();
+  entry.hash = hash;
+  entry.jointAngles = jointAngles;
+  entry.robotDimensions = &robotDimensions;
+  entry.massCalibration = &massCalibration;
+  entry.robotModel = robotModel;
+}
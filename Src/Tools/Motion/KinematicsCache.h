@@ -0,0 +1,92 @@
+/**
+ * @file KinematicsCache.h
+ *
+ * This file declares a cache for the robot models that the modules of a
+ * thread compute during a frame. Several Motion modules calculate the forward
+ * kinematics and the center of mass for the same measured, requested, or
+ * predicted joint angles. Each joint data set is hashed and looked up. If it
+ * was not computed before, the most recent model is copied and only the
+ * chains are recalculated whose joints differ.
+ *
+ * The cache is only active in threads that call \c beginFrame at the
+ * beginning of each frame (the Motion thread), because the dimensions and the
+ * mass calibration are only identified by their addresses, i.e. they must not
+ * change within a frame. Elsewhere, all models are calculated from scratch.
+ */
+
+#pragma once
+
+#include "Representations/Infrastructure/JointAngles.h"
+#include "Representations/Sensing/RobotModel.h"
+#include <cstddef>
+#include <list>
+
+class KinematicsCache
+{
+public:
+  static constexpr std::size_t capacity = 16; /**< The maximum number of models cached. */
+
+  /** Statistics of the lookups of the current thread since the last reset. */
+  struct Statistics
+  {
+    unsigned hits = 0; /**< The number of models copied from the cache. */
+    unsigned partialHits = 0; /**< The number of models derived from a cached one by recalculating some chains. */
+    unsigned misses = 0; /**< The number of models calculated from scratch. */
+  };
+
+  /**
+   * Activates the cache for the calling thread and removes all models of the
+   * previous frame.
+   */
+  static void beginFrame();
+
+  /**
+   * Deactivates the cache for the calling thread.
+   */
+  static void disable();
+
+  /**
+   * Determines the robot model for joint data, either from the cache or by
+   * calculating it.
+   * @param jointAngles The joint data.
+   * @param robotDimensions The dimensions of the robot.
+   * @param massCalibration The mass calibration of the robot.
+   * @param robotModel The model that is set.
+   */
+  static void getRobotModel(const JointAngles& jointAngles, const RobotDimensions& robotDimensions,
+                            const MassCalibration& massCalibration, RobotModel& robotModel);
+
+  /**
+   * Returns the statistics of the calling thread and resets them.
+   * @return The statistics since the last call.
+   */
+  static Statistics takeStatistics();
+
+private:
+  /** A robot model and what it was calculated from. */
+  struct Entry
+  {
+    std::size_t hash; /**< The hash of the joint data. */
+    JointAngles jointAngles; /**< The joint data. */
+    const RobotDimensions* robotDimensions; /**< The dimensions of the robot. */
+    const MassCalibration* massCalibration; /**< The mass calibration of the robot. */
+    RobotModel robotModel; /**< The model calculated. */
+  };
+
+  bool active = false; /**< Was \c beginFrame called in this thread? */
+  std::list<Entry> entries; /**< The models cached, the most recently used one first. */
+  Statistics statistics; /**< The statistics of the lookups. */
+
+  /**
+   * Returns the cache of the calling thread.
+   * @return The cache.
+   */
+  static KinematicsCache& current();
+
+  /**
+   * Hashes the angles and variances of joint data.
+   * @param jointAngles The joint data.
+   * @return The hash.
+   */
+  static std::size_t hash(const JointAngles& jointAngles);
+};
@@ -0,0 +1,37 @@
+/**
+ * @file DetectionScheduler.cpp
+ *
+ * This file implements a class that decides in which frames an expensive
+ * full-frame detector actually has to run.
+ */
+
+#include "DetectionScheduler.h"
+#include "Tools/Math/Transformation.h"
+
+bool DetectionScheduler::predict(const Vector2f& pointInImage, const CameraInfo& cameraInfo, const CameraMatrix& cameraMatrix,
+                                 const ImageCoordinateSystem& imageCoordinateSystem, const Pose2f& odometry,
+                                 Vector2f& predictedInImage, float* distanceRatio) const
+{
+  Vector2f pointOnField;
+  if(!Transformation::imageToRobot(lastImageCoordinateSystem.toCorrected(pointInImage), lastCameraMatrix, cameraInfo, pointOnField))
+    return false;
+
+  const Vector2f predictedOnField = predict(pointOnField, odometry);
+  if(!Transformation::robotToImage(predictedOnField, cameraMatrix, cameraInfo, predictedInImage))
+    return false;
+  predictedInImage = imageCoordinateSystem.fromCorrected(predictedInImage);
+
+  if(distanceRatio)
+    *distanceRatio = pointOnField.norm() / std::max(predictedOnField.norm(), 1.f);
+  return true;
+}
+
+bool DetectionScheduler::moved(const Parameters& parameters, const CameraMatrix& cameraMatrix, const Pose2f& odometry) const
+{
+  const Pose2f offset = odometry.inverse() * lastOdometry;
+  if(offset.translation.squaredNorm() > sqr(parameters.maxTranslation) || std::abs(offset.rotation) > parameters.maxRotation)
+    return true;
+
+  const Eigen::AngleAxisf cameraRotation(Matrix3f(lastCameraMatrix.rotation.transpose() * cameraMatrix.rotation));
+  return std::abs(cameraRotation.angle()) > parameters.maxCameraRotation;
+}
@@ -0,0 +1,185 @@
+/**
+ * @file DetectionScheduler.h
+ *
+ * This file declares a class that decides in which frames an expensive
+ * full-frame detector (usually a neural network) actually has to run.
+ * In between, the module predicts its previous detections into the current
+ * image. The detector runs again if a number of frames was skipped, if the
+ * robot or its camera moved too much since the last detection, or if the
+ * image changed. The latter is checked with a coarse grid of mean
+ * brightnesses, which is cheap compared to running the network.
+ */
+
+#pragma once
+
+#include "Representations/Infrastructure/CameraInfo.h"
+#include "Representations/Perception/ImagePreprocessing/CameraMatrix.h"
+#include "Representations/Perception/ImagePreprocessing/ImageCoordinateSystem.h"
+#include "ImageProcessing/Image.h"
+#include "ImageProcessing/PixelTypes.h"
+#include "Math/Angle.h"
+#include "Math/Eigen.h"
+#include "Math/Pose2f.h"
+#include "Streaming/AutoStreamable.h"
+#include <array>
+
+class DetectionScheduler
+{
+public:
+  STREAMABLE(Parameters,
+  {,
+    (unsigned)(0) maxSkippedFrames, /**< How many frames in a row the detector may be skipped (0: run in every frame). */
+    (float)(30.f) maxTranslation, /**< The detector runs if the robot walked further since the last detection (in mm). */
+    (Angle)(3_deg) maxRotation, /**< The detector runs if the robot turned more since the last detection. */
+    (Angle)(2_deg) maxCameraRotation, /**< The detector runs if the camera rotated more relative to the robot (head motion, torso sway). */
+    (float)(12.f) maxBrightnessChange, /**< The detector runs if a cell of the brightness grid changed more (0..255). */
+  });
+
+  /**
+   * Decides whether the detector must run in the current frame. If not, the
+   * frame is counted as skipped. Call this once per frame.
+   * @param parameters The parameters of the module.
+   * @param cameraMatrix The camera matrix of the current image.
+   * @param odometry The odometry when the current image was taken.
+   * @param image The current image.
+   * @return Must the detector run in this frame?
+   */
+  template<typename Pixel>
+  bool shouldDetect(const Parameters& parameters, const CameraMatrix& cameraMatrix, const Pose2f& odometry, const Image<Pixel>& image);
+
+  /**
+   * Records that the detector ran on the current image. Its detections are
+   * predicted from this image until the detector runs again.
+   * @param cameraMatrix The camera matrix of the current image.
+   * @param imageCoordinateSystem The image coordinate system of the current image.
+   * @param odometry The odometry when the current image was taken.
+   * @param image The current image.
+   */
+  template<typename Pixel>
+  void detected(const CameraMatrix& cameraMatrix, const ImageCoordinateSystem& imageCoordinateSystem, const Pose2f& odometry, const Image<Pixel>& image);
+
+  /**
+   * Predicts where a point on the ground in the image of the last detection
+   * appears in the current image.
+   * @param pointInImage The point in the image of the last detection.
+   * @param cameraInfo The camera info (the same for both images).
+   * @param cameraMatrix The camera matrix of the current image.
+   * @param imageCoordinateSystem The image coordinate system of the current image.
+   * @param odometry The odometry when the current image was taken.
+   * @param predictedInImage The point in the current image.
+   * @param distanceRatio If not \c nullptr, the ratio between the distance of
+   *                      the point when it was detected and now is returned.
+   * @return Could the point be predicted? Otherwise, it is above the horizon in either image.
+   */
+  bool predict(const Vector2f& pointInImage, const CameraInfo& cameraInfo, const CameraMatrix& cameraMatrix,
+               const ImageCoordinateSystem& imageCoordinateSystem, const Pose2f& odometry,
+               Vector2f& predictedInImage, float* distanceRatio = nullptr) const;
+
+  /**
+   * Predicts a point on the field relative to the robot at the last detection into the current robot pose.
+   * @param pointOnField The point relative to the robot when the last detection happened.
+   * @param odometry The odometry when the current image was taken.
+   * @return The point relative to the robot now.
+   */
+  Vector2f predict(const Vector2f& pointOnField, const Pose2f& odometry) const
+  {
+    return (odometry.inverse() * lastOdometry) * pointOnField;
+  }
+
+  /** Returns the number of frames skipped since the last detection. */
+  unsigned getSkippedFrames() const {return skippedFrames;}
+
+  /** Returns the camera matrix of the image of the last detection. */
+  const CameraMatrix& getCameraMatrix() const {return lastCameraMatrix;}
+
+  /** Returns the image coordinate system of the image of the last detection. */
+  const ImageCoordinateSystem& getImageCoordinateSystem() const {return lastImageCoordinateSystem;}
+
+private:
+  static constexpr int gridWidth = 8; /**< The number of cells of the brightness grid in x direction. */
+  static constexpr int gridHeight = 6; /**< The number of cells of the brightness grid in y direction. */
+  static constexpr int sampleStep = 4; /**< Only every n-th pixel in every n-th row is sampled. */
+
+  using Grid = std::array<float, gridWidth * gridHeight>; /**< The mean brightnesses of the image cells. */
+
+  static unsigned char getBrightness(PixelTypes::GrayscaledPixel pixel) {return pixel;}
+  static unsigned char getBrightness(const PixelTypes::YUYVPixel& pixel) {return pixel.y0;}
+
+  /**
+   * Computes the mean brightnesses of a coarse grid of image cells.
+   * @param image The image.
+   * @param grid The grid that is filled.
+   */
+  template<typename Pixel>
+  static void computeGrid(const Image<Pixel>& image, Grid& grid);
+
+  /**
+   * Checks whether the robot or its camera moved too much since the last detection.
+   * @param parameters The parameters of the module.
+   * @param cameraMatrix The camera matrix of the current image.
+   * @param odometry The odometry when the current image was taken.
+   * @return Did it move too much?
+   */
+  bool moved(const Parameters& parameters, const CameraMatrix& cameraMatrix, const Pose2f& odometry) const;
+
+  bool hasDetected = false; /**< Did the detector run at least once? */
+  unsigned skippedFrames = 0; /**< The number of frames skipped since the last detection. */
+  CameraMatrix lastCameraMatrix; /**< The camera matrix of the image of the last detection. */
+  ImageCoordinateSystem lastImageCoordinateSystem; /**< The image coordinate system of the image of the last detection. */
+  Pose2f lastOdometry; /**< The odometry when the image of the last detection was taken. */
+  Grid lastGrid; /**< The brightness grid of the image of the last detection. */
+};
+
+template<typename Pixel>
+bool DetectionScheduler::shouldDetect(const Parameters& parameters, const CameraMatrix& cameraMatrix, const Pose2f& odometry, const Image<Pixel>& image)
+{
+  if(!hasDetected || skippedFrames >= parameters.maxSkippedFrames || !cameraMatrix.isValid
+     || moved(parameters, cameraMatrix, odometry))
+    return true;
+
+  Grid grid;
+  computeGrid(image, grid);
+  for(std::size_t i = 0; i < grid.size(); ++i)
+    if(std::abs(grid[i] - lastGrid[i]) > parameters.maxBrightnessChange)
+      return true;
+
+  ++skippedFrames;
+  return false;
+}
+
+template<typename Pixel>
+void DetectionScheduler::detected(const CameraMatrix& cameraMatrix, const ImageCoordinateSystem& imageCoordinateSystem, const Pose2f& odometry, const Image<Pixel>& image)
+{
+  hasDetected = true;
+  skippedFrames = 0;
+  lastCameraMatrix = cameraMatrix;
+  lastImageCoordinateSystem = imageCoordinateSystem;
+  lastOdometry = odometry;
+  computeGrid(image, lastGrid);
+}
+
+template<typename Pixel>
+void DetectionScheduler::computeGrid(const Image<Pixel>& image, Grid& grid)
+{
+  grid.fill(0.f);
+  if(image.width < static_cast<unsigned>(gridWidth) || image.height < static_cast<unsigned>(gridHeight))
+    return;
+
+  std::array<unsigned, gridWidth * gridHeight> sums;
+  std::array<unsigned, gridWidth * gridHeight> counts;
+  sums.fill(0);
+  counts.fill(0);
+  for(unsigned y = 0; y < image.height; y += sampleStep)
+  {
+    const int row = static_cast<int>(y * gridHeight / image.height) * gridWidth;
+    const Pixel* pixel = image[y];
+    for(unsigned x = 0; x < image.width; x += sampleStep)
+    {
+      const int cell = row + static_cast<int>(x * gridWidth / image.width);
+      sums[cell] += getBrightness(pixel[x]);
+      ++counts[cell];
+    }
+  }
+  for(std::size_t i = 0; i < grid.size(); ++i)
+    grid[i] = counts[i] ? static_cast<float>(sums[i]) / static_cast<float>(counts[i]) : 0.f;
+}